@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "board_implementation.h"
+#include "board_solver.h"
+
+#define MAX_MOVES 2000
+#define BOMB_PERCENT 16
+
+static double microseconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, std::vector<double>& times) {
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (double time: times) total += time;
+    std::cout << "\t" << name
+              << "\tmean " << total / times.size() << " us"
+              << "\tp50 " << times[times.size() / 2] << " us"
+              << "\tmax " << times.back() << " us\n";
+}
+
+/**
+ * Measures the cost of a move, the dig and the solver catching up with it, playing
+ * large boards with hints only, starting from a tile without neighboring bombs.
+ * The same game is followed by a solver fed every dig and by one re-reading the
+ * whole board after every move.
+ */
+static void bench(int size) {
+    BoardImplementation board{size, size, size * size * BOMB_PERCENT / 100, 7};
+    std::unordered_map<std::string, std::unique_ptr<char []>> debug = board.print_debug();
+    int y = 0;
+    int x = 0;
+    for (int tile = 0; tile < size * size; tile++) {
+        int position = tile / size * (size + 1) + tile % size;
+        if (debug["back"][position] == 'E' && debug["boundaries"][position] == '0') {
+            y = tile / size;
+            x = tile % size;
+            break;
+        }
+    }
+
+    BoardSolver fed{&board};
+    BoardSolver rescanning{&board};
+    std::vector<double> fed_times;
+    std::vector<double> rescanning_times;
+    bool found = true;
+    while (found && fed_times.size() < MAX_MOVES) {
+        auto start = std::chrono::steady_clock::now();
+        board.dig(y, x);
+        fed.dug(&board, y, x);
+        found = fed.hint(y, x);
+        fed_times.push_back(microseconds_since(start));
+
+        // the move is already made, only the solver's share is timed
+        start = std::chrono::steady_clock::now();
+        rescanning.update(&board);
+        int hint_y;
+        int hint_x;
+        rescanning.hint(hint_y, hint_x);
+        rescanning_times.push_back(microseconds_since(start));
+    }
+
+    std::cout << size << "x" << size << "\tmoves " << fed_times.size() << "\n";
+    report("dig fed to the solver  ", fed_times);
+    report("solver re-reading board", rescanning_times);
+}
+
+int main() {
+    for (int size: {100, 500, 1000, 2000}) bench(size);
+    return 0;
+}
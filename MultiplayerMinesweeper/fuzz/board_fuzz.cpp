@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "board_implementation.h"
+#include "board_invariants.h"
+
+#define HEADER_LEN 11
+#define OPERATION_LEN 3
+#define MAX_SIDE 32
+
+/**
+ * Plays one sequence of board operations and aborts if it breaks an invariant.
+ * The input is read as
+ *      rows, columns, bombs, 8 bytes of seed
+ * followed by operations of 3 bytes
+ *      operation, y, x
+ * where the operation is a dig, flag, deflag or print. Coordinates may fall
+ * outside the board so out of bound operations are played too.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size < HEADER_LEN) return 0;
+
+    int y_size = 1 + data[0] % MAX_SIDE;
+    int x_size = 1 + data[1] % MAX_SIDE;
+    int bomb_count = data[2] % (y_size * x_size + 1);
+    uint64_t seed = 0;
+    for (int i = 0; i < 8; i++) seed = seed << 8 | data[3 + i];
+
+    BoardImplementation board{y_size, x_size, bomb_count, seed};
+    std::vector<char> buffer(board.print_length());
+    for (size_t i = HEADER_LEN; i + OPERATION_LEN <= size; i += OPERATION_LEN) {
+        int y = (int8_t) data[i + 1];
+        int x = (int8_t) data[i + 2];
+        switch (data[i] % 4) {
+            case 0: board.dig(y, x); break;
+            case 1: board.flag(y, x); break;
+            case 2: board.deflag(y, x); break;
+            default: board.print(buffer.data(), buffer.size()); break;
+        }
+    }
+
+    std::string broken = check_board_invariants(board);
+    if (!broken.empty()) {
+        fprintf(stderr, "broken invariant: %s\n", broken.c_str());
+        abort();
+    }
+    return 0;
+}
+
+#ifndef MINESWEEPER_LIBFUZZER
+/**
+ * Replays inputs when the compiler has no libFuzzer, one per file argument
+ * or a single input from stdin without arguments.
+ */
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        std::string input{std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()};
+        return LLVMFuzzerTestOneInput((const uint8_t *) input.data(), input.size());
+    }
+    for (int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::cerr << "cannot open " << argv[i] << std::endl;
+            return 1;
+        }
+        std::string input{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        LLVMFuzzerTestOneInput((const uint8_t *) input.data(), input.size());
+    }
+    return 0;
+}
+#endif
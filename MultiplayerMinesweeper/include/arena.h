@@ -0,0 +1,129 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * A mutable bump allocator that hands out memory from a list of blocks.
+ * Memory is never freed individually, reset() releases every allocation at once
+ * while keeping the blocks, so a warmed up arena performs no heap allocation.
+ */
+class Arena {
+    /**
+     * Abstraction function:
+     *      - represents a region of memory where the first offset bytes of
+     *        blocks[current] and every byte of blocks[0..current) are in use
+     *
+     * Representation invariant:
+     *      - 0 <= current < blocks.size()
+     *      - 0 <= offset <= blocks[current].size
+     *
+     * Safety from rep exposure:
+     *      - blocks are private and never returned, only pointers inside them
+     */
+public:
+    Arena() = delete;
+
+    Arena(const Arena& that) = delete;
+
+    Arena& operator=(const Arena& that) = delete;
+
+    Arena(Arena&& that) = delete;
+
+    Arena& operator=(Arena&& that) = delete;
+
+    /**
+     * Constructs a new arena with one block of the given size.
+     *
+     * @param block_size size of each block in bytes, must be positive
+     * @throw std::domain_error if block_size is not positive
+     */
+    explicit Arena(std::size_t block_size);
+
+    ~Arena();
+
+    /**
+     * Allocates memory from the arena. A new block is only requested from the
+     * heap when every existing block is exhausted.
+     *
+     * @param size number of bytes to allocate
+     * @param alignment alignment of the returned pointer, must be a power of two
+     * @return pointer to the allocated memory, valid until the next reset()
+     */
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Allocates an uninitialized array of count elements of type T.
+     *
+     * @param count number of elements
+     * @return pointer to the first element, valid until the next reset()
+     */
+    template<typename T>
+    T *allocate_array(std::size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * Releases every allocation made since the last reset, keeping the blocks.
+     */
+    void reset() noexcept;
+
+    /**
+     * @return number of bytes handed out since the last reset
+     */
+    std::size_t used() const noexcept;
+
+    /**
+     * @return total number of bytes owned by the arena
+     */
+    std::size_t capacity() const noexcept;
+
+private:
+    struct Block {
+        char *data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current;
+    std::size_t offset;
+    std::size_t block_size;
+};
+
+/**
+ * Standard library compatible allocator backed by an Arena.
+ * Deallocation is a no-op, memory is reclaimed by Arena::reset().
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() = delete;
+
+    ArenaAllocator(Arena& arena) noexcept: arena{&arena} {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& that) noexcept: arena{that.arena} {}
+
+    T *allocate(std::size_t count) {
+        return arena->allocate_array<T>(count);
+    }
+
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& that) const noexcept {
+        return arena == that.arena;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& that) const noexcept {
+        return arena != that.arena;
+    }
+
+    Arena *arena;
+};
+
+#endif
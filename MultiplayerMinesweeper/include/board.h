@@ -18,6 +18,12 @@ enum struct TILE_HIDDEN {
     EMPTY,
 };
 
+enum struct GAME_STATE {
+    IN_PROGRESS,
+    WON,
+    LOST,
+};
+
 /**
  * A mutable minesweeper board consisting tiles of specified length and width.
  * All tiles start untouched, some tiles have bomb hidden.
@@ -52,9 +58,51 @@ public:
     /**
      * Write the player's board representation in a pointer of char (buffer).
      * 
-     * @return a unique pointer to the buffer.
+     * @return a shared pointer to the buffer, the buffer is never modified
+     *         and may be shared with other callers
+     */
+    virtual std::shared_ptr<const char[]> print() = 0;
+
+    /**
+     * Write the player's board representation into a caller provided buffer,
+     * the same representation as print() including the terminating '\0'.
+     * 
+     * @param buffer the target buffer
+     * @param buffer_len length of the buffer, must be at least print_length()
+     * @return number of chars written excluding the '\0', -1 if the buffer is too small
      */
-    virtual std::unique_ptr<char[]> print() = 0;
+    virtual int print(char *buffer, int buffer_len) noexcept = 0;
+
+    /**
+     * @return the buffer length needed by print(buffer, buffer_len)
+     */
+    virtual int print_length() const noexcept = 0;
+
+    /**
+     * @return number of rows of the board
+     */
+    virtual int rows() const noexcept = 0;
+
+    /**
+     * @return number of columns of the board
+     */
+    virtual int columns() const noexcept = 0;
+
+    /**
+     * Move the board's memory to the given NUMA node and keep it there.
+     *
+     * @param node the NUMA node, a negative node does nothing
+     * @return true if the memory was placed or nothing had to be done
+     */
+    virtual bool place_on_node(int node) noexcept = 0;
+
+    /**
+     * Encode the whole state of the board, hidden tiles included, so that it can be
+     * restored in another process of the same machine.
+     *
+     * @return the encoded board
+     */
+    virtual std::string serialize() const = 0;
 
     /**
      * Digs the tile at position given by the x and y input.
@@ -80,6 +128,35 @@ public:
      * @param y the y position of the target tile.
      */
     virtual void deflag(int y, int x) noexcept = 0;
+
+    /**
+     * Current state of the game, computed from counters maintained by dig,
+     * flag and deflag so it never scans the board.
+     * 
+     * @return LOST once a bomb has been dug, WON once every empty tile is dug,
+     *         IN_PROGRESS otherwise
+     */
+    virtual GAME_STATE state() const noexcept = 0;
+
+    /**
+     * @return number of empty tiles that are not dug yet
+     */
+    virtual int remaining_safe_tiles() const noexcept = 0;
+
+    /**
+     * @return number of flagged tiles
+     */
+    virtual int flag_count() const noexcept = 0;
+
+    /**
+     * @return number of bombs dug
+     */
+    virtual int bombs_hit() const noexcept = 0;
+
+    /**
+     * @return a number that grows every time the player's board representation changes
+     */
+    virtual uint64_t version() const noexcept = 0;
 };
 
 #endif
\ No newline at end of file
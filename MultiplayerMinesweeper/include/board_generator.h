@@ -0,0 +1,44 @@
+#ifndef BOARD_GENERATOR_H
+#define BOARD_GENERATOR_H
+
+#include <cstdint>
+
+#include "board.h"
+
+/**
+ * Parallel, deterministic generation of the hidden side of a board.
+ * Results depend only on the inputs, never on the number of threads used.
+ */
+namespace BoardGenerator {
+    /**
+     * Place exactly bomb_count bombs in back. Every tile gets a key from a
+     * counter based random generator seeded with seed, the tiles with the
+     * bomb_count smallest keys (ties broken by position) hold the bombs.
+     *
+     * @param back the hidden tiles, size elements
+     * @param size number of tiles
+     * @param bomb_count number of bombs, requires 0 <= bomb_count <= size
+     * @param seed the seed to generate the board
+     * @param thread_count number of threads to use, must be positive
+     */
+    void place_bombs(TILE_HIDDEN *back, int size, int bomb_count, uint64_t seed, int thread_count);
+
+    /**
+     * Count the bombs around every tile.
+     *
+     * @param boundaries output, y_size * x_size elements
+     * @param back the hidden tiles, y_size * x_size elements
+     * @param y_size the width of the board
+     * @param x_size the length of the board
+     * @param thread_count number of threads to use, must be positive
+     */
+    void calculate_boundaries(int *boundaries, const TILE_HIDDEN *back, int y_size, int x_size, int thread_count);
+
+    /**
+     * @param size number of tiles of the board
+     * @return the number of threads worth using to generate a board of that size
+     */
+    int default_thread_count(int size);
+}
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef BOARD_IMPLEMENTATION_H
 #define BOARD_IMPLEMENTATION_H
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 #include "board.h"
 
 class BoardImplementation: public Board {
@@ -33,12 +37,73 @@ public:
      */
     BoardImplementation(int y_size, int x_size, int bomb_count, uint64_t seed = (uint64_t) std::time(nullptr));
 
+    /**
+     * Constructs a new board with the given bomb layout, all tiles untouched.
+     * 
+     * @param layout rows of 'B' (bomb) and 'E' (empty) tiles separated by '\n',
+     *               the same format as print_debug()["back"]
+     * @throw std::domain_error if the layout is empty, its rows differ in length
+     *        or it contains other tiles
+     */
+    explicit BoardImplementation(const std::string& layout);
+
+    /**
+     * Restores a board encoded by serialize().
+     * 
+     * @param snapshot the encoded board
+     * @return the restored board
+     * @throw std::domain_error if the snapshot is not an encoded board
+     */
+    static BoardImplementation deserialize(const std::string& snapshot);
+
         /**
      * Write the player's board representation in a pointer of char (buffer).
      * 
-     * @return a unique pointer to the buffer.
+     * @return a shared pointer to the buffer, the buffer is never modified
+     *         and may be shared with other callers
+     */
+    virtual std::shared_ptr<const char[]> print() override;
+
+    /**
+     * Write the player's board representation into a caller provided buffer,
+     * the same representation as print() including the terminating '\0'.
+     * 
+     * @param buffer the target buffer
+     * @param buffer_len length of the buffer, must be at least print_length()
+     * @return number of chars written excluding the '\0', -1 if the buffer is too small
+     */
+    virtual int print(char *buffer, int buffer_len) noexcept override;
+
+    /**
+     * @return the buffer length needed by print(buffer, buffer_len)
+     */
+    virtual int print_length() const noexcept override;
+
+    /**
+     * @return number of rows of the board
+     */
+    virtual int rows() const noexcept override;
+
+    /**
+     * @return number of columns of the board
+     */
+    virtual int columns() const noexcept override;
+
+    /**
+     * Move the board's memory to the given NUMA node and keep it there.
+     *
+     * @param node the NUMA node, a negative node does nothing
+     * @return true if the memory was placed or nothing had to be done
      */
-    virtual std::unique_ptr<char[]> print() override;
+    virtual bool place_on_node(int node) noexcept override;
+
+    /**
+     * Encode the whole state of the board, hidden tiles included, so that it can be
+     * restored in another process of the same machine.
+     *
+     * @return the encoded board
+     */
+    virtual std::string serialize() const override;
 
     /**
      * Digs the tile at position given by the x and y input.
@@ -65,6 +130,35 @@ public:
      */
     virtual void deflag(int y, int x) noexcept override;
 
+    /**
+     * Current state of the game, computed from counters maintained by dig,
+     * flag and deflag so it never scans the board.
+     * 
+     * @return LOST once a bomb has been dug, WON once every empty tile is dug,
+     *         IN_PROGRESS otherwise
+     */
+    virtual GAME_STATE state() const noexcept override;
+
+    /**
+     * @return number of empty tiles that are not dug yet
+     */
+    virtual int remaining_safe_tiles() const noexcept override;
+
+    /**
+     * @return number of flagged tiles
+     */
+    virtual int flag_count() const noexcept override;
+
+    /**
+     * @return number of bombs dug
+     */
+    virtual int bombs_hit() const noexcept override;
+
+    /**
+     * @return a number that grows every time the player's board representation changes
+     */
+    virtual uint64_t version() const noexcept override;
+
     /**
      * NOT FOR CLIENT USE, FOR DEBUGGING PURPOSE ONLY.
      * Write the player's board representation in a map of pointer of char (buffer).
@@ -72,13 +166,35 @@ public:
     std::unordered_map<std::string, std::unique_ptr<char []>> print_debug();
 
 private:
+    /**
+     * Constructs a board of the given size with untouched empty tiles and no boundaries.
+     */
+    BoardImplementation(int y_size, int x_size);
+
+    std::shared_ptr<char[]> refresh_rendered();
+    void mark_dirty(int row) noexcept;
+
     int y_size;
     int x_size;
 
+    // each array has pages of its own, so place_on_node() binds nothing else
     TILE_DISPLAY *front;
     TILE_HIDDEN *back;
     int *boundaries;
 
+    std::atomic<int> remaining_safe;
+    std::atomic<int> flags;
+    std::atomic<int> bombs;
+    std::atomic<uint64_t> changes;
+
+    // rendered holds print()'s output for every row not marked in dirty_rows,
+    // nullptr until the first print(). Rows are marked under the exclusive lock,
+    // patched under the shared lock and render_mutex.
+    std::shared_ptr<char[]> rendered;
+    std::vector<uint64_t> dirty_rows;
+    bool any_dirty;
+    std::mutex render_mutex;
+
     mutable std::shared_mutex threadLock;
 };
 
@@ -0,0 +1,92 @@
+#ifndef BOARD_MIRROR_H
+#define BOARD_MIRROR_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Client side copy of the board, fed with the raw stream received from the server.
+ * Board frames are applied row by row as they arrive and only the tiles that changed
+ * are redrawn, with ANSI cursor moves, the next time the mirror is rendered.
+ * Snapshots are decoded and applied like a board frame.
+ * Any other line is a message shown on the status line below the board.
+ */
+class BoardMirror {
+    /**
+     * Abstraction function:
+     *      - represents the last board seen from the server, tiles[y * columns + x]
+     *        is the tile at row y and column x as written by Board::print
+     *      - dirty[y * columns + x] iff that tile changed since the last render,
+     *        dirty_rows[y] iff some tile of row y is dirty
+     *      - status is the text of the status line, or every message received
+     *        so far while the board has not been drawn; status_dirty iff it
+     *        changed since the last render
+     *
+     * Representation invariant:
+     *      - rows == 0 iff columns == 0 iff the greeting has not been received
+     *      - tiles and dirty have rows * columns elements, dirty_rows has rows elements
+     *      - 0 <= frame_row < rows, or frame_row == 0 when rows == 0
+     *      - snapshot_remaining >= 0, while it is positive pending holds the
+     *        part of the encoded board received so far
+     *
+     * Safety from rep exposure:
+     *      - all representations are private, getters return by value
+     */
+public:
+    BoardMirror();
+
+    /**
+     * Consume bytes received from the server. Lines may be split across calls.
+     *
+     * @param data the received bytes
+     * @param length number of bytes
+     */
+    void receive(const char *data, int length);
+
+    /**
+     * Append the terminal output updating the screen to what has been received,
+     * then forget the changes. The whole screen is drawn on the first render after
+     * the greeting, afterwards only changed tiles and the status line are written.
+     *
+     * @param output the terminal output is appended to it
+     */
+    void render(std::string &output);
+
+    /**
+     * @return number of rows of the board, 0 until the greeting is received
+     */
+    int rows() const noexcept;
+
+    /**
+     * @return number of columns of the board, 0 until the greeting is received
+     */
+    int columns() const noexcept;
+
+    /**
+     * @return the tile at position given by the x and y input, '-' until it is received
+     */
+    char tile(int y, int x) const noexcept;
+
+private:
+    void handle_line(const char *line, int length);
+    bool is_board_row(const char *line, int length) const noexcept;
+    void apply_row(const char *line);
+    void apply_snapshot(const char *data, int length);
+
+    int rows_;
+    int columns_;
+    int frame_row;
+    bool drawn;
+
+    std::vector<char> tiles;
+    std::vector<bool> dirty;
+    std::vector<bool> dirty_rows;
+    std::string pending;
+    int snapshot_remaining;
+    int snapshot_rows;
+    int snapshot_columns;
+    std::string status;
+    bool status_dirty;
+};
+
+#endif
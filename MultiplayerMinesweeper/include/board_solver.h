@@ -0,0 +1,142 @@
+#ifndef BOARD_SOLVER_H
+#define BOARD_SOLVER_H
+
+#include <mutex>
+#include <vector>
+
+#include "board.h"
+
+enum struct TILE_KNOWLEDGE {
+    UNKNOWN,
+    SAFE,
+    MINE,
+};
+
+/**
+ * An incremental minesweeper solver working only on what players can see.
+ * It deduces safe tiles and mines from the numbers of dug tiles by constraint
+ * propagation, re-solving only the constraints around tiles that changed.
+ */
+class BoardSolver {
+    /**
+     * Abstraction function:
+     *      - represents the deductions that can be made from view, the last seen
+     *        player's board representation
+     *      - knowledge[i] is what is known about tile i, SAFE for every dug tile
+     *      - safe_tiles holds untouched tiles deduced to be safe, possibly
+     *        including tiles that have been dug or flagged since
+     *
+     * Representation invariant:
+     *      - view, knowledge and queued have y_size * x_size elements
+     *      - worklist holds exactly the tiles i with queued[i]
+     *      - flood is empty between calls
+     *
+     * Safety from rep exposure:
+     *      - all representations are private, getters return by value
+     */
+public:
+    BoardSolver() = delete;
+
+    /**
+     * Constructs a solver for a board of the given size where every tile is untouched.
+     *
+     * @param y_size the width of the board, must be a positive integer
+     * @param x_size the length of the board, must be a positive integer
+     * @throw std::domain_error if length or width is not positive
+     */
+    BoardSolver(int y_size, int x_size);
+
+    /**
+     * Constructs a solver for a board of the same size as the given board.
+     * The solver knows nothing until update() is called.
+     *
+     * @param board the solved board
+     */
+    explicit BoardSolver(Board *board);
+
+    /**
+     * Update the solver with the player's board representation.
+     * Only constraints next to changed tiles are solved again.
+     *
+     * @param view the board representation, as written by Board::print
+     */
+    void update(const char *view);
+
+    /**
+     * Update the solver with the current state of the board, reading every tile.
+     *
+     * @param board the solved board, must have the size given to the constructor
+     */
+    void update(Board *board);
+
+    /**
+     * Update the solver after a successful dig of the given tile. Only the tiles the
+     * dig can have uncovered are read: the tile itself and the region flooded from it
+     * through tiles without a number. Every dig of the board must be reported, or
+     * covered by a later update().
+     *
+     * @param board the solved board, must have the size given to the constructor
+     * @param y row of the dug tile
+     * @param x column of the dug tile
+     */
+    void dug(Board *board, int y, int x);
+
+    /**
+     * Update the solver after a flag or deflag of the given tile, reading only that tile.
+     * Every flag and deflag of the board must be reported, or covered by a later update(),
+     * for hint() to skip flagged tiles.
+     *
+     * @param board the solved board, must have the size given to the constructor
+     * @param y row of the tile
+     * @param x column of the tile, a tile out of the board is ignored
+     */
+    void marked(Board *board, int y, int x);
+
+    /**
+     * Find an untouched tile that is safe to dig. Flagged tiles are never offered.
+     *
+     * @param y output, row of the tile
+     * @param x output, column of the tile
+     * @return true if such a tile is known, false otherwise (y and x unchanged)
+     */
+    bool hint(int &y, int &x);
+
+    /**
+     * @return what is known about the tile at position given by the x and y input
+     */
+    TILE_KNOWLEDGE knowledge(int y, int x);
+
+    /**
+     * Decide whether the board can be solved from the given first dig without guessing.
+     * The board is played until no more deduction can be made.
+     *
+     * @param board the board to play, it is modified
+     * @param y row of the first dig
+     * @param x column of the first dig
+     * @return true if every empty tile has been dug without digging a bomb
+     */
+    static bool is_no_guess(Board *board, int y, int x);
+
+private:
+    void apply_view(const char *view);
+    void uncover(int tile, char shown);
+    void solve();
+    void enqueue_constraints_around(int tile);
+    void deduce(int tile, TILE_KNOWLEDGE value);
+    int collect_unknowns(int tile, int *unknowns, int &mines);
+
+    int y_size;
+    int x_size;
+
+    std::vector<char> view;
+    std::vector<char> buffer;
+    std::vector<TILE_KNOWLEDGE> knowledge_;
+    std::vector<bool> queued;
+    std::vector<int> worklist;
+    std::vector<int> flood;
+    std::vector<int> safe_tiles;
+
+    std::mutex threadLock;
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef CLIENT_SESSION_H
+#define CLIENT_SESSION_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "arena.h"
+#include "board.h"
+#include "board_solver.h"
+#include "game_over_signal.h"
+#include "rate_limiter.h"
+#include "snapshot_cache.h"
+#include "spectator_feed.h"
+
+/**
+ * The request loop of one player connection, apart from its transport.
+ * Bytes received from the client are split into lines, every complete line is
+ * executed on the board and its reply handed to the session's writer.
+ * A warmed up session handles requests without heap allocation.
+ * A line longer than the receive buffer is discarded up to its terminating '\n'.
+ */
+class ClientSession {
+    /**
+     * Abstraction function:
+     *      - represents a connection to a client of room, pending[0..pending_len) holds
+     *        the bytes received after the last complete line, discarding is true while
+     *        the rest of an over-long line is skipped
+     *
+     * Representation invariant:
+     *      - 0 <= pending_len < RECEIVE_BUFFER_LEN between calls of received()
+     *      - pending holds no '\n' between calls of received()
+     *
+     * Safety from rep exposure:
+     *      - only the free part of pending is handed out, through receive_buffer()
+     */
+public:
+    /**
+     * Server state shared by every session of a board, owned by the server.
+     */
+    struct Room {
+        Board *board;
+        BoardSolver *solver;
+        SnapshotCache *snapshots;
+        SpectatorFeed *feed;
+        TokenBucket *bucket;
+        std::atomic<uint64_t> *throttled;
+        GameOverSignal *game_over;
+    };
+
+    /**
+     * Sends bytes to the client.
+     *
+     * @return false if the connection failed
+     */
+    using Writer = std::function<bool(const char *data, int length)>;
+
+    ClientSession() = delete;
+
+    ClientSession(const ClientSession& that) = delete;
+
+    ClientSession& operator=(const ClientSession& that) = delete;
+
+    ClientSession(ClientSession&& that) = delete;
+
+    ClientSession& operator=(ClientSession&& that) = delete;
+
+    /**
+     * @param room the server state the session's requests use
+     * @param write writer of the replies
+     * @param rate requests touching the board allowed per second, must be positive
+     * @param burst requests touching the board allowed at once, must be positive
+     * @throw std::domain_error if rate or burst is not positive
+     */
+    ClientSession(const Room& room, Writer write, double rate, int burst);
+
+    /**
+     * Send the greeting every connection starts with.
+     *
+     * @return false if the connection failed
+     */
+    bool greet();
+
+    /**
+     * @return where the next bytes received from the client are stored
+     */
+    char *receive_buffer() noexcept;
+
+    /**
+     * @return number of bytes receive_buffer() can hold, always positive
+     */
+    int receive_capacity() const noexcept;
+
+    /**
+     * Handle the bytes just stored in receive_buffer(): execute every line they complete
+     * and keep a trailing partial line for the next call. Stops at the line that closes
+     * the connection or turns it into a spectator.
+     *
+     * @param length number of bytes stored, 0 < length <= receive_capacity()
+     */
+    void received(int length);
+
+    /**
+     * @return false once the client said bye, lost the game or a write failed
+     */
+    bool connected() const noexcept;
+
+    /**
+     * @return true once the client asked to spectate
+     */
+    bool spectator() const noexcept;
+
+private:
+    void execute(const char *line, int length);
+
+    Room room;
+    Writer write;
+    TokenBucket client_bucket;
+
+    // connection arena lives as long as the client, iteration arena is reset on every read
+    Arena connection_arena;
+    Arena iteration_arena;
+    char *pending;
+    int pending_len;
+    bool discarding;
+
+    bool open;
+    bool watching;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef GAME_OVER_SIGNAL_H
+#define GAME_OVER_SIGNAL_H
+
+#include <atomic>
+
+/**
+ * The end of a game, broadcast to every connection of its board.
+ * The connection whose dig ends the game raises the signal once, every connection
+ * polls fd() next to its socket and wakes up as soon as it is raised, so no
+ * connection checks the game state on its own.
+ */
+class GameOverSignal {
+    /**
+     * Abstraction function:
+     *      - represents whether the game is over, event is an eventfd that
+     *        is readable iff raised
+     *
+     * Representation invariant:
+     *      - event is never read, once readable it stays readable
+     *
+     * Safety from rep exposure:
+     *      - event is handed out only to be polled
+     */
+public:
+    GameOverSignal(const GameOverSignal& that) = delete;
+
+    GameOverSignal& operator=(const GameOverSignal& that) = delete;
+
+    GameOverSignal(GameOverSignal&& that) = delete;
+
+    GameOverSignal& operator=(GameOverSignal&& that) = delete;
+
+    /**
+     * Constructs a signal that is not raised.
+     *
+     * @throw std::runtime_error if the eventfd cannot be created
+     */
+    GameOverSignal();
+
+    ~GameOverSignal();
+
+    /**
+     * Announce the end of the game to every poller, raising an already raised signal does nothing.
+     */
+    void raise() noexcept;
+
+    /**
+     * @return true once raise() has been called
+     */
+    bool raised() const noexcept;
+
+    /**
+     * @return a file descriptor that polls readable (POLLIN) once the signal is raised, never read it
+     */
+    int fd() const noexcept;
+
+private:
+    int event;
+    std::atomic<bool> is_raised;
+};
+
+#endif
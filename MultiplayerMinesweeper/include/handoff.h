@@ -0,0 +1,55 @@
+#ifndef HANDOFF_H
+#define HANDOFF_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Passing file descriptors and state from a running server to its successor
+ * over a Unix domain socket, so a restart never closes the listening socket.
+ * One handoff is a single message: the descriptors travel as SCM_RIGHTS
+ * ancillary data next to the length of the state, the state follows.
+ */
+namespace Handoff {
+    static const int MAX_FDS = 16;
+
+    /**
+     * Wait for a successor on the given path.
+     *
+     * @param path filesystem path of the Unix domain socket, a stale socket is replaced
+     * @return the socket listening for the successor
+     * @throw std::runtime_error if the socket cannot be created
+     */
+    int listen(const std::string& path);
+
+    /**
+     * Connect to a predecessor waiting on the given path.
+     *
+     * @param path filesystem path of the Unix domain socket
+     * @return the connected socket, -1 if no predecessor is waiting
+     */
+    int connect(const std::string& path);
+
+    /**
+     * Send descriptors and state over a connected Unix domain socket.
+     * The descriptors stay open in the sender.
+     *
+     * @param socket the connected socket
+     * @param fds the descriptors, at most MAX_FDS
+     * @param state the state
+     * @throw std::runtime_error if sending fails
+     */
+    void send(int socket, const std::vector<int>& fds, const std::string& state);
+
+    /**
+     * Receive descriptors and state sent with send().
+     *
+     * @param socket the connected socket
+     * @param state output, the state
+     * @return the received descriptors, owned by the caller
+     * @throw std::runtime_error if receiving fails or the message is malformed
+     */
+    std::vector<int> receive(int socket, std::string& state);
+}
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef MINESWEEPER_SERVER_H
 #define MINESWEEPER_SERVER_H
 
+#include <string>
+
 #include "board.h"
 #include "board_implementation.h"
+#include "topology.h"
 
 class MinesweeperServer {
 private:
@@ -29,14 +32,55 @@ public:
      */
     MinesweeperServer(int port);
 
+    /**
+     * Mineswepeer server that listens for connections on port and serves the given board.
+     * 
+     * @param port port number, requires 0 <= port <= 65535
+     * @param board pointer to the board played on this server (dependency injection),
+     *              the server takes ownership of the board
+     */
+    MinesweeperServer(int port, Board *board);
+
+    /**
+     * Mineswepeer server that listens for connections on port and serves the given board,
+     * with its threads and board memory placed as given.
+     * 
+     * @param port port number, requires 0 <= port <= 65535
+     * @param board pointer to the board played on this server (dependency injection),
+     *              the server takes ownership of the board
+     * @param placement cpus of the accept and client threads and NUMA node of the board
+     */
+    MinesweeperServer(int port, Board *board, const Topology::Placement& placement);
+
+    /**
+     * Mineswepeer server taking over the listening socket and the board of a server
+     * waiting in hand_off() on the given path.
+     * 
+     * @param handoff_path filesystem path of the predecessor's handoff socket
+     * @param placement cpus of the accept and client threads and NUMA node of the board
+     * @throws std::runtime_error if no server is waiting on the path or the handoff fails
+     */
+    MinesweeperServer(const std::string& handoff_path, const Topology::Placement& placement);
+
     /**
      * Start the server, listening for client connection and handling them.
      * @throws std::runtime_error if the main server socket is broken
      */
     void start();
-    
+
     /**
+     * Wait for a successor on the given path, then hand it the listening socket and
+     * the board and stop. Connected clients are disconnected, their TLS sessions
+     * cannot move to another process, new connections are never refused.
      * 
+     * @param path filesystem path of the handoff socket
+     * @throws std::runtime_error if the handoff socket is broken
+     */
+    void hand_off(const std::string& path);
+    
+    /**
+     * Stop accepting connections, disconnect every client and close the listening
+     * socket. Only the first call does anything.
      */
     void stop();
 };
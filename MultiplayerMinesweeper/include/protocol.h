@@ -0,0 +1,110 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "arena.h"
+#include "board.h"
+#include "board_solver.h"
+
+/**
+ * Text protocol spoken between the minesweeper server and its clients.
+ * Every message is a single line terminated by '\n':
+ *      look
+ *      dig X Y
+ *      flag X Y
+ *      deflag X Y
+ *      help
+ *      hint
+ *      snapshot
+ *      spectate
+ *      bye
+ * where X is the column and Y is the row of the target tile.
+ * hint replies "hint X Y" with a tile that is safe to dig, or "hint none".
+ * snapshot replies "SNAPSHOT X Y N" followed by the board run-length encoded in N bytes,
+ * see SnapshotCodec.
+ * Once the game is over every connection receives "GAME WON" or "GAME LOST".
+ * Requests sent faster than the server's rate limits are answered "THROTTLED" and ignored.
+ * After spectate the connection becomes read-only and only receives board frames.
+ * Every connection is greeted with
+ *      Welcome to Minesweeper. Board: X columns by Y rows. Type 'help' for help.
+ * and every board frame is the board's Y rows, each terminated by '\n', with no separator
+ * between frames: clients count rows to find where a frame ends.
+ */
+namespace Protocol {
+    enum struct COMMAND {
+        LOOK,
+        DIG,
+        FLAG,
+        DEFLAG,
+        HELP,
+        HINT,
+        SNAPSHOT,
+        SPECTATE,
+        BYE,
+        INVALID,
+    };
+
+    struct Request {
+        COMMAND command;
+        int y;
+        int x;
+    };
+
+    /**
+     * An outbound message. data points either to static storage or
+     * into the arena passed to respond(), it is never owned by the frame.
+     */
+    struct Frame {
+        const char *data;
+        int length;
+        bool close_connection;
+    };
+
+    /**
+     * Parses one client message. Never allocates.
+     *
+     * @param message the message, does not need to be '\0' terminated
+     * @param length length of the message, trailing '\r' and '\n' are ignored
+     * @return the parsed request, COMMAND::INVALID if the message is malformed
+     */
+    Request parse(const char *message, int length) noexcept;
+
+    /**
+     * Executes a request on the board and encodes the reply.
+     * All memory for the reply comes from the arena.
+     *
+     * @param board the board the request is executed on
+     * @param request a parsed request
+     * @param arena arena the reply is written into
+     * @param solver solver of the board answering hints and told about every dig and flag,
+     *               nullptr if hints are disabled
+     * @return the reply frame, valid until the arena is reset, empty for spectate and
+     *         snapshot which are answered by the server from shared frames
+     */
+    Frame respond(Board *board, const Request& request, Arena& arena, BoardSolver *solver = nullptr);
+
+    /**
+     * Encodes the end of game announcement. Only reads the board's counters.
+     *
+     * @param board the board of the game
+     * @return the announcement, an empty frame while the game is in progress
+     */
+    Frame announce(Board *board) noexcept;
+
+    /**
+     * Encodes the reply to a request dropped by rate limiting.
+     *
+     * @return the reply
+     */
+    Frame throttled() noexcept;
+
+    /**
+     * Encodes the greeting sent once a connection is established.
+     *
+     * @param board the board of the game
+     * @param arena arena the greeting is written into
+     * @return the greeting, valid until the arena is reset
+     */
+    Frame greet(Board *board, Arena& arena);
+}
+
+#endif
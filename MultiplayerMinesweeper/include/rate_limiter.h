@@ -0,0 +1,144 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A token bucket refilled at rate tokens per second holding at most burst tokens,
+ * safe to share between threads without locks.
+ * It is kept in its GCRA form: a single atomic holds the theoretical arrival time,
+ * the time at which the bucket would be full again, and a token is taken by moving
+ * it one emission interval forward with a compare and swap.
+ */
+class TokenBucket {
+    /**
+     * Abstraction function:
+     *      - represents a bucket holding min(burst, (now + tolerance + interval - tat) / interval)
+     *        tokens at time now
+     *
+     * Representation invariant:
+     *      - interval > 0, tolerance == (burst - 1) * interval
+     *
+     * Safety from rep exposure:
+     *      - all representations are private
+     */
+public:
+    TokenBucket() = delete;
+
+    TokenBucket(const TokenBucket& that) = delete;
+
+    TokenBucket& operator=(const TokenBucket& that) = delete;
+
+    TokenBucket(TokenBucket&& that) = delete;
+
+    TokenBucket& operator=(TokenBucket&& that) = delete;
+
+    /**
+     * Constructs a full bucket.
+     *
+     * @param rate tokens added per second, must be positive
+     * @param burst capacity of the bucket, must be positive
+     * @throw std::domain_error if rate or burst is not positive
+     */
+    TokenBucket(double rate, int burst);
+
+    /**
+     * Take a token if there is one.
+     *
+     * @param now_ns current time in nanoseconds of a monotonic clock
+     * @return true if a token was taken
+     */
+    bool try_acquire(int64_t now_ns) noexcept;
+
+    /**
+     * Take a token if there is one, at the current time of the steady clock.
+     *
+     * @return true if a token was taken
+     */
+    bool try_acquire() noexcept;
+
+    /**
+     * Return a token taken by try_acquire() that was not used, so a request refused by
+     * another limiter does not pay for it.
+     */
+    void give_back() noexcept;
+
+    /**
+     * @return number of failed try_acquire() calls
+     */
+    uint64_t rejected() const noexcept;
+
+private:
+    int64_t interval;
+    int64_t tolerance;
+    std::atomic<int64_t> tat;
+    std::atomic<uint64_t> rejected_count;
+};
+
+/**
+ * Admission of new connections from the measured lag of the server's loops, the delay
+ * between the time a loop asked to wake up and the time it actually ran.
+ * Lag samples are smoothed with an exponentially weighted moving average,
+ * connections are shed while it exceeds the threshold. Lock-free.
+ */
+class AdmissionControl {
+    /**
+     * Abstraction function:
+     *      - represents the smoothed lag average_lag of the server, and the number
+     *        of connections shed so far
+     *
+     * Representation invariant:
+     *      - threshold >= 0, average_lag >= 0
+     *
+     * Safety from rep exposure:
+     *      - all representations are private
+     */
+public:
+    AdmissionControl() = delete;
+
+    AdmissionControl(const AdmissionControl& that) = delete;
+
+    AdmissionControl& operator=(const AdmissionControl& that) = delete;
+
+    AdmissionControl(AdmissionControl&& that) = delete;
+
+    AdmissionControl& operator=(AdmissionControl&& that) = delete;
+
+    /**
+     * @param max_lag_ns smoothed lag above which connections are shed, must be non negative
+     * @throw std::domain_error if max_lag_ns is negative
+     */
+    explicit AdmissionControl(int64_t max_lag_ns);
+
+    /**
+     * Add a lag sample.
+     *
+     * @param lag_ns the measured lag, negative samples count as 0
+     */
+    void record_lag(int64_t lag_ns) noexcept;
+
+    /**
+     * Decide whether a new connection is accepted, counting it as shed if it is not.
+     *
+     * @return true if the smoothed lag is at most the threshold
+     */
+    bool admit() noexcept;
+
+    /**
+     * @return the smoothed lag in nanoseconds
+     */
+    int64_t lag() const noexcept;
+
+    /**
+     * @return number of connections refused by admit()
+     */
+    uint64_t shed() const noexcept;
+
+private:
+    int64_t threshold;
+    std::atomic<int64_t> average_lag;
+    std::atomic<uint64_t> shed_count;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SNAPSHOT_CACHE_H
+#define SNAPSHOT_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "board.h"
+
+/**
+ * The last snapshot frame of a board, encoded once and shared by every connection
+ * asking for it until the board's version changes. A frame is the line
+ *      SNAPSHOT X Y N
+ * giving the columns, rows and encoded length of the board, followed by N bytes
+ * written by SnapshotCodec::encode.
+ */
+class SnapshotCache {
+    /**
+     * Abstraction function:
+     *      - represents the snapshot frame of board at version cached_version,
+     *        nothing is cached while frame == nullptr
+     *
+     * Representation invariant:
+     *      - frame is never modified after it is cached
+     *
+     * Safety from rep exposure:
+     *      - frames are shared as pointers to const
+     */
+public:
+    SnapshotCache() = delete;
+
+    SnapshotCache(const SnapshotCache& that) = delete;
+
+    SnapshotCache& operator=(const SnapshotCache& that) = delete;
+
+    SnapshotCache(SnapshotCache&& that) = delete;
+
+    SnapshotCache& operator=(SnapshotCache&& that) = delete;
+
+    /**
+     * @param board the cached board, must outlive the cache
+     */
+    explicit SnapshotCache(Board *board);
+
+    /**
+     * Get the snapshot frame of the board, encoding it only if the board changed since
+     * the last call. Concurrent callers wait for a single encoding.
+     *
+     * @return the snapshot frame, at least as recent as the board when the call started
+     */
+    std::shared_ptr<const std::string> get();
+
+    /**
+     * @return number of times the board has been encoded
+     */
+    uint64_t encodings() const noexcept;
+
+private:
+    Board *board;
+    std::shared_ptr<const std::string> frame;
+    uint64_t cached_version;
+    uint64_t encode_count;
+    std::string view;
+    mutable std::mutex cache_mutex;
+};
+
+#endif
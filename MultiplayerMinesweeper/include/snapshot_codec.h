@@ -0,0 +1,39 @@
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include <string>
+
+/**
+ * Run-length encoding of the player's board representation for full board transfers.
+ * Tiles are read row after row, ignoring the row separators, and every run of equal
+ * tiles becomes one byte: the tile's symbol in the high nibble and the run length
+ * minus one in the low nibble. A low nibble of 15 is followed by the run length
+ * minus 16 as a little endian base 128 varint.
+ * Symbols are '-', 'F', ' ', then '1' to '8'.
+ */
+namespace SnapshotCodec {
+    /**
+     * Encode a board representation.
+     *
+     * @param view the representation as written by Board::print, rows * (columns + 1) characters
+     * @param rows number of rows, must be positive
+     * @param columns number of columns, must be positive
+     * @param output the encoded board is appended to it
+     * @throw std::domain_error if view holds a character that is not a tile
+     */
+    void encode(const char *view, int rows, int columns, std::string& output);
+
+    /**
+     * Decode a board representation encoded by encode().
+     *
+     * @param data the encoded board
+     * @param length length of the encoded board
+     * @param rows number of rows of the board
+     * @param columns number of columns of the board
+     * @param view output, rows * (columns + 1) characters, every row followed by '\n'
+     * @return true if data encodes exactly rows * columns tiles, false otherwise
+     */
+    bool decode(const char *data, int length, int rows, int columns, char *view) noexcept;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SPECTATOR_FEED_H
+#define SPECTATOR_FEED_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "board.h"
+
+/**
+ * A throttled stream of board frames shared by every spectator of a board.
+ * Players mark the feed dirty after changing the board, the feed encodes at most
+ * max_frames_per_second frames and hands the same immutable frame to every spectator,
+ * so spectators never touch the board or its lock.
+ */
+class SpectatorFeed {
+    /**
+     * Abstraction function:
+     *      - represents the latest published snapshot of board, frame holds
+     *        its encoding and sequence counts the frames published so far
+     *
+     * Representation invariant:
+     *      - sequence == 0 iff frame == nullptr
+     *      - frame is never modified after it is published
+     *
+     * Safety from rep exposure:
+     *      - frames are shared as pointers to const
+     */
+public:
+    SpectatorFeed() = delete;
+
+    SpectatorFeed(const SpectatorFeed& that) = delete;
+
+    SpectatorFeed& operator=(const SpectatorFeed& that) = delete;
+
+    SpectatorFeed(SpectatorFeed&& that) = delete;
+
+    SpectatorFeed& operator=(SpectatorFeed&& that) = delete;
+
+    /**
+     * Constructs a feed of the given board, not publishing until start() is called.
+     *
+     * @param board the watched board, must outlive the feed
+     * @param max_frames_per_second upper bound of published frames per second, must be positive
+     * @throw std::domain_error if max_frames_per_second is not positive
+     */
+    SpectatorFeed(Board *board, int max_frames_per_second);
+
+    ~SpectatorFeed();
+
+    /**
+     * Start publishing frames, the first frame is published immediately.
+     */
+    void start();
+
+    /**
+     * Stop publishing frames and wake up every waiting spectator.
+     */
+    void stop();
+
+    /**
+     * Notify the feed that the board changed. Changes between two frames are
+     * coalesced into a single frame.
+     */
+    void mark_dirty() noexcept;
+
+    /**
+     * Blocks until a frame newer than last_sequence is published.
+     *
+     * @param last_sequence sequence of the last frame seen by the caller, 0 if none,
+     *                      updated to the sequence of the returned frame
+     * @param timeout_ms maximum time to wait in milliseconds
+     * @return the newest frame, nullptr if nothing new was published in time or the feed stopped
+     */
+    std::shared_ptr<const std::string> wait_frame(uint64_t &last_sequence, int timeout_ms);
+
+private:
+    void publish_frames();
+
+    Board *board;
+    int frame_interval_ms;
+
+    std::atomic<bool> running;
+    std::atomic<bool> dirty;
+    std::thread publisher;
+
+    std::shared_ptr<const std::string> frame;
+    uint64_t sequence;
+    std::mutex frame_mutex;
+    std::condition_variable frame_published;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * CPU and NUMA topology of the machine, read from sysfs, and the primitives
+ * to keep threads and memory on a chosen part of it.
+ */
+namespace Topology {
+    /**
+     * Where the server's threads run and where the board lives.
+     * An empty cpu list leaves the threads to the scheduler,
+     * a negative node leaves the memory where the kernel first put it.
+     */
+    struct Placement {
+        std::vector<int> accept_cpus;
+        std::vector<int> worker_cpus;
+        int board_node;
+    };
+
+    /**
+     * Parses a cpu list in the kernel's format, e.g. "0-3,8,10-11".
+     *
+     * @param list the cpu list, an empty string is an empty list
+     * @return the cpus in the order they appear in the list
+     * @throw std::domain_error if the list is malformed
+     */
+    std::vector<int> parse_cpu_list(const std::string& list);
+
+    /**
+     * @return number of NUMA nodes, 1 if the machine does not report any
+     */
+    int node_count();
+
+    /**
+     * @param node a NUMA node, requires 0 <= node < node_count()
+     * @return the cpus of the node, every online cpu if the machine does not report nodes
+     */
+    std::vector<int> node_cpus(int node);
+
+    /**
+     * Read a placement from MINESWEEPER_ACCEPT_CPUS, MINESWEEPER_WORKER_CPUS (cpu lists)
+     * and MINESWEEPER_BOARD_NODE. When only the board node is given, workers are
+     * pinned to the cpus of that node.
+     *
+     * @return the placement, nothing is pinned or bound when no variable is set
+     * @throw std::domain_error if a variable is malformed
+     */
+    Placement placement_from_environment();
+
+    /**
+     * Restrict the calling thread to the given cpus.
+     *
+     * @param cpus the allowed cpus, an empty list does nothing
+     * @return true if the affinity was set or nothing had to be done
+     */
+    bool pin_current_thread(const std::vector<int>& cpus);
+
+    /**
+     * Bind the pages holding [address, address + length) to the node and move
+     * the ones already allocated elsewhere. Whole pages are bound, so the memory
+     * must own the rest of its last page too.
+     *
+     * @param address start of the memory
+     * @param length length of the memory in bytes
+     * @param node the NUMA node, a negative node does nothing
+     * @return true if the memory was bound or nothing had to be done,
+     *         false if address is not the start of a page
+     */
+    bool bind_memory(void *address, size_t length, int node);
+
+    /**
+     * @param placement the placement in use
+     * @return a human readable report of the nodes and of the placement
+     */
+    std::string describe(const Placement& placement);
+}
+
+#endif
@@ -15,6 +15,19 @@ namespace Util {
     void configure_client_context(SSL_CTX *ctx);
 
     void set_non_blocking(int fd);
+
+    /**
+     * Ask OpenSSL to hand the record layer to the kernel (kTLS) once the handshake
+     * is done. Connections silently keep userspace encryption when the OpenSSL build,
+     * the kernel or the negotiated cipher does not support it.
+     */
+    void enable_ktls(SSL_CTX *ctx);
+
+    /**
+     * @return a static description of the kTLS state of an established connection,
+     *         "send+recv", "send", "recv" or "off"
+     */
+    const char* ktls_status(SSL *ssl);
 }
 
 #endif
\ No newline at end of file
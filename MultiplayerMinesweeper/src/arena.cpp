@@ -0,0 +1,57 @@
+#include "arena.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+Arena::Arena(std::size_t block_size):
+blocks{}, current{0}, offset{0}, block_size{block_size} {
+    if (block_size == 0) throw std::domain_error("block_size must be positive.");
+    blocks.push_back(Block{new char[block_size], block_size});
+}
+
+Arena::~Arena() {
+    for (Block& block: blocks) delete[] block.data;
+}
+
+static inline std::size_t align_up(char *base, std::size_t offset, std::size_t alignment) {
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(base) + offset;
+    std::uintptr_t aligned = (address + alignment - 1) & ~(std::uintptr_t) (alignment - 1);
+    return offset + (aligned - address);
+}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment) {
+    while (true) {
+        Block& block = blocks[current];
+        std::size_t start = align_up(block.data, offset, alignment);
+        if (start + size <= block.size) {
+            offset = start + size;
+            return block.data + start;
+        }
+
+        // move on to the next block, growing the arena only when none is left
+        offset = 0;
+        if (++current < blocks.size()) continue;
+
+        // fresh blocks are already aligned to max_align_t
+        std::size_t needed = alignment > alignof(std::max_align_t) ? size + alignment : size;
+        std::size_t new_size = needed > block_size ? needed : block_size;
+        blocks.push_back(Block{new char[new_size], new_size});
+    }
+}
+
+void Arena::reset() noexcept {
+    current = 0;
+    offset = 0;
+}
+
+std::size_t Arena::used() const noexcept {
+    std::size_t total = offset;
+    for (std::size_t i = 0; i < current; i++) total += blocks[i].size;
+    return total;
+}
+
+std::size_t Arena::capacity() const noexcept {
+    std::size_t total = 0;
+    for (const Block& block: blocks) total += block.size;
+    return total;
+}
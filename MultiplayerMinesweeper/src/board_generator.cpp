@@ -0,0 +1,118 @@
+#include "board_generator.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define BUCKET_BITS 16
+#define BUCKET_COUNT (1 << BUCKET_BITS)
+#define MIN_TILES_PER_THREAD 262144
+
+/**
+ * SplitMix64 evaluated at an arbitrary position of its stream, so any tile's
+ * key can be computed independently of every other tile.
+ */
+static inline uint64_t tile_key(uint64_t seed, uint64_t index) {
+    uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline int bucket_of(uint64_t key) {
+    return key >> (64 - BUCKET_BITS);
+}
+
+/**
+ * Run task(thread_index, begin, end) on thread_count contiguous slices of [0, count).
+ */
+template<typename F>
+static void parallel_for(int count, int thread_count, F task) {
+    if (thread_count <= 1 || count < thread_count) {
+        task(0, 0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        int begin = (long) count * t / thread_count;
+        int end = (long) count * (t + 1) / thread_count;
+        threads.emplace_back(task, t, begin, end);
+    }
+    for (std::thread& thread: threads) thread.join();
+}
+
+void BoardGenerator::place_bombs(TILE_HIDDEN *back, int size, int bomb_count, uint64_t seed, int thread_count) {
+    if (bomb_count == 0) {
+        std::fill(back, back + size, TILE_HIDDEN::EMPTY);
+        return;
+    }
+
+    // histogram of the key's top bits, summed over threads so the total is thread independent
+    std::vector<std::vector<int>> histograms(thread_count);
+    parallel_for(size, thread_count, [&](int t, int begin, int end) {
+        std::vector<int> histogram(BUCKET_COUNT, 0);
+        for (int i = begin; i < end; i++) histogram[bucket_of(tile_key(seed, i))]++;
+        histograms[t] = std::move(histogram);
+    });
+
+    // the boundary bucket holds the bomb_count-th smallest key
+    int boundary_bucket = 0;
+    int below_boundary = 0;
+    for (; boundary_bucket < BUCKET_COUNT; boundary_bucket++) {
+        int in_bucket = 0;
+        for (std::vector<int>& histogram: histograms) {
+            if (!histogram.empty()) in_bucket += histogram[boundary_bucket];
+        }
+        if (below_boundary + in_bucket >= bomb_count) break;
+        below_boundary += in_bucket;
+    }
+
+    // every tile below the boundary bucket is a bomb, collect the ones inside it
+    std::vector<std::vector<std::pair<uint64_t, int>>> candidates(thread_count);
+    parallel_for(size, thread_count, [&](int t, int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            uint64_t key = tile_key(seed, i);
+            int bucket = bucket_of(key);
+            back[i] = bucket < boundary_bucket ? TILE_HIDDEN::BOMB : TILE_HIDDEN::EMPTY;
+            if (bucket == boundary_bucket) candidates[t].push_back(std::make_pair(key, i));
+        }
+    });
+
+    std::vector<std::pair<uint64_t, int>> boundary_tiles;
+    for (std::vector<std::pair<uint64_t, int>>& list: candidates) {
+        boundary_tiles.insert(boundary_tiles.end(), list.begin(), list.end());
+    }
+    int remaining = bomb_count - below_boundary;
+    std::nth_element(boundary_tiles.begin(), boundary_tiles.begin() + (remaining - 1), boundary_tiles.end());
+    for (int i = 0; i < remaining; i++) back[boundary_tiles[i].second] = TILE_HIDDEN::BOMB;
+}
+
+void BoardGenerator::calculate_boundaries(int *boundaries, const TILE_HIDDEN *back, int y_size, int x_size, int thread_count) {
+    // every tile gathers from its neighbors, so rows can be split without any synchronization
+    parallel_for(y_size, thread_count, [&](int, int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            int row_begin = i > 0 ? i - 1 : i;
+            int row_end = i < y_size - 1 ? i + 1 : i;
+            for (int j = 0; j < x_size; j++) {
+                int col_begin = j > 0 ? j - 1 : j;
+                int col_end = j < x_size - 1 ? j + 1 : j;
+                int count = 0;
+                for (int row = row_begin; row <= row_end; row++) {
+                    for (int col = col_begin; col <= col_end; col++) {
+                        if ((row != i || col != j) && back[row * x_size + col] == TILE_HIDDEN::BOMB) count++;
+                    }
+                }
+                boundaries[i * x_size + j] = count;
+            }
+        }
+    });
+}
+
+int BoardGenerator::default_thread_count(int size) {
+    int hardware = std::thread::hardware_concurrency();
+    if (hardware < 1) hardware = 1;
+    int useful = size / MIN_TILES_PER_THREAD + 1;
+    return useful < hardware ? useful : hardware;
+}
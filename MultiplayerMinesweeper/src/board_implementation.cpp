@@ -1,9 +1,34 @@
 #include <board_implementation.h>
 
+#include <cstdint>
 #include <algorithm>
-#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <stdexcept>
-#include <vector>
+#include <utility>
+#include <unistd.h>
+
+#include "board_generator.h"
+#include "topology.h"
+
+#define MAX_NEIGHBORS 8
+#define SNAPSHOT_MAGIC 0x4d534231
+#define SNAPSHOT_HEADER_LEN (6 * sizeof(int32_t))
+
+/**
+ * Allocates a tile array on pages of its own, so binding it to a NUMA node moves nothing else.
+ * Free it with std::free.
+ */
+template<typename T>
+static T *allocate_tiles(int size, T value) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t length = (std::max<size_t>(size * sizeof(T), 1) + page - 1) / page * page;
+    T *tiles = (T *) std::aligned_alloc(page, length);
+    if (tiles == nullptr) throw std::bad_alloc();
+    std::fill(tiles, tiles + size, value);
+    return tiles;
+}
 
 template<typename T>
 static inline void copy_array(T *target, T *source, int size) {
@@ -13,7 +38,7 @@ static inline void copy_array(T *target, T *source, int size) {
 }
 
 BoardImplementation::BoardImplementation(const BoardImplementation& that):
-Board(0, 0, 0, 0), x_size{}, y_size{}, threadLock{} {
+Board(0, 0, 0, 0), x_size{}, y_size{}, remaining_safe{0}, flags{0}, bombs{0}, changes{0}, rendered{nullptr}, dirty_rows{}, any_dirty{false}, render_mutex{}, threadLock{} {
     std::unique_lock<std::shared_mutex> this_lock(threadLock);
     std::unique_lock<std::shared_mutex> that_lock(that.threadLock);
 
@@ -21,12 +46,18 @@ Board(0, 0, 0, 0), x_size{}, y_size{}, threadLock{} {
     this->y_size = that.y_size;
     
     int size = that.x_size * that.y_size;
-    this->front = new TILE_DISPLAY[size];
+    this->front = allocate_tiles(size, TILE_DISPLAY::UNTOUCHED);
     copy_array(this->front, that.front, size);
-    this->back = new TILE_HIDDEN[size];
+    this->back = allocate_tiles(size, TILE_HIDDEN::EMPTY);
     copy_array(this->back, that.back, size);
-    this->boundaries = new int[size];
+    this->boundaries = allocate_tiles(size, 0);
     copy_array(this->boundaries, that.boundaries, size);
+
+    this->remaining_safe = that.remaining_safe.load();
+    this->flags = that.flags.load();
+    this->bombs = that.bombs.load();
+    this->changes = that.changes.load();
+    this->dirty_rows.assign((y_size + 63) / 64, 0);
 }
 
 BoardImplementation& BoardImplementation::operator=(const BoardImplementation& that) {
@@ -37,23 +68,41 @@ BoardImplementation& BoardImplementation::operator=(const BoardImplementation& t
     this->y_size = that.y_size;
     
     int size = that.x_size * that.y_size;
-    this->front = new TILE_DISPLAY[size];
+    this->front = allocate_tiles(size, TILE_DISPLAY::UNTOUCHED);
     copy_array(this->front, that.front, size);
-    this->back = new TILE_HIDDEN[size];
+    this->back = allocate_tiles(size, TILE_HIDDEN::EMPTY);
     copy_array(this->back, that.back, size);
-    this->boundaries = new int[size];
+    this->boundaries = allocate_tiles(size, 0);
     copy_array(this->boundaries, that.boundaries, size);
+
+    this->remaining_safe = that.remaining_safe.load();
+    this->flags = that.flags.load();
+    this->bombs = that.bombs.load();
+    this->changes = that.changes.load();
+    this->rendered = nullptr;
+    this->dirty_rows.assign((y_size + 63) / 64, 0);
+    this->any_dirty = false;
     
     return *this;
 }
 
 BoardImplementation::BoardImplementation(BoardImplementation&& that):
-Board(0, 0, 0, 0), x_size{}, y_size{}, threadLock{} { 
+Board(0, 0, 0, 0), x_size{}, y_size{}, remaining_safe{0}, flags{0}, bombs{0}, changes{0}, rendered{nullptr}, dirty_rows{}, any_dirty{false}, render_mutex{}, threadLock{} { 
     std::unique_lock<std::shared_mutex> this_lock(threadLock);
 
     this->x_size = that.x_size;
     this->y_size = that.y_size;
     this->front = that.front;
+    this->back = that.back;
+    this->boundaries = that.boundaries;
+    this->remaining_safe = that.remaining_safe.load();
+    this->flags = that.flags.load();
+    this->bombs = that.bombs.load();
+    this->changes = that.changes.load();
+
+    this->rendered = std::move(that.rendered);
+    this->dirty_rows = std::move(that.dirty_rows);
+    this->any_dirty = that.any_dirty;
 
     that.front = nullptr;
     that.back = nullptr;
@@ -66,6 +115,16 @@ BoardImplementation& BoardImplementation::operator=(BoardImplementation&& that)
     this->x_size = that.x_size;
     this->y_size = that.y_size;
     this->front = that.front;
+    this->back = that.back;
+    this->boundaries = that.boundaries;
+    this->remaining_safe = that.remaining_safe.load();
+    this->flags = that.flags.load();
+    this->bombs = that.bombs.load();
+    this->changes = that.changes.load();
+
+    this->rendered = std::move(that.rendered);
+    this->dirty_rows = std::move(that.dirty_rows);
+    this->any_dirty = that.any_dirty;
 
     that.front = nullptr;
     that.back = nullptr;
@@ -75,27 +134,13 @@ BoardImplementation& BoardImplementation::operator=(BoardImplementation&& that)
 }
 
 BoardImplementation::~BoardImplementation() {
-    delete[] this->front;
-    delete[] this->back;
-    delete[] this->boundaries;
+    std::free(this->front);
+    std::free(this->back);
+    std::free(this->boundaries);
 }
 
-static inline void place_bomb(TILE_HIDDEN *back, int size, int bomb_count, uint64_t seed) {
-    for (int i = 0; i < size; i++) {
-        if (i < bomb_count) {
-            back[i] = TILE_HIDDEN::BOMB;
-            continue;
-        }
-        back[i] = TILE_HIDDEN::EMPTY;
-    }
-
-    std::mt19937 rd{seed};
-    std::default_random_engine rng(rd());
-    std::shuffle(back, back + size, rng);
-}
-
-static inline std::unique_ptr<std::vector<std::pair<int, int>>> find_neighbors(int y, int x, int y_size, int x_size) {
-    std::unique_ptr<std::vector<std::pair<int, int>>> output(new std::vector<std::pair<int, int>>());
+static inline int find_neighbors(int y, int x, int y_size, int x_size, std::pair<int, int> *output) {
+    int count = 0;
     int displacement[] = {-1, 0, 1};
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
@@ -105,25 +150,15 @@ static inline std::unique_ptr<std::vector<std::pair<int, int>>> find_neighbors(i
             
             if (row == -1 || row == y_size || col == -1 || col == x_size) continue;
 
-            output.get()->push_back(std::make_pair(row, col));
-        }
-    }
-    return output;
-}
-
-static inline void calculate_boundary(int *boundaries, TILE_HIDDEN* back, int y_size, int x_size) {
-    for (int i = 0; i < y_size; i++) {
-        for (int j = 0; j < x_size; j++) {
-            if (back[i * x_size + j] == TILE_HIDDEN::BOMB) {
-                std::unique_ptr<std::vector<std::pair<int, int>>> neighbors = find_neighbors(i, j, y_size, x_size);
-                for (auto i = neighbors.get()->begin(); i != neighbors.get()->end(); i++) boundaries[i->first * x_size + i->second]++;
-            }
+            output[count++] = std::make_pair(row, col);
         }
     }
+    return count;
 }
 
 BoardImplementation::BoardImplementation(int y_size, int x_size, int bomb_count, uint64_t seed):
-Board(0, 0, 0, 0), y_size{y_size}, x_size{x_size}, front{nullptr}, back{nullptr}, boundaries{nullptr}, threadLock{} {
+Board(0, 0, 0, 0), y_size{y_size}, x_size{x_size}, front{nullptr}, back{nullptr}, boundaries{nullptr},
+remaining_safe{0}, flags{0}, bombs{0}, changes{0}, rendered{nullptr}, dirty_rows{}, any_dirty{false}, render_mutex{}, threadLock{} {
     std::unique_lock<std::shared_mutex> write_lock(threadLock);
 
     if (y_size < 1) throw std::domain_error("y_size must be positive.");
@@ -133,53 +168,252 @@ Board(0, 0, 0, 0), y_size{y_size}, x_size{x_size}, front{nullptr}, back{nullptr}
     int size = y_size * x_size;
     if (bomb_count > size) throw std::runtime_error("bomb_count cannot be larger than the front size");
     
-    front = new TILE_DISPLAY[size] {TILE_DISPLAY::UNTOUCHED};
+    front = allocate_tiles(size, TILE_DISPLAY::UNTOUCHED);
+
+    back = allocate_tiles(size, TILE_HIDDEN::EMPTY);
 
-    back = new TILE_HIDDEN[size] {TILE_HIDDEN::EMPTY};
+    boundaries = allocate_tiles(size, 0);
 
-    boundaries = new int[size] {0};
+    int thread_count = BoardGenerator::default_thread_count(size);
 
-    place_bomb(back, size, bomb_count, seed);
+    BoardGenerator::place_bombs(back, size, bomb_count, seed, thread_count);
 
-    calculate_boundary(boundaries, back, y_size, x_size);
+    BoardGenerator::calculate_boundaries(boundaries, back, y_size, x_size, thread_count);
+
+    remaining_safe = size - bomb_count;
+    dirty_rows.assign((y_size + 63) / 64, 0);
 }
 
-std::unique_ptr<char[]> BoardImplementation::print() {
-    std::shared_lock<std::shared_mutex> read_lock(threadLock);
+static inline int layout_width(const std::string& layout) {
+    std::size_t row_end = layout.find('\n');
+    int x_size = row_end == std::string::npos ? layout.length() : row_end;
+    if (x_size < 1) throw std::domain_error("layout rows must not be empty.");
+    if ((layout.length() + 1) % (x_size + 1) != 0) throw std::domain_error("layout rows must have the same length.");
+
+    for (std::size_t i = 0; i < layout.length(); i++) {
+        bool row_end = (i + 1) % (x_size + 1) == 0;
+        if (row_end && layout[i] != '\n') throw std::domain_error("layout rows must have the same length.");
+        if (!row_end && layout[i] != 'B' && layout[i] != 'E') throw std::domain_error("layout tiles must be either 'B' or 'E'.");
+    }
+    return x_size;
+}
+
+BoardImplementation::BoardImplementation(const std::string& layout):
+Board(0, 0, 0, 0), y_size{0}, x_size{layout_width(layout)}, front{nullptr}, back{nullptr}, boundaries{nullptr},
+remaining_safe{0}, flags{0}, bombs{0}, changes{0}, rendered{nullptr}, dirty_rows{}, any_dirty{false}, render_mutex{}, threadLock{} {
+    std::unique_lock<std::shared_mutex> write_lock(threadLock);
+
+    y_size = (layout.length() + 1) / (x_size + 1);
+    int size = y_size * x_size;
+
+    front = allocate_tiles(size, TILE_DISPLAY::UNTOUCHED);
+
+    back = allocate_tiles(size, TILE_HIDDEN::EMPTY);
+
+    boundaries = allocate_tiles(size, 0);
 
-    int x_length = x_size + 1;
-    int y_length = y_size;
-    int size = y_length * x_length;
-    std::unique_ptr<char[]> output(new char[size]);
     for (int i = 0; i < y_size; i++) {
         for (int j = 0; j < x_size; j++) {
-            if (front[i * x_size + j] == TILE_DISPLAY::UNTOUCHED) output[i * x_length + j] = '-';
-            else if (front[i * x_size + j] == TILE_DISPLAY::FLAGGED) output[i * x_length + j] = 'F';
-            else if (boundaries[i * x_size + j] == 0) output[i * x_length + j] = ' ';
-            else output[i * x_length + j] = '0' + boundaries[i * x_size + j];
+            bool bomb = layout[i * (x_size + 1) + j] == 'B';
+            back[i * x_size + j] = bomb ? TILE_HIDDEN::BOMB : TILE_HIDDEN::EMPTY;
+            if (!bomb) remaining_safe++;
         }
-        output[(i + 1) * x_length - 1] = '\n';
     }
-    output[size-1] = '\0';
+
+    BoardGenerator::calculate_boundaries(boundaries, back, y_size, x_size, 1);
+    dirty_rows.assign((y_size + 63) / 64, 0);
+}
+
+BoardImplementation::BoardImplementation(int y_size, int x_size):
+Board(0, 0, 0, 0), y_size{y_size}, x_size{x_size}, front{nullptr}, back{nullptr}, boundaries{nullptr},
+remaining_safe{0}, flags{0}, bombs{0}, changes{0}, rendered{nullptr}, dirty_rows{}, any_dirty{false}, render_mutex{}, threadLock{} {
+    int size = y_size * x_size;
+    front = allocate_tiles(size, TILE_DISPLAY::UNTOUCHED);
+    back = allocate_tiles(size, TILE_HIDDEN::EMPTY);
+    boundaries = allocate_tiles(size, 0);
+    dirty_rows.assign((y_size + 63) / 64, 0);
+}
+
+/**
+ * Snapshot layout, in native byte order:
+ *      magic, y_size, x_size, remaining_safe, flags, bombs    6 int32
+ *      front                                                  y_size * x_size bytes
+ *      back                                                   y_size * x_size bytes
+ *      boundaries                                             y_size * x_size int32
+ */
+template<typename T>
+static inline void append_raw(std::string& output, const T& value) {
+    output.append((const char *) &value, sizeof(T));
+}
+
+template<typename T>
+static inline T read_raw(const std::string& input, size_t &position) {
+    T value;
+    memcpy(&value, input.data() + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+}
+
+std::string BoardImplementation::serialize() const {
+    std::shared_lock<std::shared_mutex> read_lock(threadLock);
+
+    int size = y_size * x_size;
+    std::string output;
+    output.reserve(SNAPSHOT_HEADER_LEN + size * (2 + sizeof(int32_t)));
+    append_raw<int32_t>(output, SNAPSHOT_MAGIC);
+    append_raw<int32_t>(output, y_size);
+    append_raw<int32_t>(output, x_size);
+    append_raw<int32_t>(output, remaining_safe.load());
+    append_raw<int32_t>(output, flags.load());
+    append_raw<int32_t>(output, bombs.load());
+    for (int i = 0; i < size; i++) output.push_back((char) front[i]);
+    for (int i = 0; i < size; i++) output.push_back((char) back[i]);
+    for (int i = 0; i < size; i++) append_raw<int32_t>(output, boundaries[i]);
     return output;
 }
 
+BoardImplementation BoardImplementation::deserialize(const std::string& snapshot) {
+    if (snapshot.size() < SNAPSHOT_HEADER_LEN) throw std::domain_error("snapshot is too short.");
+    size_t position = 0;
+    if (read_raw<int32_t>(snapshot, position) != SNAPSHOT_MAGIC) throw std::domain_error("snapshot is not a board.");
+    int y_size = read_raw<int32_t>(snapshot, position);
+    int x_size = read_raw<int32_t>(snapshot, position);
+    if (y_size < 1 || x_size < 1 || (long) y_size * x_size > INT32_MAX / 8) throw std::domain_error("snapshot size is invalid.");
+    int size = y_size * x_size;
+    if (snapshot.size() != SNAPSHOT_HEADER_LEN + size * (2 + sizeof(int32_t))) throw std::domain_error("snapshot length does not match its size.");
+
+    BoardImplementation board{y_size, x_size};
+    board.remaining_safe = read_raw<int32_t>(snapshot, position);
+    board.flags = read_raw<int32_t>(snapshot, position);
+    board.bombs = read_raw<int32_t>(snapshot, position);
+    for (int i = 0; i < size; i++) {
+        char tile = snapshot[position++];
+        if (tile > (char) TILE_DISPLAY::DUG || tile < 0) throw std::domain_error("snapshot tile is invalid.");
+        board.front[i] = (TILE_DISPLAY) tile;
+    }
+    for (int i = 0; i < size; i++) {
+        char tile = snapshot[position++];
+        if (tile > (char) TILE_HIDDEN::EMPTY || tile < 0) throw std::domain_error("snapshot tile is invalid.");
+        board.back[i] = (TILE_HIDDEN) tile;
+    }
+    for (int i = 0; i < size; i++) board.boundaries[i] = read_raw<int32_t>(snapshot, position);
+    return board;
+}
+
+static inline void render_row(char *output, const TILE_DISPLAY *front, const int *boundaries, int x_size) {
+    for (int j = 0; j < x_size; j++) {
+        if (front[j] == TILE_DISPLAY::UNTOUCHED) output[j] = '-';
+        else if (front[j] == TILE_DISPLAY::FLAGGED) output[j] = 'F';
+        else if (boundaries[j] == 0) output[j] = ' ';
+        else output[j] = '0' + boundaries[j];
+    }
+    output[x_size] = '\n';
+}
+
+void BoardImplementation::mark_dirty(int row) noexcept {
+    dirty_rows[row / 64] |= 1ULL << (row % 64);
+    any_dirty = true;
+}
+
+std::shared_ptr<char[]> BoardImplementation::refresh_rendered() {
+    std::lock_guard<std::mutex> lock(render_mutex);
+    if (rendered != nullptr && !any_dirty) return rendered;
+
+    int x_length = x_size + 1;
+    int size = y_size * x_length;
+    if (rendered == nullptr) {
+        std::shared_ptr<char[]> output(new char[size]);
+        for (int i = 0; i < y_size; i++) render_row(&output[i * x_length], front + i * x_size, boundaries + i * x_size, x_size);
+        output[size - 1] = '\0';
+        rendered = std::move(output);
+    } else {
+        // a buffer handed out by print() is immutable, patch a copy of it instead
+        if (rendered.use_count() > 1) {
+            std::shared_ptr<char[]> copy(new char[size]);
+            memcpy(copy.get(), rendered.get(), size);
+            rendered = std::move(copy);
+        }
+        for (size_t word = 0; word < dirty_rows.size(); word++) {
+            uint64_t bits = dirty_rows[word];
+            while (bits != 0) {
+                int i = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                render_row(&rendered[i * x_length], front + i * x_size, boundaries + i * x_size, x_size);
+            }
+        }
+        rendered[size - 1] = '\0';
+    }
+
+    std::fill(dirty_rows.begin(), dirty_rows.end(), 0);
+    any_dirty = false;
+    return rendered;
+}
+
+std::shared_ptr<const char[]> BoardImplementation::print() {
+    std::shared_lock<std::shared_mutex> read_lock(threadLock);
+    return refresh_rendered();
+}
+
+int BoardImplementation::print(char *buffer, int buffer_len) noexcept {
+    std::shared_lock<std::shared_mutex> read_lock(threadLock);
+
+    int x_length = x_size + 1;
+    int size = y_size * x_length;
+    if (buffer_len < size) return -1;
+
+    try {
+        std::shared_ptr<char[]> output = refresh_rendered();
+        memcpy(buffer, output.get(), size);
+    } catch (std::bad_alloc& error) {
+        for (int i = 0; i < y_size; i++) render_row(buffer + i * x_length, front + i * x_size, boundaries + i * x_size, x_size);
+        buffer[size - 1] = '\0';
+    }
+    return size - 1;
+}
+
+int BoardImplementation::print_length() const noexcept {
+    return y_size * (x_size + 1);
+}
+
+int BoardImplementation::rows() const noexcept {
+    return y_size;
+}
+
+int BoardImplementation::columns() const noexcept {
+    return x_size;
+}
+
+bool BoardImplementation::place_on_node(int node) noexcept {
+    int size = y_size * x_size;
+    bool placed = Topology::bind_memory(front, size * sizeof(TILE_DISPLAY), node);
+    placed = Topology::bind_memory(back, size * sizeof(TILE_HIDDEN), node) && placed;
+    placed = Topology::bind_memory(boundaries, size * sizeof(int), node) && placed;
+    return placed;
+}
+
 static inline bool is_out_of_bound(int y, int x, int y_limit, int x_limit) {
     return (y < 0 || x < 0 || y >= y_limit || x >= x_limit);
 }
 
-static void recursive_dig(TILE_DISPLAY *front, int *boundaries, int y, int x, int y_size, int x_size) {
-    if (front[y * x_size + x] == TILE_DISPLAY::FLAGGED) return;
-    if (front[y * x_size + x] == TILE_DISPLAY::DUG) return;
+/**
+ * @return number of tiles dug
+ */
+static int recursive_dig(TILE_DISPLAY *front, int *boundaries, uint64_t *dirty_rows, int y, int x, int y_size, int x_size) {
+    if (front[y * x_size + x] == TILE_DISPLAY::FLAGGED) return 0;
+    if (front[y * x_size + x] == TILE_DISPLAY::DUG) return 0;
     
     front[y * x_size + x] = TILE_DISPLAY::DUG;
+    dirty_rows[y / 64] |= 1ULL << (y % 64);
 
-    if (boundaries[y * x_size + x] != 0) return;
+    if (boundaries[y * x_size + x] != 0) return 1;
 
-    std::unique_ptr<std::vector<std::pair<int, int>>> neighbors = find_neighbors(y, x, y_size, x_size);
-    for (auto i = neighbors.get()->begin(); i != neighbors.get()->end(); i++) {
-        recursive_dig(front, boundaries, i->first, i->second, y_size, x_size);
+    int dug = 1;
+    std::pair<int, int> neighbors[MAX_NEIGHBORS];
+    int count = find_neighbors(y, x, y_size, x_size, neighbors);
+    for (int i = 0; i < count; i++) {
+        dug += recursive_dig(front, boundaries, dirty_rows, neighbors[i].first, neighbors[i].second, y_size, x_size);
     }
+    return dug;
 }
 
 bool BoardImplementation::dig(int y, int x) noexcept {
@@ -191,15 +425,29 @@ bool BoardImplementation::dig(int y, int x) noexcept {
     
     read_guard.unlock();
     std::unique_lock<std::shared_mutex> write_guard(threadLock);
+
+    // another dig or flag may have taken the tile between the two locks
+    if (front[y * x_size + x] == TILE_DISPLAY::DUG || front[y * x_size + x] == TILE_DISPLAY::FLAGGED) return true;
+
     if (back[y * x_size + x] == TILE_HIDDEN::EMPTY) {
-        recursive_dig(front, boundaries, y, x, y_size, x_size);
+        remaining_safe -= recursive_dig(front, boundaries, dirty_rows.data(), y, x, y_size, x_size);
+        any_dirty = true;
+        changes.fetch_add(1, std::memory_order_release);
         return true;
     }
 
+    // only the dug tile itself can be a bomb, the flood fill stops at numbered tiles
     back[y * x_size + x] = TILE_HIDDEN::BOMB;
-    recursive_dig(front, boundaries, y, x, y_size, x_size);
-    std::unique_ptr<std::vector<std::pair<int, int>>> neighbors = find_neighbors(y, x, y_size, x_size);
-    for (auto i = neighbors.get()->begin(); i != neighbors.get()->end(); i++) boundaries[i->first * x_size + i->second]--;
+    remaining_safe -= recursive_dig(front, boundaries, dirty_rows.data(), y, x, y_size, x_size) - 1;
+    bombs++;
+    std::pair<int, int> neighbors[MAX_NEIGHBORS];
+    int count = find_neighbors(y, x, y_size, x_size, neighbors);
+    for (int i = 0; i < count; i++) {
+        boundaries[neighbors[i].first * x_size + neighbors[i].second]--;
+        mark_dirty(neighbors[i].first);
+    }
+    mark_dirty(y);
+    changes.fetch_add(1, std::memory_order_release);
     return false;
 }
 
@@ -209,6 +457,9 @@ void BoardImplementation::flag(int y, int x) noexcept {
     std::unique_lock<std::shared_mutex> write_lock(threadLock);
     if (front[y * x_size + x] == TILE_DISPLAY::UNTOUCHED) {
         front[y * x_size + x] = TILE_DISPLAY::FLAGGED;
+        flags++;
+        mark_dirty(y);
+        changes.fetch_add(1, std::memory_order_release);
     }
 }
 
@@ -218,9 +469,34 @@ void BoardImplementation::deflag(int y, int x) noexcept {
     std::unique_lock<std::shared_mutex> write_lock(threadLock);
     if (front[y * x_size + x] == TILE_DISPLAY::FLAGGED) {
         front[y * x_size + x] = TILE_DISPLAY::UNTOUCHED;
+        flags--;
+        mark_dirty(y);
+        changes.fetch_add(1, std::memory_order_release);
     }
 }
 
+GAME_STATE BoardImplementation::state() const noexcept {
+    if (bombs.load(std::memory_order_relaxed) > 0) return GAME_STATE::LOST;
+    if (remaining_safe.load(std::memory_order_relaxed) == 0) return GAME_STATE::WON;
+    return GAME_STATE::IN_PROGRESS;
+}
+
+int BoardImplementation::remaining_safe_tiles() const noexcept {
+    return remaining_safe.load(std::memory_order_relaxed);
+}
+
+int BoardImplementation::flag_count() const noexcept {
+    return flags.load(std::memory_order_relaxed);
+}
+
+int BoardImplementation::bombs_hit() const noexcept {
+    return bombs.load(std::memory_order_relaxed);
+}
+
+uint64_t BoardImplementation::version() const noexcept {
+    return changes.load(std::memory_order_acquire);
+}
+
 std::unordered_map<std::string, std::unique_ptr<char []>> BoardImplementation::print_debug() {
     int x_length = x_size + 1;
     int y_length = y_size;
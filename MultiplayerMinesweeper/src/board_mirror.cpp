@@ -0,0 +1,211 @@
+#include "board_mirror.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "snapshot_codec.h"
+
+#define ESCAPE_LEN 32
+#define MAX_BOARD_SIDE 100000
+
+static const char GREETING_FORMAT[] = "Welcome to Minesweeper. Board: %d columns by %d rows.";
+
+static const char SNAPSHOT_FORMAT[] = "SNAPSHOT %d %d %d";
+
+static const char CLEAR_SCREEN[] = "\x1b[2J";
+
+static const char CLEAR_LINE[] = "\x1b[2K";
+
+static inline bool is_tile(char c) {
+    return c == '-' || c == 'F' || c == ' ' || (c >= '1' && c <= '8');
+}
+
+/**
+ * Append the escape sequence moving the cursor to the 0 indexed line and column.
+ */
+static inline void move_cursor(std::string &output, int line, int column) {
+    char buffer[ESCAPE_LEN];
+    int length = snprintf(buffer, ESCAPE_LEN, "\x1b[%d;%dH", line + 1, column + 1);
+    output.append(buffer, length);
+}
+
+BoardMirror::BoardMirror():
+rows_{0}, columns_{0}, frame_row{0}, drawn{false}, tiles{}, dirty{}, dirty_rows{}, pending{},
+snapshot_remaining{0}, snapshot_rows{0}, snapshot_columns{0}, status{}, status_dirty{false} {}
+
+void BoardMirror::receive(const char *data, int length) {
+    int position = 0;
+    while (position < length) {
+        // the encoded board of a snapshot is binary, it is taken by length not by line
+        if (snapshot_remaining > 0) {
+            int taken = length - position < snapshot_remaining ? length - position : snapshot_remaining;
+            pending.append(data + position, taken);
+            position += taken;
+            snapshot_remaining -= taken;
+            if (snapshot_remaining == 0) {
+                apply_snapshot(pending.data(), pending.size());
+                pending.clear();
+            }
+            continue;
+        }
+
+        const char *line_end = (const char *) memchr(data + position, '\n', length - position);
+        if (line_end == nullptr) {
+            pending.append(data + position, length - position);
+            return;
+        }
+        int line_len = line_end - (data + position);
+        if (pending.empty()) {
+            handle_line(data + position, line_len);
+        } else {
+            pending.append(data + position, line_len);
+            std::string line;
+            line.swap(pending);
+            handle_line(line.data(), line.size());
+        }
+        position += line_len + 1;
+    }
+}
+
+void BoardMirror::handle_line(const char *line, int length) {
+    if (length > 0 && line[length - 1] == '\r') length--;
+
+    if (rows_ != 0 && is_board_row(line, length)) {
+        apply_row(line);
+        frame_row = frame_row + 1 == rows_ ? 0 : frame_row + 1;
+        return;
+    }
+
+    // frames end after their last row, a line that is not a row starts over at the first
+    // row of the next frame, an empty line carries nothing and anything else is a message
+    frame_row = 0;
+    if (length == 0) return;
+
+    int x_size;
+    int y_size;
+    int encoded_len;
+    std::string message{line, (size_t) length};
+    if (sscanf(message.c_str(), SNAPSHOT_FORMAT, &x_size, &y_size, &encoded_len) == 3 && encoded_len >= 0) {
+        snapshot_rows = y_size;
+        snapshot_columns = x_size;
+        snapshot_remaining = encoded_len;
+        if (encoded_len == 0) apply_snapshot("", 0);
+        return;
+    }
+    if (rows_ == 0 && sscanf(message.c_str(), GREETING_FORMAT, &x_size, &y_size) == 2
+        && x_size > 0 && y_size > 0 && x_size <= MAX_BOARD_SIDE && y_size <= MAX_BOARD_SIDE) {
+        rows_ = y_size;
+        columns_ = x_size;
+        tiles.assign(rows_ * columns_, '-');
+        dirty.assign(rows_ * columns_, false);
+        dirty_rows.assign(rows_, false);
+    }
+
+    // before the board is known messages are printed one after another
+    if (rows_ == 0 || !drawn) {
+        status.append(message);
+        status.push_back('\n');
+    } else {
+        status = message;
+    }
+    status_dirty = true;
+}
+
+bool BoardMirror::is_board_row(const char *line, int length) const noexcept {
+    if (length != columns_) return false;
+    for (int i = 0; i < length; i++) {
+        if (!is_tile(line[i])) return false;
+    }
+    return true;
+}
+
+void BoardMirror::apply_snapshot(const char *data, int length) {
+    // a snapshot of another board is dropped
+    if (snapshot_rows != rows_ || snapshot_columns != columns_) return;
+
+    std::vector<char> view((size_t) rows_ * (columns_ + 1));
+    if (!SnapshotCodec::decode(data, length, rows_, columns_, view.data())) return;
+    for (frame_row = 0; frame_row < rows_; frame_row++) apply_row(view.data() + (size_t) frame_row * (columns_ + 1));
+    frame_row = 0;
+}
+
+void BoardMirror::apply_row(const char *line) {
+    char *row = tiles.data() + frame_row * columns_;
+    for (int j = 0; j < columns_; j++) {
+        if (row[j] == line[j]) continue;
+        row[j] = line[j];
+        dirty[frame_row * columns_ + j] = true;
+        dirty_rows[frame_row] = true;
+    }
+}
+
+void BoardMirror::render(std::string &output) {
+    if (rows_ == 0) {
+        output.append(status);
+        status.clear();
+        status_dirty = false;
+        return;
+    }
+
+    bool changed = status_dirty;
+    if (!drawn) {
+        // the greeting and anything before it go below the board on the first draw
+        output.append(CLEAR_SCREEN);
+        for (int i = 0; i < rows_; i++) {
+            move_cursor(output, i, 0);
+            output.append(tiles.data() + i * columns_, columns_);
+            dirty_rows[i] = false;
+        }
+        dirty.assign(dirty.size(), false);
+        if (!status.empty() && status.back() == '\n') status.pop_back();
+        size_t last_line = status.rfind('\n');
+        if (last_line != std::string::npos) status.erase(0, last_line + 1);
+        drawn = true;
+        changed = true;
+        status_dirty = true;
+    }
+
+    // consecutive changed tiles of a row share a single cursor move
+    for (int i = 0; i < rows_; i++) {
+        if (!dirty_rows[i]) continue;
+        dirty_rows[i] = false;
+        changed = true;
+        int j = 0;
+        while (j < columns_) {
+            if (!dirty[i * columns_ + j]) {
+                j++;
+                continue;
+            }
+            int run_start = j;
+            while (j < columns_ && dirty[i * columns_ + j]) dirty[i * columns_ + j++] = false;
+            move_cursor(output, i, run_start);
+            output.append(tiles.data() + i * columns_ + run_start, j - run_start);
+        }
+    }
+
+    if (status_dirty) {
+        move_cursor(output, rows_ + 1, 0);
+        output.append(CLEAR_LINE);
+        output.append(status);
+        status_dirty = false;
+    }
+
+    // leave the cursor on an empty prompt line below the status
+    if (changed) {
+        move_cursor(output, rows_ + 2, 0);
+        output.append(CLEAR_LINE);
+    }
+}
+
+int BoardMirror::rows() const noexcept {
+    return rows_;
+}
+
+int BoardMirror::columns() const noexcept {
+    return columns_;
+}
+
+char BoardMirror::tile(int y, int x) const noexcept {
+    if (y < 0 || x < 0 || y >= rows_ || x >= columns_) return '-';
+    return tiles[y * columns_ + x];
+}
@@ -0,0 +1,272 @@
+#include "board_solver.h"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#define MAX_NEIGHBORS 8
+
+static inline bool is_untouched(char tile) {
+    return tile == '-' || tile == 'F';
+}
+
+static inline int tile_number(char tile) {
+    return tile == ' ' ? 0 : tile - '0';
+}
+
+BoardSolver::BoardSolver(int y_size, int x_size):
+y_size{y_size}, x_size{x_size}, view{}, buffer{}, knowledge_{}, queued{}, worklist{}, flood{}, safe_tiles{}, threadLock{} {
+    if (y_size < 1) throw std::domain_error("y_size must be positive.");
+    if (x_size < 1) throw std::domain_error("x_size must be positive.");
+
+    int size = y_size * x_size;
+    view.assign(y_size * (x_size + 1), '-');
+    for (int i = 0; i < y_size; i++) view[(i + 1) * (x_size + 1) - 1] = '\n';
+    knowledge_.assign(size, TILE_KNOWLEDGE::UNKNOWN);
+    queued.assign(size, false);
+}
+
+BoardSolver::BoardSolver(Board *board):
+BoardSolver(board->rows(), board->columns()) {}
+
+static inline int find_neighbors(int tile, int y_size, int x_size, int *output) {
+    int y = tile / x_size;
+    int x = tile % x_size;
+    int count = 0;
+    for (int row = y - 1; row <= y + 1; row++) {
+        for (int col = x - 1; col <= x + 1; col++) {
+            if (row < 0 || col < 0 || row >= y_size || col >= x_size || (row == y && col == x)) continue;
+            output[count++] = row * x_size + col;
+        }
+    }
+    return count;
+}
+
+void BoardSolver::update(const char *new_view) {
+    std::lock_guard<std::mutex> lock(threadLock);
+    apply_view(new_view);
+    solve();
+}
+
+void BoardSolver::update(Board *board) {
+    std::lock_guard<std::mutex> lock(threadLock);
+    buffer.resize(board->print_length());
+    if (board->print(buffer.data(), buffer.size()) < 0) throw std::domain_error("board size does not match the solver.");
+    apply_view(buffer.data());
+    solve();
+}
+
+void BoardSolver::apply_view(const char *new_view) {
+    int x_length = x_size + 1;
+    for (int i = 0; i < y_size; i++) {
+        const char *new_row = new_view + i * x_length;
+        char *row = view.data() + i * x_length;
+        if (memcmp(row, new_row, x_size) == 0) continue;
+
+        for (int j = 0; j < x_size; j++) {
+            if (row[j] == new_row[j]) continue;
+            row[j] = new_row[j];
+
+            // flags are player's guesses, only newly dug tiles carry information
+            if (is_untouched(new_row[j])) continue;
+            uncover(i * x_size + j, new_row[j]);
+        }
+    }
+}
+
+void BoardSolver::dug(Board *board, int y, int x) {
+    if (y < 0 || x < 0 || y >= y_size || x >= x_size) return;
+
+    // the shared rendering of the board, reading it copies nothing
+    std::shared_ptr<const char[]> shown = board->print();
+    std::lock_guard<std::mutex> lock(threadLock);
+
+    int x_length = x_size + 1;
+    flood.push_back(y * x_size + x);
+    while (!flood.empty()) {
+        int tile = flood.back();
+        flood.pop_back();
+        char tile_shown = shown[(tile / x_size) * x_length + tile % x_size];
+
+        // a tile already seen dug was flooded from by whoever saw it first
+        if (view[(tile / x_size) * x_length + tile % x_size] == tile_shown || is_untouched(tile_shown)) continue;
+        uncover(tile, tile_shown);
+        if (tile_number(tile_shown) != 0) continue;
+
+        int neighbors[MAX_NEIGHBORS];
+        int count = find_neighbors(tile, y_size, x_size, neighbors);
+        flood.insert(flood.end(), neighbors, neighbors + count);
+    }
+    solve();
+}
+
+void BoardSolver::marked(Board *board, int y, int x) {
+    if (y < 0 || x < 0 || y >= y_size || x >= x_size) return;
+    std::shared_ptr<const char[]> shown = board->print();
+    std::lock_guard<std::mutex> lock(threadLock);
+
+    int position = y * (x_size + 1) + x;
+    if (is_untouched(shown[position])) view[position] = shown[position];
+}
+
+void BoardSolver::uncover(int tile, char shown) {
+    view[(tile / x_size) * (x_size + 1) + tile % x_size] = shown;
+    knowledge_[tile] = TILE_KNOWLEDGE::SAFE;
+    if (!queued[tile]) {
+        queued[tile] = true;
+        worklist.push_back(tile);
+    }
+    enqueue_constraints_around(tile);
+}
+
+void BoardSolver::enqueue_constraints_around(int tile) {
+    int neighbors[MAX_NEIGHBORS];
+    int count = find_neighbors(tile, y_size, x_size, neighbors);
+    for (int i = 0; i < count; i++) {
+        int neighbor = neighbors[i];
+        char shown = view[(neighbor / x_size) * (x_size + 1) + neighbor % x_size];
+        if (is_untouched(shown) || tile_number(shown) == 0 || queued[neighbor]) continue;
+        queued[neighbor] = true;
+        worklist.push_back(neighbor);
+    }
+}
+
+void BoardSolver::deduce(int tile, TILE_KNOWLEDGE value) {
+    if (knowledge_[tile] != TILE_KNOWLEDGE::UNKNOWN) return;
+    knowledge_[tile] = value;
+    if (value == TILE_KNOWLEDGE::SAFE) safe_tiles.push_back(tile);
+    enqueue_constraints_around(tile);
+}
+
+int BoardSolver::collect_unknowns(int tile, int *unknowns, int &mines) {
+    int neighbors[MAX_NEIGHBORS];
+    int count = find_neighbors(tile, y_size, x_size, neighbors);
+    int unknown_count = 0;
+    mines = 0;
+    for (int i = 0; i < count; i++) {
+        if (knowledge_[neighbors[i]] == TILE_KNOWLEDGE::MINE) mines++;
+        else if (knowledge_[neighbors[i]] == TILE_KNOWLEDGE::UNKNOWN) unknowns[unknown_count++] = neighbors[i];
+    }
+    return unknown_count;
+}
+
+static inline bool contains(const int *tiles, int count, int tile) {
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] == tile) return true;
+    }
+    return false;
+}
+
+void BoardSolver::solve() {
+    while (!worklist.empty()) {
+        int tile = worklist.back();
+        worklist.pop_back();
+        queued[tile] = false;
+
+        char shown = view[(tile / x_size) * (x_size + 1) + tile % x_size];
+        if (is_untouched(shown)) continue;
+
+        int unknowns[MAX_NEIGHBORS];
+        int mines;
+        int unknown_count = collect_unknowns(tile, unknowns, mines);
+        if (unknown_count == 0) continue;
+        int remaining = tile_number(shown) - mines;
+
+        // single constraint: every unknown neighbor is safe or every one is a mine
+        if (remaining == 0 || remaining == unknown_count) {
+            TILE_KNOWLEDGE value = remaining == 0 ? TILE_KNOWLEDGE::SAFE : TILE_KNOWLEDGE::MINE;
+            for (int i = 0; i < unknown_count; i++) deduce(unknowns[i], value);
+            continue;
+        }
+
+        // pairs of constraints: when one unknown set contains the other, the difference
+        // holds exactly the difference of the remaining mines
+        int y = tile / x_size;
+        int x = tile % x_size;
+        for (int row = y - 2; row <= y + 2; row++) {
+            for (int col = x - 2; col <= x + 2; col++) {
+                if (row < 0 || col < 0 || row >= y_size || col >= x_size || (row == y && col == x)) continue;
+                char other_shown = view[row * (x_size + 1) + col];
+                if (is_untouched(other_shown)) continue;
+
+                int other = row * x_size + col;
+                int other_unknowns[MAX_NEIGHBORS];
+                int other_mines;
+                int other_count = collect_unknowns(other, other_unknowns, other_mines);
+                int other_remaining = tile_number(other_shown) - other_mines;
+
+                const int *small = unknowns;
+                int small_count = unknown_count;
+                int small_remaining = remaining;
+                const int *large = other_unknowns;
+                int large_count = other_count;
+                int large_remaining = other_remaining;
+                if (other_count < unknown_count) {
+                    std::swap(small, large);
+                    std::swap(small_count, large_count);
+                    std::swap(small_remaining, large_remaining);
+                }
+                if (small_count == large_count) continue;
+
+                bool subset = true;
+                for (int i = 0; i < small_count && subset; i++) subset = contains(large, large_count, small[i]);
+                if (!subset) continue;
+
+                int difference_remaining = large_remaining - small_remaining;
+                if (difference_remaining != 0 && difference_remaining != large_count - small_count) continue;
+                TILE_KNOWLEDGE value = difference_remaining == 0 ? TILE_KNOWLEDGE::SAFE : TILE_KNOWLEDGE::MINE;
+                for (int i = 0; i < large_count; i++) {
+                    if (!contains(small, small_count, large[i])) deduce(large[i], value);
+                }
+            }
+        }
+    }
+}
+
+bool BoardSolver::hint(int &y, int &x) {
+    std::lock_guard<std::mutex> lock(threadLock);
+
+    for (size_t i = safe_tiles.size(); i-- > 0;) {
+        int tile = safe_tiles[i];
+        char shown = view[(tile / x_size) * (x_size + 1) + tile % x_size];
+        if (shown == '-') {
+            y = tile / x_size;
+            x = tile % x_size;
+            return true;
+        }
+        // dug tiles are done with, flagged ones are offered again once deflagged
+        if (shown == 'F') continue;
+        safe_tiles[i] = safe_tiles.back();
+        safe_tiles.pop_back();
+    }
+    return false;
+}
+
+TILE_KNOWLEDGE BoardSolver::knowledge(int y, int x) {
+    std::lock_guard<std::mutex> lock(threadLock);
+    if (y < 0 || x < 0 || y >= y_size || x >= x_size) return TILE_KNOWLEDGE::UNKNOWN;
+    return knowledge_[y * x_size + x];
+}
+
+bool BoardSolver::is_no_guess(Board *board, int y, int x) {
+    BoardSolver solver{board};
+    int y_size = solver.y_size;
+    int x_size = solver.x_size;
+    std::vector<char> shown(board->print_length());
+
+    if (!board->dig(y, x)) return false;
+    solver.update(board);
+    while (solver.hint(y, x)) {
+        if (!board->dig(y, x)) return false;
+        solver.dug(board, y, x);
+    }
+
+    // solved when every untouched tile is a known mine
+    board->print(shown.data(), shown.size());
+    for (int tile = 0; tile < y_size * x_size; tile++) {
+        char tile_shown = shown[(tile / x_size) * (x_size + 1) + tile % x_size];
+        if (is_untouched(tile_shown) && solver.knowledge_[tile] != TILE_KNOWLEDGE::MINE) return false;
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+#include "client_session.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "protocol.h"
+
+#define RECEIVE_BUFFER_LEN 1024
+#define ARENA_BLOCK_LEN 16384
+
+static inline bool uses_board(Protocol::COMMAND command) {
+    return command == Protocol::COMMAND::LOOK
+        || command == Protocol::COMMAND::DIG
+        || command == Protocol::COMMAND::FLAG
+        || command == Protocol::COMMAND::DEFLAG
+        || command == Protocol::COMMAND::HINT
+        || command == Protocol::COMMAND::SNAPSHOT;
+}
+
+static inline bool take_tokens(TokenBucket& client_bucket, TokenBucket& room_bucket) noexcept {
+    if (!client_bucket.try_acquire()) return false;
+    if (room_bucket.try_acquire()) return true;
+
+    // a client refused by the room keeps its token
+    client_bucket.give_back();
+    return false;
+}
+
+ClientSession::ClientSession(const Room& room, Writer write, double rate, int burst):
+room{room}, write{std::move(write)}, client_bucket{rate, burst}, connection_arena{RECEIVE_BUFFER_LEN},
+iteration_arena{ARENA_BLOCK_LEN}, pending{nullptr}, pending_len{0}, discarding{false}, open{true}, watching{false} {
+    pending = connection_arena.allocate_array<char>(RECEIVE_BUFFER_LEN);
+}
+
+bool ClientSession::greet() {
+    // clients need the board size to split the stream into frames
+    iteration_arena.reset();
+    Protocol::Frame greeting = Protocol::greet(room.board, iteration_arena);
+    if (!write(greeting.data, greeting.length)) open = false;
+    return open;
+}
+
+char *ClientSession::receive_buffer() noexcept {
+    return pending + pending_len;
+}
+
+int ClientSession::receive_capacity() const noexcept {
+    return RECEIVE_BUFFER_LEN - pending_len;
+}
+
+void ClientSession::received(int length) {
+    iteration_arena.reset();
+    pending_len += length;
+
+    // handle every complete line, keep the trailing partial line for the next read
+    int line_start = 0;
+    for (int i = 0; i < pending_len && open && !watching; i++) {
+        if (pending[i] != '\n') continue;
+        if (!discarding) execute(pending + line_start, i - line_start);
+        discarding = false;
+        line_start = i + 1;
+    }
+
+    // a line filling the whole buffer is discarded up to its '\n', never parsed in pieces
+    if (discarding || (line_start == 0 && pending_len == RECEIVE_BUFFER_LEN)) {
+        discarding = true;
+        pending_len = 0;
+        return;
+    }
+    memmove(pending, pending + line_start, pending_len - line_start);
+    pending_len -= line_start;
+}
+
+void ClientSession::execute(const char *line, int length) {
+    Protocol::Request request = Protocol::parse(line, length);
+
+    // requests touching the board pay a token of the client then of the room
+    if (uses_board(request.command) && !take_tokens(client_bucket, *room.bucket)) {
+        room.throttled->fetch_add(1, std::memory_order_relaxed);
+        Protocol::Frame frame = Protocol::throttled();
+        if (!write(frame.data, frame.length)) open = false;
+        return;
+    }
+
+    // joining clients share one encoded snapshot per board version
+    if (request.command == Protocol::COMMAND::SNAPSHOT) {
+        std::shared_ptr<const std::string> snapshot = room.snapshots->get();
+        if (!write(snapshot->data(), snapshot->size())) open = false;
+        return;
+    }
+
+    Protocol::Frame frame = Protocol::respond(room.board, request, iteration_arena, room.solver);
+    if (frame.length > 0 && !write(frame.data, frame.length)) open = false;
+    if (frame.close_connection) open = false;
+
+    if (request.command == Protocol::COMMAND::DIG
+        || request.command == Protocol::COMMAND::FLAG
+        || request.command == Protocol::COMMAND::DEFLAG) room.feed->mark_dirty();
+
+    // only a dig can end the game, the connection making it tells every other one
+    if (request.command == Protocol::COMMAND::DIG && room.board->state() != GAME_STATE::IN_PROGRESS) room.game_over->raise();
+    if (request.command == Protocol::COMMAND::SPECTATE) watching = true;
+}
+
+bool ClientSession::connected() const noexcept {
+    return open;
+}
+
+bool ClientSession::spectator() const noexcept {
+    return watching;
+}
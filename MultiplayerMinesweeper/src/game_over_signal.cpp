@@ -0,0 +1,30 @@
+#include "game_over_signal.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+GameOverSignal::GameOverSignal():
+event{-1}, is_raised{false} {
+    event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event < 0) throw std::runtime_error("Creating the game over eventfd failed");
+}
+
+GameOverSignal::~GameOverSignal() {
+    close(event);
+}
+
+void GameOverSignal::raise() noexcept {
+    if (is_raised.exchange(true)) return;
+    uint64_t one = 1;
+    if (write(event, &one, sizeof(one)) != sizeof(one)) return;
+}
+
+bool GameOverSignal::raised() const noexcept {
+    return is_raised.load();
+}
+
+int GameOverSignal::fd() const noexcept {
+    return event;
+}
@@ -0,0 +1,117 @@
+#include "handoff.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define MAX_STATE_LEN (1L << 31)
+
+static sockaddr_un unix_address(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) throw std::runtime_error("handoff path is too long");
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+int Handoff::listen(const std::string& path) {
+    sockaddr_un address = unix_address(path);
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd < 0) throw std::runtime_error("handoff socket creation failed");
+
+    unlink(path.c_str());
+    if (bind(socket_fd, (sockaddr*) &address, sizeof(address)) < 0 || ::listen(socket_fd, 1) < 0) {
+        close(socket_fd);
+        throw std::runtime_error("handoff socket bind failed");
+    }
+    return socket_fd;
+}
+
+int Handoff::connect(const std::string& path) {
+    sockaddr_un address = unix_address(path);
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd < 0) return -1;
+
+    if (::connect(socket_fd, (sockaddr*) &address, sizeof(address)) != 0) {
+        close(socket_fd);
+        return -1;
+    }
+    return socket_fd;
+}
+
+void Handoff::send(int socket, const std::vector<int>& fds, const std::string& state) {
+    if (fds.size() > MAX_FDS) throw std::runtime_error("too many descriptors to hand off");
+
+    uint64_t state_len = state.size();
+    iovec header{&state_len, sizeof(state_len)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)] = {};
+
+    msghdr message{};
+    message.msg_iov = &header;
+    message.msg_iovlen = 1;
+    if (!fds.empty()) {
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        cmsghdr *rights = CMSG_FIRSTHDR(&message);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(rights), fds.data(), sizeof(int) * fds.size());
+    }
+    if (sendmsg(socket, &message, MSG_NOSIGNAL) != sizeof(state_len)) throw std::runtime_error("handoff send failed");
+
+    size_t sent = 0;
+    while (sent < state.size()) {
+        ssize_t length = ::send(socket, state.data() + sent, state.size() - sent, MSG_NOSIGNAL);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) throw std::runtime_error("handoff send failed");
+        sent += length;
+    }
+}
+
+std::vector<int> Handoff::receive(int socket, std::string& state) {
+    uint64_t state_len = 0;
+    iovec header{&state_len, sizeof(state_len)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)] = {};
+
+    msghdr message{};
+    message.msg_iov = &header;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t length = recvmsg(socket, &message, MSG_CMSG_CLOEXEC | MSG_WAITALL);
+
+    std::vector<int> fds;
+    for (cmsghdr *rights = CMSG_FIRSTHDR(&message); rights != nullptr; rights = CMSG_NXTHDR(&message, rights)) {
+        if (rights->cmsg_level != SOL_SOCKET || rights->cmsg_type != SCM_RIGHTS) continue;
+        int count = (rights->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (int i = 0; i < count; i++) {
+            int fd;
+            memcpy(&fd, CMSG_DATA(rights) + i * sizeof(int), sizeof(int));
+            fds.push_back(fd);
+        }
+    }
+
+    // never leak the received descriptors when the message is unusable
+    auto fail = [&fds](const char *reason) {
+        for (int fd: fds) close(fd);
+        throw std::runtime_error(reason);
+    };
+    if (length != sizeof(state_len)) fail("handoff receive failed");
+    if (message.msg_flags & MSG_CTRUNC) fail("too many descriptors handed off");
+    if (state_len > MAX_STATE_LEN) fail("handoff state is too long");
+
+    state.resize(state_len);
+    size_t received = 0;
+    while (received < state.size()) {
+        length = recv(socket, &state[received], state.size() - received, 0);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) fail("handoff receive failed");
+        received += length;
+    }
+    return fds;
+}
@@ -1,14 +1,22 @@
 #include "minesweeper_client.h"
 
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <openssl/err.h>
 #include <poll.h>
+#include <string>
 #include <unistd.h>
 
+#include "board_mirror.h"
 #include "util.h"
 
 #define PORT 9023
-#define BUFFER_LEN 1024
+#define BUFFER_LEN 4096
+
+static const char BYE_MESSAGE[] = "bye\n";
+
+static const char SNAPSHOT_MESSAGE[] = "snapshot\n";
 
 struct MinesweeperClient::Private {
     bool running;
@@ -50,43 +58,77 @@ void MinesweeperClient::connect() {
         ERR_print_errors_fp(stderr);
         throw std::runtime_error("SSL connection to server failed");
     }
+    impl->running = true;
+
+    // the mirror starts from a compressed snapshot instead of a printed board
+    if (SSL_write(ssl, SNAPSHOT_MESSAGE, sizeof(SNAPSHOT_MESSAGE) - 1) <= 0) {
+        throw std::runtime_error("Requesting the board failed");
+    }
+
+    BoardMirror mirror;
+    std::string screen;
     char buffer[BUFFER_LEN];
-    memset(buffer, 0, BUFFER_LEN);
-    
-    while (true) {
+
+    while (impl->running) {
         struct pollfd pfd[2];
         struct pollfd *stdin_pfd = pfd;
         struct pollfd *socket_pfd = (pfd + 1);
         stdin_pfd->fd = 0;
         stdin_pfd->events = POLLIN;
+        stdin_pfd->revents = 0;
         socket_pfd->fd = impl->socket;
-        socket_pfd->events = 0;
-
-        if (poll(pfd, 2, 1000) == 0) {
-            write(impl->socket, buffer, 0);
-            continue;
-        }
+        socket_pfd->events = POLLIN;
+        socket_pfd->revents = 0;
 
-        // other end of stream socket is closed
-        if (socket_pfd->revents & (POLLERR | POLLHUP)) {
-            std::cout << "Server closed connection!\n";
+        // sleep until the user types or the server sends something, records already
+        // decrypted by OpenSSL are invisible to poll
+        if (SSL_pending(ssl) == 0 && poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) continue;
             break;
         }
 
-        int read_len = read(0, buffer, BUFFER_LEN);
+        if (SSL_pending(ssl) > 0 || (socket_pfd->revents & (POLLIN | POLLERR | POLLHUP))) {
+            bool closed = false;
+            do {
+                int read_len = SSL_read(ssl, buffer, BUFFER_LEN);
+                if (read_len <= 0) {
+                    int error = SSL_get_error(ssl, read_len);
+                    closed = error != SSL_ERROR_WANT_READ && error != SSL_ERROR_WANT_WRITE;
+                    break;
+                }
+                mirror.receive(buffer, read_len);
+            } while (SSL_pending(ssl) > 0);
+
+            screen.clear();
+            mirror.render(screen);
+            std::cout << screen << std::flush;
+
+            if (closed) {
+                std::cout << "Server closed connection!\n";
+                break;
+            }
+        }
 
-        int write_len = SSL_write(ssl, buffer, read_len);
+        if (!(stdin_pfd->revents & (POLLIN | POLLHUP))) continue;
 
-        if (write_len <= 0) {
-            std::cout << "Send message failed\n";
+        int read_len = read(0, buffer, BUFFER_LEN);
+        bool leaving = read_len <= 0
+            || (read_len >= 10 && strncmp("disconnect", buffer, 10) == 0);
+        if (leaving) {
+            SSL_write(ssl, BYE_MESSAGE, sizeof(BYE_MESSAGE) - 1);
+            std::cout << "Disconnecting...\n";
             break;
         }
-        
-        if (strcmp("disconnect\n", buffer) == 0) {
-            std::cout << "Disconnecting...\n";
+
+        if (SSL_write(ssl, buffer, read_len) <= 0) {
+            std::cout << "Send message failed\n";
             break;
         }
     }
+
+    impl->running = false;
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
 }
 
 int main() {
@@ -1,55 +1,161 @@
 #include "minesweeper_server.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <mutex>
 #include <netinet/in.h>
 #include <openssl/err.h>
 #include <poll.h>
+#include <stdexcept>
+#include <string>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <thread>
+#include <vector>
 
+#include "board_solver.h"
+#include "client_session.h"
+#include "game_over_signal.h"
+#include "handoff.h"
+#include "protocol.h"
+#include "rate_limiter.h"
+#include "snapshot_cache.h"
+#include "spectator_feed.h"
 #include "util.h"
 
 #define PORT 9023
 #define BUFFER_LEN 1024
+#define BOARD_SIZE 10
+#define BOMB_COUNT 10
+#define SPECTATOR_FPS 10
+#define CLIENT_RATE 20
+#define CLIENT_BURST 40
+#define ROOM_RATE 2000
+#define ROOM_BURST 4000
+#define LAG_SAMPLE_MS 100
+#define MAX_LAG_MS 50
 
 struct MinesweeperServer::Private {
     bool running;
     int port;
     int socket;
     SSL_CTX *ctx;
+    Board *board;
+    BoardSolver *solver;
+    SpectatorFeed feed;
+    SnapshotCache snapshots;
+    Topology::Placement placement;
 
+    TokenBucket room_bucket;
+    AdmissionControl admission;
+    std::atomic<uint64_t> throttled;
+    GameOverSignal game_over;
+
+    std::atomic<bool> accepting;
+    std::thread acceptor;
     std::unordered_map<int, std::thread*> client_threads;
     std::mutex client_mutex;
 
-    Private(int port);
+    Private(int port, Board *board, const Topology::Placement& placement);
     ~Private();
 
+    void quiesce();
     void accept_clients();
     void handle_client(int client_socket);
+    void watch_board(SSL *ssl, int client_socket, bool announced);
 };
 
-MinesweeperServer::Private::Private(int port):
-running{false}, port{port}, socket{-1}, ctx{nullptr}, client_threads{}, client_mutex{} {}
+MinesweeperServer::Private::Private(int port, Board *board, const Topology::Placement& placement):
+running{false}, port{port}, socket{-1}, ctx{nullptr}, board{board}, solver{new BoardSolver(board)}, feed{board, SPECTATOR_FPS}, snapshots{board}, placement{placement},
+room_bucket{ROOM_RATE, ROOM_BURST}, admission{MAX_LAG_MS * 1000000LL}, throttled{0}, game_over{}, accepting{false}, acceptor{}, client_threads{}, client_mutex{} {
+    // a board taken over from a predecessor may already be dug, later digs are fed one by one
+    solver->update(board);
+    if (board->state() != GAME_STATE::IN_PROGRESS) game_over.raise();
+}
 
 MinesweeperServer::MinesweeperServer(int port):
-impl(new Private{port}) {}
+MinesweeperServer(port, new BoardImplementation(BOARD_SIZE, BOARD_SIZE, BOMB_COUNT)) {}
+
+MinesweeperServer::MinesweeperServer(int port, Board *board):
+MinesweeperServer(port, board, Topology::Placement{{}, {}, -1}) {}
+
+MinesweeperServer::MinesweeperServer(int port, Board *board, const Topology::Placement& placement):
+impl(new Private{port, board, placement}) {}
+
+MinesweeperServer::MinesweeperServer(const std::string& handoff_path, const Topology::Placement& placement):
+impl{nullptr} {
+    int predecessor = Handoff::connect(handoff_path);
+    if (predecessor < 0) throw std::runtime_error("No server to take over from");
+
+    std::string snapshot;
+    std::vector<int> fds;
+    try {
+        fds = Handoff::receive(predecessor, snapshot);
+    } catch (std::runtime_error& error) {
+        close(predecessor);
+        throw;
+    }
+    close(predecessor);
+
+    Board *board = nullptr;
+    try {
+        if (fds.size() != 1) throw std::runtime_error("Expected exactly the listening socket to be handed off");
+        board = new BoardImplementation(BoardImplementation::deserialize(snapshot));
+    } catch (std::exception& error) {
+        for (int fd: fds) close(fd);
+        throw std::runtime_error(std::string{"Taking over failed: "} + error.what());
+    }
+
+    impl = new Private{-1, board, placement};
+    impl->socket = fds[0];
+}
                                                                                         
 void MinesweeperServer::start() {
-    impl->socket = Util::create_server_socket(impl->port);
+    // a server that took over already has its predecessor's listening socket
+    if (impl->socket == -1) impl->socket = Util::create_server_socket(impl->port);
     impl->ctx = Util::create_context(true);
     Util::configure_server_context(impl->ctx);
+
+    std::cout << Topology::describe(impl->placement);
+    if (!impl->board->place_on_node(impl->placement.board_node)) {
+        std::cerr << "Binding the board to node " << impl->placement.board_node << " failed\n";
+    }
+
     impl->running = true;
-    std::thread(&Private::accept_clients, impl).detach();
+    impl->accepting = true;
+    impl->feed.start();
+    impl->acceptor = std::thread(&Private::accept_clients, impl);
 }
 
 void MinesweeperServer::Private::accept_clients() {
+    if (!Topology::pin_current_thread(placement.accept_cpus)) std::cerr << "Pinning the accept thread failed\n";
+
     sockaddr_in clientAddress;
     socklen_t clilen = sizeof(clientAddress);
 
-    while (running) {
+    // the loop is due back at every sample deadline, how late it comes back is the server's lag,
+    // whether it slept through the deadline or was busy accepting
+    std::chrono::steady_clock::time_point next_sample = std::chrono::steady_clock::now() + std::chrono::milliseconds(LAG_SAMPLE_MS);
+
+    while (running && accepting) {
+        // wake up regularly, a handoff stops accepting without closing the socket
+        struct pollfd pfd{};
+        pfd.fd = socket;
+        pfd.events = POLLIN;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        int timeout_ms = next_sample > now ? std::chrono::ceil<std::chrono::milliseconds>(next_sample - now).count() : 0;
+        int ready = poll(&pfd, 1, timeout_ms);
+
+        now = std::chrono::steady_clock::now();
+        if (now >= next_sample) {
+            admission.record_lag(std::chrono::nanoseconds(now - next_sample).count());
+            next_sample = now + std::chrono::milliseconds(LAG_SAMPLE_MS);
+        }
+        if (ready <= 0) continue;
+        if (pfd.revents & POLLNVAL) break;
+
         int client_socket = accept(
             socket,
             (struct sockaddr*) &clientAddress,
@@ -62,6 +168,12 @@ void MinesweeperServer::Private::accept_clients() {
             continue;
         }
 
+        // shed before the handshake, the most expensive part of a new connection
+        if (!admission.admit()) {
+            close(client_socket);
+            continue;
+        }
+
         // Util::set_non_blocking(client_socket);
 
         std::cout << "New client connected!\n";
@@ -82,6 +194,9 @@ void MinesweeperServer::Private::accept_clients() {
 }
 
 void MinesweeperServer::Private::handle_client(int client_socket) {
+    // pinned before anything is allocated, so the connection's buffers are first touched on its node
+    if (!Topology::pin_current_thread(placement.worker_cpus)) std::cerr << "Pinning a client thread failed\n";
+
     SSL *ssl = SSL_new(ctx);
 
     if (!SSL_set_fd(ssl, client_socket)) {
@@ -97,66 +212,169 @@ void MinesweeperServer::Private::handle_client(int client_socket) {
         return;
     }
 
-    // const char welcomeMsg[] = "Welcome to the Minesweeper Server!\n";
-    // SSL_write(ssl, welcomeMsg, strlen(welcomeMsg));
+    ClientSession session{
+        ClientSession::Room{board, solver, &snapshots, &feed, &room_bucket, &throttled, &game_over},
+        [ssl](const char *data, int length) { return SSL_write(ssl, data, length) > 0; },
+        CLIENT_RATE,
+        CLIENT_BURST
+    };
+    if (!session.greet()) {
+        SSL_free(ssl);
+        close(client_socket);
+        return;
+    }
+    bool announced = false;
 
-    while (running) {
-        struct pollfd pfd{};
-        pfd.fd = client_socket;
-        pfd.events = POLLIN;
+    while (running && session.connected() && !session.spectator()) {
+        // the game over signal wakes every connection up as soon as a dig ends the game
+        struct pollfd pfds[2]{};
+        pfds[0].fd = client_socket;
+        pfds[0].events = POLLIN;
+        pfds[1].fd = game_over.fd();
+        pfds[1].events = POLLIN;
 
         // no events or error
-        if (poll(&pfd, 1, 1000) == 0) continue;
+        if (SSL_pending(ssl) == 0 && poll(pfds, announced ? 1 : 2, 1000) == 0) continue;
+
+        if (pfds[1].revents & POLLIN) {
+            Protocol::Frame announcement = Protocol::announce(board);
+            if (SSL_write(ssl, announcement.data, announcement.length) <= 0) break;
+            announced = true;
+            if (SSL_pending(ssl) == 0 && pfds[0].revents == 0) continue;
+        }
+
+        struct pollfd& pfd = pfds[0];
         
         // the server side stream socket is closed
         if (pfd.revents & POLLNVAL) {
             SSL_free(ssl);
-            break;
+            return;
         }
         
         // other end of stream socket is closed
         if (pfd.revents & (POLLERR | POLLHUP)) {
             std::cout << "Client closed connection!\n";
-            SSL_free(ssl);
-            close(client_socket);
             break;
         }
 
         // there is data to read
-        char buffer[BUFFER_LEN] {};
-        int read_len{0};
-        read_len = SSL_read(ssl, buffer, BUFFER_LEN);
-        buffer[read_len] = '\0';
-        write(1, buffer, read_len);
+        int read_len = SSL_read(ssl, session.receive_buffer(), session.receive_capacity());
+        if (read_len <= 0) {
+            int error = SSL_get_error(ssl, read_len);
+            if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) continue;
+            std::cout << "Client closed connection!\n";
+            break;
+        }
+        session.received(read_len);
     }
+
+    if (session.spectator() && session.connected()) watch_board(ssl, client_socket, announced);
+
+    // on shutdown the client socket is closed by stop()
+    if (running) SSL_shutdown(ssl);
+    SSL_free(ssl);
+    if (running) close(client_socket);
     return;
 }
 
-void MinesweeperServer::stop() {
-    impl -> running = false;
+void MinesweeperServer::Private::watch_board(SSL *ssl, int client_socket, bool announced) {
+    uint64_t sequence = 0;
+    char buffer[BUFFER_LEN];
+
+    while (running) {
+        // frames are shared by every spectator, sending one never touches the board
+        std::shared_ptr<const std::string> frame = feed.wait_frame(sequence, 1000);
+        if (frame != nullptr && SSL_write(ssl, frame->data(), frame->size()) <= 0) return;
+
+        // the game over signal is polled with the socket, it is raised once for every connection
+        struct pollfd pfds[2]{};
+        pfds[0].fd = client_socket;
+        pfds[0].events = POLLIN;
+        pfds[1].fd = game_over.fd();
+        pfds[1].events = POLLIN;
+        if (SSL_pending(ssl) == 0 && poll(pfds, announced ? 1 : 2, 0) == 0) continue;
+
+        if (pfds[1].revents & POLLIN) {
+            Protocol::Frame announcement = Protocol::announce(board);
+            if (SSL_write(ssl, announcement.data, announcement.length) <= 0) return;
+            announced = true;
+        }
+        if (pfds[0].revents & (POLLNVAL | POLLERR | POLLHUP)) return;
+        if (SSL_pending(ssl) == 0 && !(pfds[0].revents & POLLIN)) continue;
+
+        // spectators are read-only, anything but bye is ignored
+        int read_len = SSL_read(ssl, buffer, BUFFER_LEN);
+        if (read_len <= 0) {
+            int error = SSL_get_error(ssl, read_len);
+            if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) continue;
+            return;
+        }
+        Protocol::Request request = Protocol::parse(buffer, read_len);
+        if (request.command == Protocol::COMMAND::BYE) return;
+    }
+}
 
-    impl->client_mutex.lock();
-    for (std::pair<const int, std::thread*>& client: impl->client_threads) {
+void MinesweeperServer::Private::quiesce() {
+    running = false;
+    accepting = false;
+    if (acceptor.joinable()) acceptor.join();
+    feed.stop();
+
+    client_mutex.lock();
+    for (std::pair<const int, std::thread*>& client: client_threads) {
         if (!client.second->joinable()) continue;
         close(client.first);
         client.second->join();
         delete client.second;
     }
-    impl->client_threads.clear();
-    impl->client_mutex.unlock();
+    client_threads.clear();
+    client_mutex.unlock();
+}
+
+void MinesweeperServer::hand_off(const std::string& path) {
+    int listener = Handoff::listen(path);
+    int successor = accept(listener, nullptr, nullptr);
+    close(listener);
+    unlink(path.c_str());
+    if (successor < 0) throw std::runtime_error("Accepting the successor failed");
+
+    // the board must not change once it is serialized, the listening socket stays open
+    // so connections arriving meanwhile wait in its backlog for the successor
+    impl->quiesce();
+    std::string snapshot = impl->board->serialize();
+    try {
+        Handoff::send(successor, {impl->socket}, snapshot);
+    } catch (std::runtime_error& error) {
+        close(successor);
+        throw;
+    }
+    close(successor);
+    std::cout << "Handed off to the successor\n";
+    stop();
+}
+
+void MinesweeperServer::stop() {
+    // hand_off() and the destructor both stop, the counters are reported once
+    if (impl->socket == -1 && impl->ctx == nullptr) return;
+    impl->quiesce();
 
-    
     SSL_CTX_free(impl->ctx);
+    impl->ctx = nullptr;
     
     if (impl->socket != -1) {
         close(impl->socket);
         impl->socket = -1;
     }
     
+    std::cout << "Throttled " << impl->throttled.load() << " requests, shed "
+              << impl->admission.shed() << " connections\n";
     std::cout << "Server exiting...\n";
 }
 
-MinesweeperServer::Private::~Private() { }
+MinesweeperServer::Private::~Private() {
+    delete solver;
+    delete board;
+}
 
 MinesweeperServer::~MinesweeperServer() {
     stop();
@@ -164,9 +382,27 @@ MinesweeperServer::~MinesweeperServer() {
 }
 
 int main() {
-    MinesweeperServer server{PORT};
-    server.start();
-    char buffer[1024];
-    read(0, buffer, 1024);
+    Topology::Placement placement = Topology::placement_from_environment();
+    const char *handoff_path = getenv("MINESWEEPER_HANDOFF_PATH");
+    if (handoff_path == nullptr) {
+        MinesweeperServer server{PORT, new BoardImplementation(BOARD_SIZE, BOARD_SIZE, BOMB_COUNT), placement};
+        server.start();
+        char buffer[1024];
+        read(0, buffer, 1024);
+        return 0;
+    }
+
+    // hot restart: take over from the running server if there is one, then serve until the next one takes over
+    MinesweeperServer *server;
+    try {
+        server = new MinesweeperServer(std::string{handoff_path}, placement);
+        std::cout << "Took over from the previous server\n";
+    } catch (std::runtime_error& error) {
+        std::cout << error.what() << ", starting a new game\n";
+        server = new MinesweeperServer(PORT, new BoardImplementation(BOARD_SIZE, BOARD_SIZE, BOMB_COUNT), placement);
+    }
+    server->start();
+    server->hand_off(handoff_path);
+    delete server;
     return 0;
 }
\ No newline at end of file
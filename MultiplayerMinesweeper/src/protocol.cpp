@@ -0,0 +1,162 @@
+#include "protocol.h"
+
+#include <cstdio>
+#include <cstring>
+
+static const char HELP_MESSAGE[] =
+    "Commands: look | dig X Y | flag X Y | deflag X Y | help | hint | snapshot | spectate | bye\n";
+
+static const char NO_HINT_MESSAGE[] = "hint none\n";
+
+static const char WON_MESSAGE[] = "GAME WON\n";
+
+static const char LOST_MESSAGE[] = "GAME LOST\n";
+
+#define HINT_LEN 32
+#define GREETING_LEN 96
+
+static const char BOOM_MESSAGE[] = "BOOM!\n";
+
+static const char THROTTLED_MESSAGE[] = "THROTTLED\n";
+
+static inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline const char *skip_spaces(const char *begin, const char *end) {
+    while (begin != end && is_space(*begin)) begin++;
+    return begin;
+}
+
+static inline bool match_word(const char *&begin, const char *end, const char *word) {
+    int length = strlen(word);
+    if (end - begin < length || strncmp(begin, word, length) != 0) return false;
+    if (begin + length != end && !is_space(begin[length])) return false;
+    begin += length;
+    return true;
+}
+
+static inline bool parse_int(const char *&begin, const char *end, int &output) {
+    begin = skip_spaces(begin, end);
+    bool negative = begin != end && *begin == '-';
+    if (negative) begin++;
+    if (begin == end || *begin < '0' || *begin > '9') return false;
+
+    long value = 0;
+    while (begin != end && *begin >= '0' && *begin <= '9') {
+        value = value * 10 + (*begin - '0');
+        if (value > 1000000000L) return false;
+        begin++;
+    }
+    if (begin != end && !is_space(*begin)) return false;
+    output = negative ? -value : value;
+    return true;
+}
+
+Protocol::Request Protocol::parse(const char *message, int length) noexcept {
+    const char *begin = skip_spaces(message, message + length);
+    const char *end = message + length;
+    Request request{COMMAND::INVALID, 0, 0};
+
+    if (match_word(begin, end, "look")) request.command = COMMAND::LOOK;
+    else if (match_word(begin, end, "dig")) request.command = COMMAND::DIG;
+    else if (match_word(begin, end, "flag")) request.command = COMMAND::FLAG;
+    else if (match_word(begin, end, "deflag")) request.command = COMMAND::DEFLAG;
+    else if (match_word(begin, end, "help")) request.command = COMMAND::HELP;
+    else if (match_word(begin, end, "hint")) request.command = COMMAND::HINT;
+    else if (match_word(begin, end, "snapshot")) request.command = COMMAND::SNAPSHOT;
+    else if (match_word(begin, end, "spectate")) request.command = COMMAND::SPECTATE;
+    else if (match_word(begin, end, "bye")) request.command = COMMAND::BYE;
+    else return request;
+
+    bool has_position = request.command == COMMAND::DIG
+        || request.command == COMMAND::FLAG
+        || request.command == COMMAND::DEFLAG;
+    if (has_position && !(parse_int(begin, end, request.x) && parse_int(begin, end, request.y))) {
+        request.command = COMMAND::INVALID;
+        return request;
+    }
+
+    if (skip_spaces(begin, end) != end) request.command = COMMAND::INVALID;
+    return request;
+}
+
+static Protocol::Frame print_board(Board *board, Arena& arena) {
+    int buffer_len = board->print_length() + 1;
+    char *buffer = arena.allocate_array<char>(buffer_len);
+    int length = board->print(buffer, buffer_len);
+    buffer[length++] = '\n';
+    return Protocol::Frame{buffer, length, false};
+}
+
+static Protocol::Frame hint(BoardSolver *solver, Arena& arena) {
+    int y;
+    int x;
+    if (solver == nullptr) return Protocol::Frame{NO_HINT_MESSAGE, sizeof(NO_HINT_MESSAGE) - 1, false};
+
+    if (!solver->hint(y, x)) return Protocol::Frame{NO_HINT_MESSAGE, sizeof(NO_HINT_MESSAGE) - 1, false};
+
+    char *buffer = arena.allocate_array<char>(HINT_LEN);
+    int length = snprintf(buffer, HINT_LEN, "hint %d %d\n", x, y);
+    return Protocol::Frame{buffer, length, false};
+}
+
+Protocol::Frame Protocol::respond(Board *board, const Request& request, Arena& arena, BoardSolver *solver) {
+    switch (request.command) {
+    case COMMAND::LOOK:
+        return print_board(board, arena);
+    case COMMAND::DIG:
+        if (!board->dig(request.y, request.x)) return Frame{BOOM_MESSAGE, sizeof(BOOM_MESSAGE) - 1, true};
+        // the solver catches up on every move, reading only what the dig uncovered
+        if (solver != nullptr) solver->dug(board, request.y, request.x);
+        return print_board(board, arena);
+    case COMMAND::FLAG:
+        board->flag(request.y, request.x);
+        // so hints skip the flagged tile
+        if (solver != nullptr) solver->marked(board, request.y, request.x);
+        return print_board(board, arena);
+    case COMMAND::DEFLAG:
+        board->deflag(request.y, request.x);
+        if (solver != nullptr) solver->marked(board, request.y, request.x);
+        return print_board(board, arena);
+    case COMMAND::HINT:
+        return hint(solver, arena);
+    case COMMAND::SNAPSHOT:
+    case COMMAND::SPECTATE:
+        return Frame{nullptr, 0, false};
+    case COMMAND::BYE:
+        return Frame{nullptr, 0, true};
+    case COMMAND::HELP:
+    case COMMAND::INVALID:
+    default:
+        return Frame{HELP_MESSAGE, sizeof(HELP_MESSAGE) - 1, false};
+    }
+}
+
+Protocol::Frame Protocol::announce(Board *board) noexcept {
+    switch (board->state()) {
+    case GAME_STATE::WON:
+        return Frame{WON_MESSAGE, sizeof(WON_MESSAGE) - 1, false};
+    case GAME_STATE::LOST:
+        return Frame{LOST_MESSAGE, sizeof(LOST_MESSAGE) - 1, false};
+    case GAME_STATE::IN_PROGRESS:
+    default:
+        return Frame{nullptr, 0, false};
+    }
+}
+
+Protocol::Frame Protocol::throttled() noexcept {
+    return Frame{THROTTLED_MESSAGE, sizeof(THROTTLED_MESSAGE) - 1, false};
+}
+
+Protocol::Frame Protocol::greet(Board *board, Arena& arena) {
+    char *buffer = arena.allocate_array<char>(GREETING_LEN);
+    int length = snprintf(
+        buffer,
+        GREETING_LEN,
+        "Welcome to Minesweeper. Board: %d columns by %d rows. Type 'help' for help.\n",
+        board->columns(),
+        board->rows()
+    );
+    return Frame{buffer, length, false};
+}
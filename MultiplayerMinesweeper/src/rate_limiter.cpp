@@ -0,0 +1,78 @@
+#include "rate_limiter.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#define NS_PER_SECOND 1000000000.0
+#define LAG_SMOOTHING_SHIFT 3
+
+static inline int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+TokenBucket::TokenBucket(double rate, int burst):
+interval{0}, tolerance{0}, tat{0}, rejected_count{0} {
+    if (!(rate > 0)) throw std::domain_error("rate must be positive.");
+    if (burst < 1) throw std::domain_error("burst must be positive.");
+
+    interval = (int64_t) (NS_PER_SECOND / rate);
+    if (interval < 1) interval = 1;
+    tolerance = (burst - 1) * interval;
+}
+
+bool TokenBucket::try_acquire(int64_t now_ns) noexcept {
+    int64_t current = tat.load(std::memory_order_relaxed);
+    while (true) {
+        // an empty bucket refills from now, not from when it emptied
+        int64_t start = current > now_ns ? current : now_ns;
+        if (start - now_ns > tolerance) {
+            rejected_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (tat.compare_exchange_weak(current, start + interval, std::memory_order_relaxed)) return true;
+    }
+}
+
+bool TokenBucket::try_acquire() noexcept {
+    return try_acquire(steady_now_ns());
+}
+
+void TokenBucket::give_back() noexcept {
+    // a bucket refilled past full by the return is capped again by the next try_acquire
+    tat.fetch_sub(interval, std::memory_order_relaxed);
+}
+
+uint64_t TokenBucket::rejected() const noexcept {
+    return rejected_count.load(std::memory_order_relaxed);
+}
+
+AdmissionControl::AdmissionControl(int64_t max_lag_ns):
+threshold{max_lag_ns}, average_lag{0}, shed_count{0} {
+    if (max_lag_ns < 0) throw std::domain_error("max_lag_ns must be non negative.");
+}
+
+void AdmissionControl::record_lag(int64_t lag_ns) noexcept {
+    if (lag_ns < 0) lag_ns = 0;
+    int64_t current = average_lag.load(std::memory_order_relaxed);
+    int64_t next;
+    do {
+        // average += (sample - average) / 2^LAG_SMOOTHING_SHIFT
+        next = current + ((lag_ns - current) >> LAG_SMOOTHING_SHIFT);
+    } while (!average_lag.compare_exchange_weak(current, next, std::memory_order_relaxed));
+}
+
+bool AdmissionControl::admit() noexcept {
+    if (average_lag.load(std::memory_order_relaxed) <= threshold) return true;
+    shed_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+int64_t AdmissionControl::lag() const noexcept {
+    return average_lag.load(std::memory_order_relaxed);
+}
+
+uint64_t AdmissionControl::shed() const noexcept {
+    return shed_count.load(std::memory_order_relaxed);
+}
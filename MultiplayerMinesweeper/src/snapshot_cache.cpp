@@ -0,0 +1,44 @@
+#include "snapshot_cache.h"
+
+#include <cstdio>
+
+#include "snapshot_codec.h"
+
+#define HEADER_LEN 64
+
+SnapshotCache::SnapshotCache(Board *board):
+board{board}, frame{nullptr}, cached_version{0}, encode_count{0}, view{}, cache_mutex{} {}
+
+std::shared_ptr<const std::string> SnapshotCache::get() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    // the version is read before printing, a change racing the print is only
+    // ever encoded too early and invalidates this frame on the next call
+    uint64_t version = board->version();
+    if (frame != nullptr && version == cached_version) return frame;
+
+    int rows = board->rows();
+    int columns = board->columns();
+    view.resize(board->print_length());
+    board->print(&view[0], view.size());
+
+    std::string encoded;
+    SnapshotCodec::encode(view.data(), rows, columns, encoded);
+
+    char header[HEADER_LEN];
+    int header_len = snprintf(header, HEADER_LEN, "SNAPSHOT %d %d %zu\n", columns, rows, encoded.size());
+    std::shared_ptr<std::string> next = std::make_shared<std::string>();
+    next->reserve(header_len + encoded.size());
+    next->append(header, header_len);
+    next->append(encoded);
+
+    frame = std::move(next);
+    cached_version = version;
+    encode_count++;
+    return frame;
+}
+
+uint64_t SnapshotCache::encodings() const noexcept {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return encode_count;
+}
@@ -0,0 +1,90 @@
+#include "snapshot_codec.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#define SYMBOL_COUNT 11
+#define SHORT_RUN_LIMIT 15
+#define NO_SYMBOL -1
+
+static const char SYMBOLS[SYMBOL_COUNT] = {'-', 'F', ' ', '1', '2', '3', '4', '5', '6', '7', '8'};
+
+static inline int symbol_of(char tile) {
+    if (tile == '-') return 0;
+    if (tile == 'F') return 1;
+    if (tile == ' ') return 2;
+    if (tile >= '1' && tile <= '8') return 3 + tile - '1';
+    return NO_SYMBOL;
+}
+
+static inline void append_run(std::string& output, int symbol, long run) {
+    if (run <= SHORT_RUN_LIMIT) {
+        output.push_back((char) (symbol << 4 | (run - 1)));
+        return;
+    }
+    output.push_back((char) (symbol << 4 | SHORT_RUN_LIMIT));
+    unsigned long rest = run - SHORT_RUN_LIMIT - 1;
+    while (rest >= 0x80) {
+        output.push_back((char) ((rest & 0x7f) | 0x80));
+        rest >>= 7;
+    }
+    output.push_back((char) rest);
+}
+
+void SnapshotCodec::encode(const char *view, int rows, int columns, std::string& output) {
+    int symbol = NO_SYMBOL;
+    long run = 0;
+    for (int i = 0; i < rows; i++) {
+        const char *row = view + (long) i * (columns + 1);
+        for (int j = 0; j < columns; j++) {
+            int tile = symbol_of(row[j]);
+            if (tile == NO_SYMBOL) throw std::domain_error("board representation holds an unknown tile.");
+            if (tile == symbol) {
+                run++;
+                continue;
+            }
+            if (run > 0) append_run(output, symbol, run);
+            symbol = tile;
+            run = 1;
+        }
+    }
+    if (run > 0) append_run(output, symbol, run);
+}
+
+bool SnapshotCodec::decode(const char *data, int length, int rows, int columns, char *view) noexcept {
+    long size = (long) rows * columns;
+    long tile = 0;
+    int position = 0;
+    while (position < length) {
+        unsigned char header = data[position++];
+        int symbol = header >> 4;
+        if (symbol >= SYMBOL_COUNT) return false;
+
+        unsigned long run = (header & 0xf) + 1;
+        if (run > SHORT_RUN_LIMIT) {
+            unsigned long rest = 0;
+            int shift = 0;
+            unsigned char byte;
+            do {
+                if (position == length || shift > 56) return false;
+                byte = data[position++];
+                rest |= (unsigned long) (byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            run = SHORT_RUN_LIMIT + 1 + rest;
+        }
+        if (run > (unsigned long) (size - tile)) return false;
+
+        // runs continue across rows, the separators are skipped
+        while (run > 0) {
+            long column = tile % columns;
+            long taken = run < (unsigned long) (columns - column) ? run : columns - column;
+            memset(view + tile / columns * (columns + 1) + column, SYMBOLS[symbol], taken);
+            tile += taken;
+            run -= taken;
+        }
+    }
+    if (tile != size) return false;
+    for (int i = 0; i < rows; i++) view[(long) (i + 1) * (columns + 1) - 1] = '\n';
+    return true;
+}
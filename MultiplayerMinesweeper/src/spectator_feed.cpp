@@ -0,0 +1,60 @@
+#include "spectator_feed.h"
+
+#include <chrono>
+#include <stdexcept>
+
+SpectatorFeed::SpectatorFeed(Board *board, int max_frames_per_second):
+board{board}, frame_interval_ms{0}, running{false}, dirty{true}, publisher{}, frame{nullptr}, sequence{0}, frame_mutex{}, frame_published{} {
+    if (max_frames_per_second < 1) throw std::domain_error("max_frames_per_second must be positive.");
+    frame_interval_ms = 1000 / max_frames_per_second;
+}
+
+SpectatorFeed::~SpectatorFeed() {
+    stop();
+}
+
+void SpectatorFeed::start() {
+    if (running.exchange(true)) return;
+    publisher = std::thread(&SpectatorFeed::publish_frames, this);
+}
+
+void SpectatorFeed::stop() {
+    if (!running.exchange(false)) return;
+    frame_published.notify_all();
+    if (publisher.joinable()) publisher.join();
+}
+
+void SpectatorFeed::mark_dirty() noexcept {
+    dirty.store(true, std::memory_order_release);
+}
+
+void SpectatorFeed::publish_frames() {
+    while (running) {
+        if (dirty.exchange(false, std::memory_order_acq_rel)) {
+            // the only place where the board is read, once per frame regardless of spectator count
+            std::string encoded(board->print_length(), '\0');
+            int length = board->print(&encoded[0], encoded.size());
+            encoded.resize(length);
+            encoded.push_back('\n');
+            std::shared_ptr<const std::string> new_frame = std::make_shared<const std::string>(std::move(encoded));
+
+            std::unique_lock<std::mutex> lock(frame_mutex);
+            frame = std::move(new_frame);
+            sequence++;
+            lock.unlock();
+            frame_published.notify_all();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(frame_interval_ms));
+    }
+}
+
+std::shared_ptr<const std::string> SpectatorFeed::wait_frame(uint64_t &last_sequence, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(frame_mutex);
+    bool published = frame_published.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&]() {
+        return sequence > last_sequence || !running;
+    });
+    if (!published || sequence <= last_sequence) return nullptr;
+
+    last_sequence = sequence;
+    return frame;
+}
@@ -0,0 +1,149 @@
+#include "topology.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define NODE_PATH "/sys/devices/system/node/node"
+#define MAX_NODES 1024
+
+// from <numaif.h>, spelled out to avoid depending on libnuma
+#define MPOL_BIND 2
+#define MPOL_MF_MOVE (1 << 1)
+
+static bool read_line(const std::string& path, std::string& line) {
+    std::ifstream file{path};
+    return file && std::getline(file, line);
+}
+
+static inline bool parse_number(const std::string& text, size_t &position, int &output) {
+    size_t begin = position;
+    long value = 0;
+    while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+        value = value * 10 + (text[position++] - '0');
+        if (value > 1000000L) return false;
+    }
+    output = value;
+    return position != begin;
+}
+
+std::vector<int> Topology::parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    size_t position = 0;
+    if (list.empty() || list[0] == '\n') return cpus;
+    while (true) {
+        int first;
+        if (!parse_number(list, position, first)) throw std::domain_error("malformed cpu list: " + list);
+        int last = first;
+        if (position < list.size() && list[position] == '-') {
+            position++;
+            if (!parse_number(list, position, last) || last < first) throw std::domain_error("malformed cpu list: " + list);
+        }
+        for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+
+        if (position == list.size() || list[position] == '\n') break;
+        if (list[position++] != ',') throw std::domain_error("malformed cpu list: " + list);
+    }
+    return cpus;
+}
+
+int Topology::node_count() {
+    std::string line;
+    int count = 0;
+    while (count < MAX_NODES && read_line(NODE_PATH + std::to_string(count) + "/cpulist", line)) count++;
+    return count == 0 ? 1 : count;
+}
+
+std::vector<int> Topology::node_cpus(int node) {
+    std::string line;
+    if (read_line(NODE_PATH + std::to_string(node) + "/cpulist", line)) return parse_cpu_list(line);
+
+    std::vector<int> cpus;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int cpu = 0; cpu < online; cpu++) cpus.push_back(cpu);
+    return cpus;
+}
+
+Topology::Placement Topology::placement_from_environment() {
+    Placement placement{{}, {}, -1};
+    const char *accept_cpus = getenv("MINESWEEPER_ACCEPT_CPUS");
+    const char *worker_cpus = getenv("MINESWEEPER_WORKER_CPUS");
+    const char *board_node = getenv("MINESWEEPER_BOARD_NODE");
+
+    if (accept_cpus != nullptr) placement.accept_cpus = parse_cpu_list(accept_cpus);
+    if (worker_cpus != nullptr) placement.worker_cpus = parse_cpu_list(worker_cpus);
+    if (board_node != nullptr) {
+        std::string node{board_node};
+        size_t position = 0;
+        if (!parse_number(node, position, placement.board_node) || position != node.size() || placement.board_node >= node_count()) {
+            throw std::domain_error("MINESWEEPER_BOARD_NODE is not a node of this machine: " + node);
+        }
+        // keep the threads touching the board next to it
+        if (worker_cpus == nullptr) placement.worker_cpus = node_cpus(placement.board_node);
+    }
+    return placement;
+}
+
+bool Topology::pin_current_thread(const std::vector<int>& cpus) {
+    if (cpus.empty()) return true;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu: cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool Topology::bind_memory(void *address, size_t length, int node) {
+    if (node < 0 || length == 0) return true;
+    if (node >= MAX_NODES) return false;
+
+    // mbind works on whole pages, a page shared with other memory would take it along
+    uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = (uintptr_t) address;
+    if ((begin & (page - 1)) != 0) return false;
+    uintptr_t end = (begin + length + page - 1) & ~(page - 1);
+
+    unsigned long mask[MAX_NODES / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    // the kernel reads one bit less than maxnode
+    return syscall(SYS_mbind, begin, end - begin, MPOL_BIND, mask, MAX_NODES + 1, MPOL_MF_MOVE) == 0;
+}
+
+static std::string describe_cpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) return "any";
+    std::ostringstream output;
+    for (size_t i = 0; i < cpus.size(); i++) {
+        size_t run_end = i;
+        while (run_end + 1 < cpus.size() && cpus[run_end + 1] == cpus[run_end] + 1) run_end++;
+        if (i != 0) output << ",";
+        output << cpus[i];
+        if (run_end != i) output << "-" << cpus[run_end];
+        i = run_end;
+    }
+    return output.str();
+}
+
+std::string Topology::describe(const Placement& placement) {
+    std::ostringstream output;
+    int nodes = node_count();
+    output << "Topology: " << nodes << " NUMA node" << (nodes == 1 ? "" : "s") << "\n";
+    for (int node = 0; node < nodes; node++) {
+        output << "    node " << node << ": cpus " << describe_cpus(node_cpus(node)) << "\n";
+    }
+    output << "Placement: accept cpus " << describe_cpus(placement.accept_cpus)
+           << ", worker cpus " << describe_cpus(placement.worker_cpus)
+           << ", board node ";
+    if (placement.board_node < 0) output << "any";
+    else output << placement.board_node;
+    output << "\n";
+    return output.str();
+}
@@ -58,6 +58,8 @@ SSL_CTX* Util::create_context(bool is_server) {
         throw std::runtime_error("Unable to create SSL context");
     }
 
+    enable_ktls(ctx);
+
     return ctx;
 }
 
@@ -88,4 +90,20 @@ void Util::set_non_blocking(int fd) {
     int flags = fcntl(fd, F_GETFL, 0);
     if (flags == -1) throw std::runtime_error("Cannot get socket status flag");
     fcntl(fd, F_SETFL, flags | O_NONBLOCK);
-}
\ No newline at end of file
+}
+
+void Util::enable_ktls(SSL_CTX *ctx) {
+#ifdef SSL_OP_ENABLE_KTLS
+    SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+#endif
+}
+
+const char* Util::ktls_status(SSL *ssl) {
+    // both macros evaluate to 0 when OpenSSL is built without kTLS
+    bool send = BIO_get_ktls_send(SSL_get_wbio(ssl));
+    bool recv = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+    if (send && recv) return "send+recv";
+    if (send) return "send";
+    if (recv) return "recv";
+    return "off";
+}
@@ -0,0 +1,52 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+// the replacements live in their own translation unit, so callers never see
+// a malloc based operator new inlined next to a free based operator delete
+static thread_local long *thread_allocations = nullptr;
+
+static void *counted_allocate(std::size_t size) {
+    if (thread_allocations != nullptr) (*thread_allocations)++;
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new(std::size_t size) {
+    return counted_allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return counted_allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+AllocationCounter::AllocationCounter() noexcept:
+allocations{0} {
+    thread_allocations = &allocations;
+}
+
+AllocationCounter::~AllocationCounter() {
+    thread_allocations = nullptr;
+}
+
+long AllocationCounter::count() const noexcept {
+    return allocations;
+}
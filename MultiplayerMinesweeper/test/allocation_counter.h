@@ -0,0 +1,37 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+/**
+ * Counts the heap allocations made by the calling thread while the counter is alive.
+ * Allocations of other threads, and of tests running before or after, are not counted.
+ * Counting replaces the global operator new and operator delete, so only the dedicated
+ * allocation test binary links allocation_counter.cpp.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter(const AllocationCounter& that) = delete;
+
+    AllocationCounter& operator=(const AllocationCounter& that) = delete;
+
+    AllocationCounter(AllocationCounter&& that) = delete;
+
+    AllocationCounter& operator=(AllocationCounter&& that) = delete;
+
+    /**
+     * Start counting the allocations of the calling thread, a thread counts into
+     * a single counter at a time.
+     */
+    AllocationCounter() noexcept;
+
+    ~AllocationCounter();
+
+    /**
+     * @return number of allocations made by the constructing thread since construction
+     */
+    long count() const noexcept;
+
+private:
+    long allocations;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "allocation_counter.h"
+#include "board_implementation.h"
+#include "board_solver.h"
+#include "client_session.h"
+#include "game_over_signal.h"
+#include "rate_limiter.h"
+#include "snapshot_cache.h"
+#include "spectator_feed.h"
+
+namespace {
+
+/**
+ * Deliver a message to the session in reads of at most chunk bytes,
+ * the way a client's bytes arrive split across TLS records.
+ */
+void deliver(ClientSession& session, const char *message, int chunk) {
+    int length = strlen(message);
+    for (int sent = 0; sent < length && session.connected();) {
+        int read_len = std::min({chunk, length - sent, session.receive_capacity()});
+        memcpy(session.receive_buffer(), message + sent, read_len);
+        session.received(read_len);
+        sent += read_len;
+    }
+}
+
+/**
+ * @return layout of a 50 by 50 board whose bombs all lie in the first row
+ */
+std::string layout() {
+    std::string rows;
+    for (int y = 0; y < 50; y++) {
+        for (int x = 0; x < 50; x++) rows += y == 0 && x % 5 == 0 ? 'B' : 'E';
+        if (y < 49) rows += '\n';
+    }
+    return rows;
+}
+
+TEST(AllocationTest, CounterTest) {
+    AllocationCounter counter{};
+    EXPECT_EQ(0, counter.count()) << "Expected no allocation counted yet";
+
+    // new expressions may be elided, calls of the operators are not
+    void *block = ::operator new(16);
+    ::operator delete(block);
+    EXPECT_EQ(1, counter.count()) << "Expected an allocation of this thread counted";
+}
+
+TEST(AllocationTest, SteadyStateSessionTest) {
+    BoardImplementation board{layout()};
+    BoardSolver solver{&board};
+    SnapshotCache snapshots{&board};
+    SpectatorFeed feed{&board, 10};
+    TokenBucket room_bucket{1e9, 1 << 30};
+    std::atomic<uint64_t> throttled{0};
+    GameOverSignal game_over{};
+
+    long written = 0;
+    ClientSession session{
+        ClientSession::Room{&board, &solver, &snapshots, &feed, &room_bucket, &throttled, &game_over},
+        [&written](const char *, int length) {
+            written += length;
+            return true;
+        },
+        1e9,
+        1 << 30
+    };
+    const char *messages = "look\nflag 3 3\ndeflag 3 3\ndig 10 10\nhelp\nnonsense\ndig 49 49\n";
+
+    // warm up so the board settles and the session's arenas reach their steady state size
+    ASSERT_TRUE(session.greet());
+    for (int i = 0; i < 2; i++) deliver(session, messages, 7);
+
+    long before = written;
+    AllocationCounter counter{};
+    for (int i = 0; i < 100; i++) deliver(session, messages, 7);
+    long allocations = counter.count();
+
+    ASSERT_TRUE(session.connected()) << "Expected the session to stay connected";
+    EXPECT_LT(before, written) << "Expected replies written";
+    EXPECT_EQ(0, throttled.load()) << "Expected no request throttled";
+    EXPECT_EQ(0, allocations) << "Expected no heap allocation on the steady state request path";
+}
+}
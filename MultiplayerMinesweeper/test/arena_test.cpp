@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "arena.h"
+
+namespace {
+
+TEST(ArenaTest, ConstructorTest) {
+    ASSERT_NO_THROW(Arena(64)) << "Constructor must succeed if the block size is positive";
+    EXPECT_THROW(Arena(0), std::domain_error) << "Expected constructor to throw error when block size is zero";
+}
+
+TEST(ArenaTest, AllocateTest) {
+    /**
+     * Testing strategy
+     * partition on allocation size:
+     *      - fits in the current block
+     *      - does not fit in the current block
+     *      - bigger than the block size
+     *
+     * partition on alignment:
+     *      - 1
+     *      - bigger than 1
+     */
+    Arena arena{64};
+
+    // fits in the current block, alignment 1
+    char *first = arena.allocate_array<char>(10);
+    EXPECT_EQ(10, arena.used()) << "Expected used bytes to match the allocation";
+
+    // fits in the current block, alignment bigger than 1
+    uint64_t *second = arena.allocate_array<uint64_t>(2);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % alignof(uint64_t)) << "Expected aligned pointer";
+    EXPECT_NE(static_cast<void*>(first), static_cast<void*>(second)) << "Expected distinct allocations";
+
+    // does not fit in the current block
+    arena.allocate(60);
+    EXPECT_EQ(128, arena.capacity()) << "Expected arena to grow by one block";
+
+    // bigger than the block size
+    arena.allocate(1000);
+    EXPECT_LE(1000 + 128, arena.capacity()) << "Expected arena to grow by an oversized block";
+}
+
+TEST(ArenaTest, ResetTest) {
+    Arena arena{64};
+    char *first = arena.allocate_array<char>(40);
+    arena.allocate(40);
+    arena.allocate(200);
+    std::size_t capacity = arena.capacity();
+
+    arena.reset();
+    EXPECT_EQ(0, arena.used()) << "Expected nothing in use after reset";
+    EXPECT_EQ(first, arena.allocate_array<char>(40)) << "Expected memory to be reused after reset";
+    arena.allocate(40);
+    arena.allocate(200);
+    EXPECT_EQ(capacity, arena.capacity()) << "Expected warmed up arena not to grow";
+}
+
+TEST(ArenaTest, AllocatorTest) {
+    Arena arena{1024};
+    std::vector<int, ArenaAllocator<int>> numbers{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 100; i++) numbers.push_back(i);
+    EXPECT_EQ(100, numbers.size());
+    EXPECT_EQ(99, numbers.back());
+    EXPECT_LT(0, arena.used()) << "Expected vector storage to come from the arena";
+}
+}
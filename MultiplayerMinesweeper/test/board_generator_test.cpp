@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "board_generator.h"
+
+namespace {
+
+std::vector<TILE_HIDDEN> generate(int size, int bomb_count, uint64_t seed, int thread_count) {
+    std::vector<TILE_HIDDEN> back(size);
+    BoardGenerator::place_bombs(back.data(), size, bomb_count, seed, thread_count);
+    return back;
+}
+
+TEST(BoardGeneratorTest, PlaceBombsTest) {
+    /**
+     * Testing strategy
+     * partition on bomb_count:
+     *      - zero
+     *      - between zero and size
+     *      - equal to size
+     *
+     * partition on thread_count:
+     *      - one
+     *      - more than one, dividing the size evenly or not
+     */
+
+    // zero bombs
+    std::vector<TILE_HIDDEN> back = generate(1000, 0, 7, 3);
+    EXPECT_EQ(0, std::count(back.begin(), back.end(), TILE_HIDDEN::BOMB)) << "Expected no bomb";
+
+    // every tile is a bomb
+    back = generate(1000, 1000, 7, 3);
+    EXPECT_EQ(1000, std::count(back.begin(), back.end(), TILE_HIDDEN::BOMB)) << "Expected bombs on every tile";
+
+    // between zero and size, any number of threads
+    std::vector<TILE_HIDDEN> expected = generate(100003, 20011, 42, 1);
+    EXPECT_EQ(20011, std::count(expected.begin(), expected.end(), TILE_HIDDEN::BOMB)) << "Expected exact number of bombs";
+    for (int thread_count: {2, 3, 8, 13}) {
+        EXPECT_EQ(expected, generate(100003, 20011, 42, thread_count)) << "Expected same board with " << thread_count << " threads";
+    }
+
+    EXPECT_NE(expected, generate(100003, 20011, 43, 4)) << "Expected different seed to give a different board";
+}
+
+TEST(BoardGeneratorTest, CalculateBoundariesTest) {
+    int y_size = 301;
+    int x_size = 97;
+    std::vector<TILE_HIDDEN> back = generate(y_size * x_size, 5000, 1, 4);
+
+    std::vector<int> expected(y_size * x_size, 0);
+    for (int i = 0; i < y_size; i++) {
+        for (int j = 0; j < x_size; j++) {
+            if (back[i * x_size + j] != TILE_HIDDEN::BOMB) continue;
+            for (int row = i - 1; row <= i + 1; row++) {
+                for (int col = j - 1; col <= j + 1; col++) {
+                    if (row < 0 || col < 0 || row >= y_size || col >= x_size || (row == i && col == j)) continue;
+                    expected[row * x_size + col]++;
+                }
+            }
+        }
+    }
+
+    for (int thread_count: {1, 2, 7}) {
+        std::vector<int> boundaries(y_size * x_size, -1);
+        BoardGenerator::calculate_boundaries(boundaries.data(), back.data(), y_size, x_size, thread_count);
+        EXPECT_EQ(expected, boundaries) << "Expected correct boundaries with " << thread_count << " threads";
+    }
+}
+}
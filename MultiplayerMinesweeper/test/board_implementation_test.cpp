@@ -1,13 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <memory>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "board_implementation.h"
 
 namespace {
 
+const std::string BOARD_LAYOUT = "EEEEEEEEEE\nEBEEEEEEEE\nEEEEEEEEEE\nEEEEEEBEEB\nEEEBBEEEEB\nEEEEEEEEEE\nBEEEEEBEEE\nEEEEEEEEEE\nEEEEEEEEEB\nEEBEEEEEEE";
+
 class BoardImplementationTest: public ::testing::Test {
 protected:
     void SetUp(void) {
@@ -25,7 +30,7 @@ protected:
         EXPECT_STREQ(back, output["back"].get()) << "Expected correct board's backside";
         EXPECT_STREQ(boundaries, output["boundaries"].get()) << "Expected correct board's bomb boundaries number";    
     }
-    BoardImplementation board = BoardImplementation(10, 10, 10, 0);
+    BoardImplementation board = BoardImplementation(BOARD_LAYOUT);
     std::unordered_map<std::string, std::unique_ptr<char []>> output;
     char *front;
     char *back;
@@ -36,6 +41,19 @@ TEST_F(BoardImplementationTest, ConstructorTest) {
     ASSERT_NO_THROW(BoardImplementation(10, 10, 10, 0)) << "Custructor must succeed if the parameters are valid";
     EXPECT_THROW(BoardImplementation(10, 0, 10, 0), std::domain_error) << "Expected constructor to throw error when one of the size is non positive";
     EXPECT_THROW(BoardImplementation(8, 15, 200, 0), std::runtime_error) << "Expected constructor to throw error when bomb count is bigger than board size";
+
+    ASSERT_NO_THROW(BoardImplementation{BOARD_LAYOUT}) << "Layout constructor must succeed if the layout is valid";
+    EXPECT_THROW(BoardImplementation(std::string{""}), std::domain_error) << "Expected layout constructor to throw error when the layout is empty";
+    EXPECT_THROW(BoardImplementation(std::string{"EE\nE"}), std::domain_error) << "Expected layout constructor to throw error when rows differ in length";
+    EXPECT_THROW(BoardImplementation(std::string{"EB\nEX"}), std::domain_error) << "Expected layout constructor to throw error on unknown tiles";
+}
+
+TEST_F(BoardImplementationTest, RandomConstructorTest) {
+    output = BoardImplementation(10, 10, 10, 0).print_debug();
+    std::string back{output["back"].get()};
+    EXPECT_EQ(10, std::count(back.begin(), back.end(), 'B')) << "Expected exact number of bombs";
+    EXPECT_STREQ(back.c_str(), BoardImplementation(10, 10, 10, 0).print_debug()["back"].get()) << "Expected same seed to give the same board";
+    EXPECT_STRNE(back.c_str(), BoardImplementation(10, 10, 10, 1).print_debug()["back"].get()) << "Expected different seed to give a different board";
 }
 
 TEST_F(BoardImplementationTest, PrintTest) {
@@ -197,4 +215,189 @@ TEST_F(BoardImplementationTest, DeflagTest) {
     output = board.print_debug();
     check_board_state();
 }
-}
\ No newline at end of file
+
+TEST_F(BoardImplementationTest, GameStateTest) {
+    /**
+     * Testing strategy
+     * partition on dug tiles:
+     *      - none
+     *      - some empty tiles
+     *      - every empty tile
+     *      - a bomb
+     *
+     * partition on flags:
+     *      - zero
+     *      - flagged then deflagged
+     */
+
+    // nothing dug, zero flags
+    EXPECT_EQ(GAME_STATE::IN_PROGRESS, board.state());
+    EXPECT_EQ(90, board.remaining_safe_tiles()) << "Expected every empty tile to be remaining";
+    EXPECT_EQ(0, board.flag_count());
+    EXPECT_EQ(0, board.bombs_hit());
+
+    // some empty tiles dug by a flood fill, flags placed and removed
+    board.dig(4, 1);
+    EXPECT_EQ(78, board.remaining_safe_tiles()) << "Expected flood filled tiles to be counted";
+    board.flag(0, 0);
+    board.flag(0, 0);
+    board.flag(1, 1);
+    EXPECT_EQ(2, board.flag_count()) << "Expected flagging a flagged tile to be ignored";
+    board.deflag(0, 0);
+    board.deflag(0, 0);
+    EXPECT_EQ(1, board.flag_count()) << "Expected deflagging an untouched tile to be ignored";
+    EXPECT_EQ(GAME_STATE::IN_PROGRESS, board.state());
+
+    // a bomb
+    board.dig(3, 9);
+    EXPECT_EQ(1, board.bombs_hit());
+    EXPECT_EQ(78, board.remaining_safe_tiles()) << "Expected a bomb not to count as an empty tile";
+    EXPECT_EQ(GAME_STATE::LOST, board.state());
+
+    // every empty tile
+    BoardImplementation small{std::string{"EEB\nEEE"}};
+    small.dig(1, 0);
+    EXPECT_EQ(1, small.remaining_safe_tiles());
+    EXPECT_EQ(GAME_STATE::IN_PROGRESS, small.state());
+    small.dig(1, 2);
+    EXPECT_EQ(0, small.remaining_safe_tiles());
+    EXPECT_EQ(GAME_STATE::WON, small.state());
+}
+
+TEST_F(BoardImplementationTest, ConcurrentGameStateTest) {
+    /**
+     * Testing strategy
+     * partition on concurrent digs of a tile:
+     *      - empty tile, bomb
+     *
+     * every thread digs every tile, a tile must be counted by the one dig that uncovers it
+     */
+    for (int round = 0; round < 50; round++) {
+        BoardImplementation shared{BOARD_LAYOUT};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; t++) {
+            threads.emplace_back([&shared]() {
+                for (int i = 0; i < 10; i++) {
+                    for (int j = 0; j < 10; j++) shared.dig(i, j);
+                }
+            });
+        }
+        for (std::thread& thread: threads) thread.join();
+
+        ASSERT_EQ(0, shared.remaining_safe_tiles()) << "Expected every empty tile counted once in round " << round;
+        ASSERT_EQ(10, shared.bombs_hit()) << "Expected every bomb counted once in round " << round;
+        ASSERT_EQ(GAME_STATE::LOST, shared.state());
+    }
+}
+
+TEST_F(BoardImplementationTest, PrintCacheTest) {
+    /**
+     * Testing strategy
+     * partition on board since the last print:
+     *      - unchanged
+     *      - changed rows: flagged, flood filled, bomb dug changing the rows around it
+     *
+     * partition on the last printed buffer:
+     *      - still held by the caller
+     *      - released
+     */
+
+    // unchanged board shares the buffer
+    std::shared_ptr<const char[]> first = board.print();
+    EXPECT_EQ(first, board.print()) << "Expected unchanged board to share the printed buffer";
+
+    // changed while the buffer is held
+    std::string before{first.get()};
+    board.flag(0, 0);
+    std::shared_ptr<const char[]> flagged = board.print();
+    EXPECT_EQ(before, std::string(first.get())) << "Expected a held buffer never to change";
+    EXPECT_EQ('F', flagged[0]) << "Expected the new buffer to hold the change";
+
+    // changed after the buffer is released, every representation matches a full render
+    first = nullptr;
+    flagged = nullptr;
+    board.dig(4, 1);
+    board.dig(3, 9);
+    BoardImplementation fresh = BoardImplementation::deserialize(board.serialize());
+    std::vector<char> buffer(board.print_length());
+    board.print(buffer.data(), buffer.size());
+    EXPECT_STREQ(fresh.print().get(), board.print().get()) << "Expected patched rows to match a full render";
+    EXPECT_STREQ(fresh.print().get(), buffer.data()) << "Expected both print methods to agree";
+}
+
+TEST_F(BoardImplementationTest, VersionTest) {
+    /**
+     * Testing strategy
+     * partition on operation:
+     *      - changing the board: dig, flag, deflag
+     *      - not changing the board: dig of a dug or flagged tile, flag of a flagged tile,
+     *        out of bound, print
+     */
+    uint64_t version = board.version();
+
+    // not changing the board
+    board.print();
+    board.flag(-1, 0);
+    board.deflag(0, 0);
+    EXPECT_EQ(version, board.version()) << "Expected no new version without a change";
+
+    // changing the board
+    board.flag(0, 0);
+    EXPECT_LT(version, board.version()) << "Expected flag to change the version";
+    version = board.version();
+    board.flag(0, 0);
+    board.dig(0, 0);
+    EXPECT_EQ(version, board.version()) << "Expected repeated flag and dig of a flagged tile to keep the version";
+    board.deflag(0, 0);
+    EXPECT_LT(version, board.version());
+    version = board.version();
+    board.dig(4, 1);
+    EXPECT_LT(version, board.version()) << "Expected dig to change the version";
+    version = board.version();
+    board.dig(4, 1);
+    EXPECT_EQ(version, board.version()) << "Expected dig of a dug tile to keep the version";
+}
+
+TEST_F(BoardImplementationTest, SerializeTest) {
+    /**
+     * Testing strategy
+     * partition on board:
+     *      - untouched
+     *      - dug, flagged and a bomb dug
+     *
+     * partition on snapshot:
+     *      - produced by serialize
+     *      - truncated or corrupted
+     */
+
+    // untouched
+    BoardImplementation restored = BoardImplementation::deserialize(board.serialize());
+    EXPECT_STREQ(board.print().get(), restored.print().get()) << "Expected untouched board to be restored";
+    EXPECT_EQ(board.remaining_safe_tiles(), restored.remaining_safe_tiles());
+
+    // dug, flagged and a bomb dug
+    board.dig(4, 1);
+    board.flag(0, 0);
+    board.dig(3, 9);
+    restored = BoardImplementation::deserialize(board.serialize());
+    EXPECT_STREQ(board.print().get(), restored.print().get()) << "Expected board representation to be restored";
+    EXPECT_EQ(board.remaining_safe_tiles(), restored.remaining_safe_tiles()) << "Expected counters to be restored";
+    EXPECT_EQ(1, restored.flag_count());
+    EXPECT_EQ(GAME_STATE::LOST, restored.state());
+    std::unordered_map<std::string, std::unique_ptr<char []>> expected = board.print_debug();
+    std::unordered_map<std::string, std::unique_ptr<char []>> actual = restored.print_debug();
+    EXPECT_STREQ(expected["back"].get(), actual["back"].get()) << "Expected hidden tiles to be restored";
+    EXPECT_STREQ(expected["boundaries"].get(), actual["boundaries"].get());
+
+    restored.dig(0, 9);
+    board.dig(0, 9);
+    EXPECT_STREQ(board.print().get(), restored.print().get()) << "Expected restored board to be playable";
+
+    // truncated or corrupted
+    std::string snapshot = board.serialize();
+    EXPECT_THROW(BoardImplementation::deserialize(snapshot.substr(0, snapshot.size() - 1)), std::domain_error);
+    EXPECT_THROW(BoardImplementation::deserialize(""), std::domain_error);
+    snapshot[0] ^= 1;
+    EXPECT_THROW(BoardImplementation::deserialize(snapshot), std::domain_error) << "Expected foreign data to be rejected";
+}
+}
@@ -0,0 +1,69 @@
+#ifndef BOARD_INVARIANTS_H
+#define BOARD_INVARIANTS_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "board_implementation.h"
+
+/**
+ * Check the invariants of a board that no operation sequence may break.
+ * The board must not be used by another thread during the check.
+ *      - every tile's boundary counts its neighbors that are bombs not dug yet
+ *      - the counters match the tiles: remaining safe tiles, flags and bombs dug
+ *      - print() matches a full render of the same board
+ *
+ * @param board the checked board
+ * @return a description of the first broken invariant, empty if none is broken
+ */
+inline std::string check_board_invariants(BoardImplementation& board) {
+    int y_size = board.rows();
+    int x_size = board.columns();
+    int x_length = x_size + 1;
+    std::unordered_map<std::string, std::unique_ptr<char []>> tiles = board.print_debug();
+    const char *front = tiles["front"].get();
+    const char *back = tiles["back"].get();
+    const char *boundaries = tiles["boundaries"].get();
+
+    int remaining_safe = 0;
+    int flags = 0;
+    int bombs = 0;
+    for (int i = 0; i < y_size; i++) {
+        for (int j = 0; j < x_size; j++) {
+            char shown = front[i * x_length + j];
+            bool bomb = back[i * x_length + j] == 'B';
+            if (!bomb && shown != 'D') remaining_safe++;
+            if (shown == 'F') flags++;
+            if (bomb && shown == 'D') bombs++;
+
+            int live_bombs = 0;
+            for (int row = i - 1; row <= i + 1; row++) {
+                for (int col = j - 1; col <= j + 1; col++) {
+                    if (row < 0 || col < 0 || row >= y_size || col >= x_size || (row == i && col == j)) continue;
+                    if (back[row * x_length + col] == 'B' && front[row * x_length + col] != 'D') live_bombs++;
+                }
+            }
+            if (boundaries[i * x_length + j] - '0' != live_bombs) {
+                return "boundary of (" + std::to_string(i) + ", " + std::to_string(j) + ") is "
+                    + std::to_string(boundaries[i * x_length + j] - '0') + ", expected " + std::to_string(live_bombs);
+            }
+        }
+    }
+
+    if (board.remaining_safe_tiles() != remaining_safe) {
+        return "remaining safe tiles is " + std::to_string(board.remaining_safe_tiles()) + ", expected " + std::to_string(remaining_safe);
+    }
+    if (board.flag_count() != flags) {
+        return "flag count is " + std::to_string(board.flag_count()) + ", expected " + std::to_string(flags);
+    }
+    if (board.bombs_hit() != bombs) {
+        return "bombs hit is " + std::to_string(board.bombs_hit()) + ", expected " + std::to_string(bombs);
+    }
+
+    BoardImplementation fresh = BoardImplementation::deserialize(board.serialize());
+    if (std::string{board.print().get()} != std::string{fresh.print().get()}) return "print() differs from a full render";
+    return "";
+}
+
+#endif
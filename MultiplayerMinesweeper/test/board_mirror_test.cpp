@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "board_mirror.h"
+#include "snapshot_codec.h"
+
+namespace {
+
+static const char GREETING[] = "Welcome to Minesweeper. Board: 3 columns by 2 rows. Type 'help' for help.\n";
+
+void receive(BoardMirror& mirror, const char *data) {
+    mirror.receive(data, strlen(data));
+}
+
+std::string render(BoardMirror& mirror) {
+    std::string output;
+    mirror.render(output);
+    return output;
+}
+
+TEST(BoardMirrorTest, ReceiveTest) {
+    /**
+     * Testing strategy
+     * partition on received lines:
+     *      - before the greeting
+     *      - greeting
+     *      - board frame, complete or split across calls
+     *      - message between frames
+     */
+    BoardMirror mirror;
+
+    // before the greeting
+    receive(mirror, "hello\n");
+    EXPECT_EQ(0, mirror.rows()) << "Expected size to be unknown before the greeting";
+    EXPECT_EQ("hello\n", render(mirror)) << "Expected messages to be printed as they are before the greeting";
+
+    // greeting
+    receive(mirror, GREETING);
+    EXPECT_EQ(2, mirror.rows());
+    EXPECT_EQ(3, mirror.columns());
+    EXPECT_EQ('-', mirror.tile(1, 2)) << "Expected untouched tiles before the first frame";
+
+    // board frame split across calls
+    receive(mirror, "-F");
+    receive(mirror, "1\n 1-\n");
+    EXPECT_EQ('F', mirror.tile(0, 1));
+    EXPECT_EQ('1', mirror.tile(0, 2));
+    EXPECT_EQ(' ', mirror.tile(1, 0));
+
+    // message between frames restarts the frame
+    receive(mirror, "\nhint 2 1\n--F\n");
+    EXPECT_EQ('F', mirror.tile(0, 2)) << "Expected the frame after a message to start at the first row";
+    EXPECT_EQ(' ', mirror.tile(1, 0)) << "Expected rows not yet received to be kept";
+}
+
+TEST(BoardMirrorTest, RenderTest) {
+    /**
+     * Testing strategy
+     * partition on render:
+     *      - first render after the greeting
+     *      - nothing changed
+     *      - some tiles changed, in one or several runs
+     *      - status changed
+     */
+    BoardMirror mirror;
+    receive(mirror, GREETING);
+    receive(mirror, "---\n---\n\n");
+
+    // first render draws everything
+    std::string output = render(mirror);
+    EXPECT_NE(std::string::npos, output.find("\x1b[2J")) << "Expected first render to clear the screen";
+    EXPECT_NE(std::string::npos, output.find("\x1b[1;1H---")) << "Expected first row to be drawn";
+    EXPECT_NE(std::string::npos, output.find("\x1b[2;1H---")) << "Expected second row to be drawn";
+    EXPECT_NE(std::string::npos, output.find("Welcome")) << "Expected greeting on the status line";
+
+    // nothing changed
+    receive(mirror, "---\n---\n\n");
+    EXPECT_EQ("", render(mirror)) << "Expected identical frame to write nothing";
+
+    // changed tiles are drawn in runs
+    receive(mirror, "-FF\nF--\n\n");
+    output = render(mirror);
+    EXPECT_NE(std::string::npos, output.find("\x1b[1;2HFF")) << "Expected adjacent changes to share a cursor move";
+    EXPECT_NE(std::string::npos, output.find("\x1b[2;1HF")) << "Expected change of second row to be drawn";
+    EXPECT_EQ(std::string::npos, output.find("\x1b[2J")) << "Expected no clear screen after the first render";
+    EXPECT_EQ(std::string::npos, output.find("---")) << "Expected unchanged tiles not to be drawn";
+
+    // status changed
+    receive(mirror, "GAME WON\n");
+    output = render(mirror);
+    EXPECT_NE(std::string::npos, output.find("\x1b[4;1H\x1b[2KGAME WON")) << "Expected message on the status line";
+}
+
+TEST(BoardMirrorTest, SnapshotTest) {
+    /**
+     * Testing strategy
+     * partition on snapshot:
+     *      - complete in one call, split across calls
+     *      - of another board size
+     */
+    BoardMirror mirror;
+    receive(mirror, GREETING);
+
+    // split across calls, encoded board followed by a message
+    std::string encoded;
+    SnapshotCodec::encode("-F1\n 2-\n", 2, 3, encoded);
+    std::string frame = "SNAPSHOT 3 2 " + std::to_string(encoded.size()) + "\n" + encoded + "GAME WON\n";
+    mirror.receive(frame.data(), 10);
+    mirror.receive(frame.data() + 10, 8);
+    mirror.receive(frame.data() + 18, frame.size() - 18);
+    EXPECT_EQ('F', mirror.tile(0, 1)) << "Expected snapshot to be applied";
+    EXPECT_EQ('2', mirror.tile(1, 1));
+    std::string output = render(mirror);
+    EXPECT_NE(std::string::npos, output.find("GAME WON")) << "Expected line after the snapshot to be a message";
+
+    // another board size
+    encoded.clear();
+    SnapshotCodec::encode("FF\n", 1, 2, encoded);
+    frame = "SNAPSHOT 2 1 " + std::to_string(encoded.size()) + "\n" + encoded;
+    mirror.receive(frame.data(), frame.size());
+    EXPECT_EQ('-', mirror.tile(0, 0)) << "Expected snapshot of another board to be ignored";
+    EXPECT_EQ("", render(mirror));
+}
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "board_implementation.h"
+#include "board_solver.h"
+
+namespace {
+
+TEST(BoardSolverTest, ConstructorTest) {
+    ASSERT_NO_THROW(BoardSolver(3, 4)) << "Constructor must succeed if the parameters are valid";
+    EXPECT_THROW(BoardSolver(0, 4), std::domain_error) << "Expected constructor to throw error when one of the size is non positive";
+}
+
+TEST(BoardSolverTest, SingleConstraintTest) {
+    /**
+     * Testing strategy
+     * partition on deduction:
+     *      - nothing dug, nothing known
+     *      - number satisfied, neighbors are safe
+     *      - number equal to unknown neighbors, neighbors are mines
+     */
+    BoardImplementation board{std::string{"EEE\nEEE\nEEB"}};
+    BoardSolver solver{&board};
+    int y = -1;
+    int x = -1;
+
+    // nothing dug
+    solver.update(&board);
+    EXPECT_FALSE(solver.hint(y, x)) << "Expected no hint before anything is dug";
+    EXPECT_EQ(TILE_KNOWLEDGE::UNKNOWN, solver.knowledge(2, 2));
+
+    // a zero floods the board, the last tile is surrounded by ones
+    board.dig(0, 0);
+    solver.update(&board);
+    EXPECT_EQ(TILE_KNOWLEDGE::MINE, solver.knowledge(2, 2)) << "Expected single unknown neighbor of a 1 to be a mine";
+    EXPECT_EQ(TILE_KNOWLEDGE::SAFE, solver.knowledge(0, 0)) << "Expected dug tile to be safe";
+    EXPECT_FALSE(solver.hint(y, x)) << "Expected no hint when only mines are left";
+}
+
+TEST(BoardSolverTest, PairConstraintTest) {
+    // the 1-2 pattern on the bottom row: the 1 at (1,0) sees two unknowns with one mine, the 2 at (1,1)
+    // sees the same two plus (2,2), so (2,2) must be a mine; the 1 at (1,2) then clears (2,3)
+    BoardImplementation board{std::string{"EEEE\nEEEE\nBEBE"}};
+    BoardSolver solver{&board};
+    board.dig(0, 0);
+    solver.update(&board);
+
+    EXPECT_EQ(TILE_KNOWLEDGE::MINE, solver.knowledge(2, 2)) << "Expected subset rule to find the mine";
+    EXPECT_EQ(TILE_KNOWLEDGE::SAFE, solver.knowledge(2, 3)) << "Expected mine to clear the last tile";
+
+    int y = -1;
+    int x = -1;
+    ASSERT_TRUE(solver.hint(y, x)) << "Expected a hint when a safe tile is untouched";
+    EXPECT_EQ(2, y);
+    EXPECT_EQ(3, x);
+
+    // once dug hints are used up, only the mines are left
+    while (solver.hint(y, x)) {
+        ASSERT_TRUE(board.dig(y, x)) << "Expected hints never to be bombs";
+        solver.update(&board);
+    }
+    EXPECT_EQ(TILE_KNOWLEDGE::MINE, solver.knowledge(2, 0));
+    EXPECT_STREQ("    \n1211\n-2-1", board.print().get()) << "Expected every empty tile to be dug";
+}
+
+TEST(BoardSolverTest, NoGuessTest) {
+    /**
+     * Testing strategy
+     * partition on board:
+     *      - solvable from the first dig
+     *      - needs a guess
+     *      - first dig hits a bomb
+     */
+    BoardImplementation solvable{std::string{"EEEE\nEEEE\nBEBE"}};
+    EXPECT_TRUE(BoardSolver::is_no_guess(&solvable, 0, 0)) << "Expected board to be solvable without guessing";
+
+    // a single 1 next to three untouched tiles can never be resolved
+    BoardImplementation guess{std::string{"EE\nBE"}};
+    EXPECT_FALSE(BoardSolver::is_no_guess(&guess, 0, 1)) << "Expected board to need a guess";
+
+    BoardImplementation bomb{std::string{"BE\nEE"}};
+    EXPECT_FALSE(BoardSolver::is_no_guess(&bomb, 0, 0)) << "Expected failure when the first dig is a bomb";
+}
+
+TEST(BoardSolverTest, IncrementalTest) {
+    // solving move by move gives the same deductions as solving the final view at once
+    BoardImplementation board{100, 100, 1500, 3};
+    BoardSolver incremental{&board};
+    std::unordered_map<std::string, std::unique_ptr<char []>> debug = board.print_debug();
+    for (int tile = 0; tile < 100 * 100; tile++) {
+        if (debug["back"][tile / 100 * 101 + tile % 100] == 'E' && debug["boundaries"][tile / 100 * 101 + tile % 100] == '0') {
+            board.dig(tile / 100, tile % 100);
+            break;
+        }
+    }
+
+    int y;
+    int x;
+    incremental.update(&board);
+    while (incremental.hint(y, x)) {
+        ASSERT_TRUE(board.dig(y, x)) << "Expected hints never to be bombs";
+        incremental.update(&board);
+    }
+
+    BoardSolver at_once{&board};
+    at_once.update(&board);
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j < 100; j++) {
+            EXPECT_EQ(at_once.knowledge(i, j) == TILE_KNOWLEDGE::MINE, incremental.knowledge(i, j) == TILE_KNOWLEDGE::MINE);
+        }
+    }
+}
+
+TEST(BoardSolverTest, DugTest) {
+    /**
+     * Testing strategy
+     * partition on reported digs:
+     *      - every dig reported right after it
+     *      - digs reported late, after later digs, in reverse order
+     *      - a dig of a tile already dug
+     */
+    BoardImplementation board{100, 100, 1500, 3};
+    BoardSolver fed{&board};
+    std::unordered_map<std::string, std::unique_ptr<char []>> debug = board.print_debug();
+    for (int tile = 0; tile < 100 * 100; tile++) {
+        if (debug["back"][tile / 100 * 101 + tile % 100] == 'E' && debug["boundaries"][tile / 100 * 101 + tile % 100] == '0') {
+            board.dig(tile / 100, tile % 100);
+            fed.dug(&board, tile / 100, tile % 100);
+            fed.dug(&board, tile / 100, tile % 100);
+            break;
+        }
+    }
+
+    int y;
+    int x;
+    int late = 0;
+    while (fed.hint(y, x)) {
+        ASSERT_TRUE(board.dig(y, x)) << "Expected hints never to be bombs";
+
+        // every other move a second player digs another safe tile before the first dig is reported
+        int other = -1;
+        std::shared_ptr<const char[]> shown = board.print();
+        for (int tile = 0; tile < 100 * 100 && late % 2 == 0 && other < 0; tile++) {
+            bool safe = fed.knowledge(tile / 100, tile % 100) == TILE_KNOWLEDGE::SAFE;
+            if (safe && shown[tile / 100 * 101 + tile % 100] == '-') other = tile;
+        }
+        late++;
+        if (other >= 0) {
+            ASSERT_TRUE(board.dig(other / 100, other % 100)) << "Expected deduced safe tiles never to be bombs";
+            fed.dug(&board, other / 100, other % 100);
+        }
+        fed.dug(&board, y, x);
+    }
+
+    BoardSolver at_once{&board};
+    at_once.update(&board);
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j < 100; j++) {
+            EXPECT_EQ(at_once.knowledge(i, j), fed.knowledge(i, j)) << "Expected the same deductions at " << i << " " << j;
+        }
+    }
+}
+
+TEST(BoardSolverTest, FlaggedHintTest) {
+    /**
+     * Testing strategy
+     * partition on a tile deduced safe:
+     *      - flagged, reported with marked()
+     *      - flagged before update()
+     *      - deflagged again
+     */
+    BoardImplementation board{100, 100, 1500, 3};
+    BoardImplementation unplayed{board};
+    BoardSolver solver{&board};
+    std::unordered_map<std::string, std::unique_ptr<char []>> debug = board.print_debug();
+    int first = -1;
+    for (int tile = 0; tile < 100 * 100 && first < 0; tile++) {
+        if (debug["back"][tile / 100 * 101 + tile % 100] == 'E' && debug["boundaries"][tile / 100 * 101 + tile % 100] == '0') first = tile;
+    }
+    ASSERT_LE(0, first);
+    board.dig(first / 100, first % 100);
+    solver.dug(&board, first / 100, first % 100);
+
+    int flagged_y;
+    int flagged_x;
+    ASSERT_TRUE(solver.hint(flagged_y, flagged_x)) << "Expected a safe tile next to the first dig";
+    board.flag(flagged_y, flagged_x);
+    solver.marked(&board, flagged_y, flagged_x);
+
+    int y;
+    int x;
+    for (int moves = 0; solver.hint(y, x); moves++) {
+        ASSERT_LT(moves, 100 * 100) << "Expected every hint to be played once";
+        ASSERT_FALSE(y == flagged_y && x == flagged_x) << "Expected a flagged tile never to be offered";
+        ASSERT_EQ('-', board.print()[y * 101 + x]) << "Expected hints to be untouched tiles";
+        ASSERT_TRUE(board.dig(y, x));
+        solver.dug(&board, y, x);
+    }
+
+    board.deflag(flagged_y, flagged_x);
+    solver.marked(&board, flagged_y, flagged_x);
+    bool offered = false;
+    while (!offered && solver.hint(y, x)) {
+        offered = y == flagged_y && x == flagged_x;
+        ASSERT_TRUE(board.dig(y, x));
+        solver.dug(&board, y, x);
+    }
+    EXPECT_TRUE(offered) << "Expected a deflagged tile to be offered again";
+
+    // a flag read by update() is skipped too, the game stops short of solving
+    unplayed.flag(flagged_y, flagged_x);
+    EXPECT_FALSE(BoardSolver::is_no_guess(&unplayed, first / 100, first % 100))
+        << "Expected a flagged safe tile to be left untouched";
+}
+}
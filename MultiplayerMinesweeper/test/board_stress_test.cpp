@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_implementation.h"
+#include "board_invariants.h"
+
+namespace {
+
+#define THREAD_COUNT 8
+
+/**
+ * Run task(thread_index) on THREAD_COUNT threads released at the same time.
+ */
+template<typename F>
+void run_together(F task) {
+    std::atomic<int> waiting{THREAD_COUNT};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&, t]() {
+            waiting--;
+            while (waiting.load() > 0) std::this_thread::yield();
+            task(t);
+        });
+    }
+    for (std::thread& thread: threads) thread.join();
+}
+
+TEST(BoardStressTest, SameTileTest) {
+    /**
+     * Testing strategy
+     * partition on the tile dug by every thread at once:
+     *      - bomb
+     *      - empty tile starting a flood fill
+     *
+     * partition on concurrent operations:
+     *      - dig only
+     *      - dig racing flag and deflag
+     */
+    for (int round = 0; round < 200; round++) {
+        // bomb, dig only
+        BoardImplementation board{std::string{"EEE\nEBE\nEEE"}};
+        std::atomic<int> booms{0};
+        run_together([&](int) {
+            if (!board.dig(1, 1)) booms++;
+        });
+        ASSERT_EQ(1, booms.load()) << "Expected a bomb to explode once in round " << round;
+        ASSERT_EQ("", check_board_invariants(board)) << "in round " << round;
+
+        // empty tile, dig racing flag and deflag
+        BoardImplementation flood{std::string{"EEEEE\nEEEEE\nEEEEB"}};
+        run_together([&](int t) {
+            if (t % 2 == 0) flood.dig(0, 0);
+            else if (t % 4 == 1) flood.flag(0, 1);
+            else flood.deflag(0, 1);
+        });
+        ASSERT_EQ("", check_board_invariants(flood)) << "in round " << round;
+    }
+}
+
+TEST(BoardStressTest, RandomOperationsTest) {
+    /**
+     * Testing strategy
+     * partition on operations: random mixes of dig, flag, deflag and print from every thread
+     * partition on board: bombs scattered, bombs dense
+     */
+    const int bomb_counts[] = {300, 1500};
+    for (int bomb_count: bomb_counts) {
+        for (uint64_t seed = 0; seed < 4; seed++) {
+            BoardImplementation board = BoardImplementation(50, 50, bomb_count, seed);
+            std::vector<char> buffer(board.print_length());
+            run_together([&](int t) {
+                std::mt19937 random(seed * THREAD_COUNT + t);
+                std::vector<char> local(board.print_length());
+                for (int i = 0; i < 5000; i++) {
+                    int y = random() % 50;
+                    int x = random() % 50;
+                    int operation = random() % 10;
+                    if (operation < 4) board.dig(y, x);
+                    else if (operation < 6) board.flag(y, x);
+                    else if (operation < 8) board.deflag(y, x);
+                    else if (operation < 9) board.print(local.data(), local.size());
+                    else board.print();
+                }
+            });
+            ASSERT_EQ("", check_board_invariants(board)) << "with " << bomb_count << " bombs and seed " << seed;
+        }
+    }
+}
+}
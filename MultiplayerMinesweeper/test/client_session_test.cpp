@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "board_implementation.h"
+#include "board_solver.h"
+#include "client_session.h"
+#include "game_over_signal.h"
+#include "rate_limiter.h"
+#include "snapshot_cache.h"
+#include "spectator_feed.h"
+
+namespace {
+
+/**
+ * A board and the server state its sessions share, recording what sessions write.
+ */
+struct TestRoom {
+    BoardImplementation board{std::string{"EEB\nEEE"}};
+    BoardSolver solver{&board};
+    SnapshotCache snapshots{&board};
+    SpectatorFeed feed{&board, 10};
+    TokenBucket bucket{1e6, 1000};
+    std::atomic<uint64_t> throttled{0};
+    GameOverSignal game_over{};
+    std::string output;
+    bool failing = false;
+
+    ClientSession::Room room() {
+        return ClientSession::Room{&board, &solver, &snapshots, &feed, &bucket, &throttled, &game_over};
+    }
+
+    ClientSession::Writer writer() {
+        return [this](const char *data, int length) {
+            if (failing) return false;
+            output.append(data, length);
+            return true;
+        };
+    }
+};
+
+/**
+ * Deliver bytes to the session in reads of at most chunk bytes.
+ */
+void deliver(ClientSession& session, const std::string& bytes, int chunk) {
+    for (size_t sent = 0; sent < bytes.size() && session.connected() && !session.spectator();) {
+        int read_len = std::min({chunk, (int) (bytes.size() - sent), session.receive_capacity()});
+        memcpy(session.receive_buffer(), bytes.data() + sent, read_len);
+        session.received(read_len);
+        sent += read_len;
+    }
+}
+
+TEST(ClientSessionTest, LinesTest) {
+    /**
+     * Testing strategy
+     * partition on lines per read:
+     *      - a line split across reads, several lines in one read
+     *
+     * partition on line length:
+     *      - fits the receive buffer, longer than the receive buffer
+     */
+    TestRoom test{};
+    ClientSession session{test.room(), test.writer(), 1e6, 1000};
+    ASSERT_TRUE(session.greet());
+    EXPECT_EQ(
+        "Welcome to Minesweeper. Board: 3 columns by 2 rows. Type 'help' for help.\n",
+        test.output
+    ) << "Expected the greeting";
+
+    // a line split across reads
+    test.output.clear();
+    deliver(session, "lo", 2);
+    EXPECT_EQ("", test.output) << "Expected no reply before the line is complete";
+    deliver(session, "ok\n", 3);
+    EXPECT_EQ("---\n---\n", test.output) << "Expected the board once the line is complete";
+
+    // several lines in one read
+    test.output.clear();
+    deliver(session, "flag 0 0\ndeflag 0 0\n", 64);
+    EXPECT_EQ("F--\n---\n---\n---\n", test.output) << "Expected a reply per line in order";
+
+    // the tail of an over-long line must not be read as a command
+    test.output.clear();
+    std::string over_long(3 * session.receive_capacity(), ' ');
+    deliver(session, over_long + "bye\nlook\n", 100);
+    EXPECT_TRUE(session.connected()) << "Expected an over-long line discarded up to its end";
+    EXPECT_EQ("---\n---\n", test.output) << "Expected the line after an over-long line handled";
+}
+
+TEST(ClientSessionTest, RequestsTest) {
+    /**
+     * Testing strategy
+     * partition on request:
+     *      - within the rate limit, throttled by the client's limit, throttled by the room's limit
+     *      - spectate, bye, flag, dig of a bomb
+     *      - write fails
+     */
+    TestRoom test{};
+    ClientSession limited{test.room(), test.writer(), 1e-3, 2};
+    deliver(limited, "look\nhelp\nlook\nlook\n", 64);
+    EXPECT_EQ(1u, test.throttled.load()) << "Expected the request past the burst throttled";
+    EXPECT_NE(std::string::npos, test.output.find("THROTTLED\n")) << "Expected a throttled reply";
+    EXPECT_TRUE(limited.connected()) << "Expected throttling not to close the connection";
+
+    // a client refused by the room keeps its token for its next request
+    TokenBucket tight_bucket{1e-3, 1};
+    ClientSession::Room tight = test.room();
+    tight.bucket = &tight_bucket;
+    ClientSession first{tight, test.writer(), 1e-3, 1};
+    ClientSession second{tight, test.writer(), 1e-3, 1};
+    deliver(first, "look\n", 64);
+    deliver(second, "look\n", 64);
+    EXPECT_EQ(2u, test.throttled.load()) << "Expected the room to throttle the second client";
+    tight_bucket.give_back();
+    deliver(second, "look\n", 64);
+    EXPECT_EQ(2u, test.throttled.load()) << "Expected the client's token not spent on a request the room refused";
+
+    ClientSession watching{test.room(), test.writer(), 1e6, 1000};
+    test.output.clear();
+    deliver(watching, "spectate\nlook\n", 64);
+    EXPECT_TRUE(watching.spectator()) << "Expected the session to become a spectator";
+    EXPECT_EQ("", test.output) << "Expected no line handled after spectate";
+
+    ClientSession leaving{test.room(), test.writer(), 1e6, 1000};
+    deliver(leaving, "bye\n", 64);
+    EXPECT_FALSE(leaving.connected()) << "Expected bye to close the connection";
+
+    ClientSession losing{test.room(), test.writer(), 1e6, 1000};
+    test.output.clear();
+    deliver(losing, "flag 0 0\n", 64);
+    EXPECT_FALSE(test.game_over.raised()) << "Expected no broadcast while the game is in progress";
+    deliver(losing, "dig 2 0\nlook\n", 64);
+    EXPECT_FALSE(losing.connected()) << "Expected digging a bomb to close the connection";
+    EXPECT_EQ("F--\n---\nBOOM!\n", test.output) << "Expected no line handled after the connection closed";
+    EXPECT_TRUE(test.game_over.raised()) << "Expected the dig ending the game to broadcast it";
+
+    ClientSession failing{test.room(), test.writer(), 1e6, 1000};
+    test.failing = true;
+    deliver(failing, "look\n", 64);
+    EXPECT_FALSE(failing.connected()) << "Expected a failed write to close the connection";
+}
+}
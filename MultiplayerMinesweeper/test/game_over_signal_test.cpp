@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <thread>
+
+#include "game_over_signal.h"
+
+namespace {
+
+bool readable(const GameOverSignal& signal, int timeout_ms) {
+    struct pollfd pfd{};
+    pfd.fd = signal.fd();
+    pfd.events = POLLIN;
+    return poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+TEST(GameOverSignalTest, RaiseTest) {
+    /**
+     * Testing strategy
+     * partition on signal:
+     *      - not raised, raised once, raised again
+     *
+     * partition on pollers:
+     *      - polling before the raise, polling after the raise, several pollers
+     */
+    GameOverSignal signal{};
+    EXPECT_FALSE(signal.raised());
+    EXPECT_FALSE(readable(signal, 0)) << "Expected no wake up before the game is over";
+
+    // a poller blocked before the raise is woken up by it
+    std::thread waiter([&signal]() {
+        EXPECT_TRUE(readable(signal, 10000)) << "Expected a blocked poller to wake up";
+    });
+    signal.raise();
+    waiter.join();
+    EXPECT_TRUE(signal.raised());
+
+    // every later poller sees it too, a second raise changes nothing
+    signal.raise();
+    for (int i = 0; i < 3; i++) EXPECT_TRUE(readable(signal, 0)) << "Expected the signal to stay raised for poller " << i;
+}
+}
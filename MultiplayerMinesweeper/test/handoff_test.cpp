@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "handoff.h"
+
+namespace {
+
+TEST(HandoffTest, SendReceiveTest) {
+    /**
+     * Testing strategy
+     * partition on descriptors:
+     *      - none
+     *      - several
+     *
+     * partition on state:
+     *      - empty
+     *      - larger than a socket buffer
+     */
+    int sockets[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+
+    // no descriptors, empty state
+    std::string state = "unchanged";
+    Handoff::send(sockets[0], {}, "");
+    EXPECT_TRUE(Handoff::receive(sockets[1], state).empty()) << "Expected no descriptors";
+    EXPECT_EQ("", state);
+
+    // several descriptors, large state sent from another thread so the buffer can drain
+    int pipe_fds[2];
+    ASSERT_EQ(0, pipe(pipe_fds));
+    std::string sent(1 << 20, 'x');
+    sent[12345] = 'y';
+    std::thread sender([&]() { Handoff::send(sockets[0], {pipe_fds[0], pipe_fds[1]}, sent); });
+    std::vector<int> fds = Handoff::receive(sockets[1], state);
+    sender.join();
+    ASSERT_EQ(2u, fds.size()) << "Expected every descriptor to be received";
+    EXPECT_EQ(sent, state) << "Expected state to be received intact";
+
+    // the received descriptors are new descriptors of the same pipe
+    EXPECT_NE(pipe_fds[1], fds[1]);
+    ASSERT_EQ(1, write(fds[1], "!", 1));
+    char received = 0;
+    ASSERT_EQ(1, read(pipe_fds[0], &received, 1));
+    EXPECT_EQ('!', received) << "Expected received descriptor to refer to the sent pipe";
+
+    for (int fd: fds) close(fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(HandoffTest, ListenConnectTest) {
+    std::string path = "/tmp/handoff_test_" + std::to_string(getpid()) + ".sock";
+    EXPECT_EQ(-1, Handoff::connect(path)) << "Expected no predecessor before listening";
+
+    int listener = Handoff::listen(path);
+    int predecessor = Handoff::connect(path);
+    ASSERT_LE(0, predecessor) << "Expected connect to find the listening predecessor";
+    int successor = accept(listener, nullptr, nullptr);
+    ASSERT_LE(0, successor);
+
+    // a second listen replaces the stale socket
+    close(listener);
+    listener = Handoff::listen(path);
+    EXPECT_LE(0, listener);
+
+    close(listener);
+    close(successor);
+    close(predecessor);
+    unlink(path.c_str());
+    EXPECT_THROW(Handoff::listen(std::string(200, 'a')), std::runtime_error) << "Expected too long path to be rejected";
+}
+}
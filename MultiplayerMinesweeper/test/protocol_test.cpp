@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "arena.h"
+#include "board_implementation.h"
+#include "protocol.h"
+
+namespace {
+
+Protocol::Request parse(const char *message) {
+    return Protocol::parse(message, strlen(message));
+}
+
+TEST(ProtocolTest, ParseTest) {
+    /**
+     * Testing strategy
+     * partition on command:
+     *      - without position (look, help, bye)
+     *      - with position (dig, flag, deflag)
+     *      - unknown
+     *
+     * partition on format:
+     *      - well formed
+     *      - extra whitespace and line terminator
+     *      - missing or malformed arguments
+     *      - trailing garbage
+     */
+
+    // without position, well formed
+    EXPECT_EQ(Protocol::COMMAND::LOOK, parse("look").command);
+    EXPECT_EQ(Protocol::COMMAND::HELP, parse("help").command);
+    EXPECT_EQ(Protocol::COMMAND::BYE, parse("bye").command);
+    EXPECT_EQ(Protocol::COMMAND::SNAPSHOT, parse("snapshot").command);
+
+    // with position, extra whitespace and line terminator
+    Protocol::Request request = parse("  dig  3   4\r\n");
+    EXPECT_EQ(Protocol::COMMAND::DIG, request.command);
+    EXPECT_EQ(3, request.x) << "Expected first argument to be the column";
+    EXPECT_EQ(4, request.y) << "Expected second argument to be the row";
+
+    request = parse("flag 0 -1");
+    EXPECT_EQ(Protocol::COMMAND::FLAG, request.command);
+    EXPECT_EQ(-1, request.y) << "Expected negative positions to be parsed";
+    EXPECT_EQ(Protocol::COMMAND::DEFLAG, parse("deflag 9 9").command);
+
+    // missing or malformed arguments
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("dig 3").command);
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("dig x 3").command);
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("flag 3a 3").command);
+
+    // trailing garbage and unknown commands
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("look around").command);
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("lookup").command);
+    EXPECT_EQ(Protocol::COMMAND::INVALID, parse("").command);
+}
+
+TEST(ProtocolTest, RespondTest) {
+    BoardImplementation board = BoardImplementation(10, 10, 10, 0);
+    Arena arena{256};
+
+    Protocol::Frame frame = Protocol::respond(&board, parse("look"), arena);
+    std::string expected = std::string(board.print().get()) + "\n";
+    EXPECT_EQ(expected, std::string(frame.data, frame.length)) << "Expected look to reply with the board";
+    EXPECT_FALSE(frame.close_connection);
+
+    frame = Protocol::respond(&board, parse("flag 5 0"), arena);
+    EXPECT_EQ('F', frame.data[5]) << "Expected flag to be applied before replying";
+
+    frame = Protocol::respond(&board, parse("bye"), arena);
+    EXPECT_TRUE(frame.close_connection) << "Expected bye to close the connection";
+
+    frame = Protocol::respond(&board, parse("hint"), arena);
+    EXPECT_EQ("hint none\n", std::string(frame.data, frame.length)) << "Expected no hint without a solver";
+
+    BoardImplementation solvable{std::string{"EEEE\nEEEE\nBEBE"}};
+    BoardSolver solver{&solvable};
+    Protocol::respond(&solvable, parse("dig 0 0"), arena, &solver);
+    frame = Protocol::respond(&solvable, parse("hint"), arena, &solver);
+    EXPECT_EQ("hint 3 2\n", std::string(frame.data, frame.length)) << "Expected hint to name a safe tile as X Y";
+    Protocol::respond(&solvable, parse("flag 3 2"), arena, &solver);
+    frame = Protocol::respond(&solvable, parse("hint"), arena, &solver);
+    EXPECT_NE("hint 3 2\n", std::string(frame.data, frame.length)) << "Expected a flagged tile not to be offered";
+    Protocol::respond(&solvable, parse("deflag 3 2"), arena, &solver);
+    frame = Protocol::respond(&solvable, parse("hint"), arena, &solver);
+    EXPECT_EQ("hint 3 2\n", std::string(frame.data, frame.length)) << "Expected a deflagged tile to be offered again";
+
+    frame = Protocol::respond(&board, parse("nonsense"), arena);
+    EXPECT_FALSE(frame.close_connection) << "Expected invalid message to reply with help";
+    EXPECT_LT(0, frame.length);
+}
+
+TEST(ProtocolTest, AnnounceTest) {
+    BoardImplementation board{std::string{"EEB\nEEE"}};
+    EXPECT_EQ(0, Protocol::announce(&board).length) << "Expected no announcement while the game is in progress";
+
+    board.dig(1, 0);
+    board.dig(1, 2);
+    Protocol::Frame frame = Protocol::announce(&board);
+    EXPECT_EQ("GAME WON\n", std::string(frame.data, frame.length));
+
+    board.dig(0, 2);
+    frame = Protocol::announce(&board);
+    EXPECT_EQ("GAME LOST\n", std::string(frame.data, frame.length));
+}
+
+TEST(ProtocolTest, GreetTest) {
+    BoardImplementation board{std::string{"EEB\nEEE"}};
+    Arena arena{256};
+
+    Protocol::Frame frame = Protocol::greet(&board, arena);
+    EXPECT_EQ(
+        "Welcome to Minesweeper. Board: 3 columns by 2 rows. Type 'help' for help.\n",
+        std::string(frame.data, frame.length)
+    ) << "Expected greeting to give the board size as columns then rows";
+    EXPECT_FALSE(frame.close_connection);
+}
+
+TEST(ProtocolTest, ThrottledTest) {
+    Protocol::Frame frame = Protocol::throttled();
+    EXPECT_EQ("THROTTLED\n", std::string(frame.data, frame.length));
+    EXPECT_FALSE(frame.close_connection) << "Expected throttling not to close the connection";
+}
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "rate_limiter.h"
+
+namespace {
+
+const int64_t SECOND = 1000000000LL;
+
+TEST(RateLimiterTest, ConstructorTest) {
+    ASSERT_NO_THROW(TokenBucket(10, 5)) << "Constructor must succeed if rate and burst are positive";
+    EXPECT_THROW(TokenBucket(0, 5), std::domain_error) << "Expected constructor to throw error when rate is not positive";
+    EXPECT_THROW(TokenBucket(10, 0), std::domain_error) << "Expected constructor to throw error when burst is not positive";
+    EXPECT_THROW(AdmissionControl(-1), std::domain_error) << "Expected constructor to throw error when threshold is negative";
+}
+
+TEST(RateLimiterTest, TokenBucketTest) {
+    /**
+     * Testing strategy
+     * partition on bucket:
+     *      - full, empty, partially refilled, refilled past capacity, token given back
+     *
+     * partition on callers:
+     *      - one thread, several threads at once
+     */
+    TokenBucket bucket{10, 5};
+    int64_t now = 100 * SECOND;
+
+    // full bucket drains after exactly burst tokens
+    for (int i = 0; i < 5; i++) EXPECT_TRUE(bucket.try_acquire(now)) << "Expected token " << i << " of the burst";
+    EXPECT_FALSE(bucket.try_acquire(now)) << "Expected empty bucket to reject";
+    EXPECT_EQ(1u, bucket.rejected());
+
+    // partially refilled, one token per 100 ms
+    EXPECT_TRUE(bucket.try_acquire(now + SECOND / 10)) << "Expected one token after one interval";
+    EXPECT_FALSE(bucket.try_acquire(now + SECOND / 10));
+
+    // refilled past capacity holds burst tokens only
+    now += 100 * SECOND;
+    for (int i = 0; i < 5; i++) EXPECT_TRUE(bucket.try_acquire(now));
+    EXPECT_FALSE(bucket.try_acquire(now)) << "Expected idle time not to grow the bucket past its burst";
+    EXPECT_EQ(3u, bucket.rejected());
+
+    // a token given back can be taken again, a full bucket stays capped at its burst
+    bucket.give_back();
+    EXPECT_TRUE(bucket.try_acquire(now)) << "Expected the token given back to be taken again";
+    EXPECT_FALSE(bucket.try_acquire(now));
+    now += 100 * SECOND;
+    bucket.give_back();
+    for (int i = 0; i < 5; i++) EXPECT_TRUE(bucket.try_acquire(now));
+    EXPECT_FALSE(bucket.try_acquire(now)) << "Expected a token given back to a full bucket not to grow it";
+    EXPECT_EQ(5u, bucket.rejected());
+
+    // several threads at once take exactly burst tokens
+    TokenBucket shared{1, 1000};
+    std::atomic<int> taken{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 500; i++) {
+                if (shared.try_acquire(now)) taken++;
+            }
+        });
+    }
+    for (std::thread& thread: threads) thread.join();
+    EXPECT_EQ(1000, taken.load()) << "Expected concurrent callers never to take more than the burst";
+    EXPECT_EQ(3000u, shared.rejected());
+}
+
+TEST(RateLimiterTest, AdmissionControlTest) {
+    /**
+     * Testing strategy
+     * partition on smoothed lag:
+     *      - below threshold, above threshold, back below threshold
+     */
+    AdmissionControl admission{50000000};
+
+    // below threshold
+    admission.record_lag(-5);
+    admission.record_lag(1000);
+    EXPECT_TRUE(admission.admit()) << "Expected small lag to admit";
+
+    // above threshold after a sustained lag
+    for (int i = 0; i < 50; i++) admission.record_lag(200000000);
+    EXPECT_LT(50000000, admission.lag());
+    EXPECT_FALSE(admission.admit()) << "Expected sustained lag to shed";
+    EXPECT_FALSE(admission.admit());
+    EXPECT_EQ(2u, admission.shed());
+
+    // back below threshold once the lag is gone
+    for (int i = 0; i < 50; i++) admission.record_lag(0);
+    EXPECT_TRUE(admission.admit()) << "Expected recovered lag to admit";
+    EXPECT_EQ(2u, admission.shed());
+}
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_implementation.h"
+#include "snapshot_cache.h"
+#include "snapshot_codec.h"
+
+namespace {
+
+TEST(SnapshotCacheTest, GetTest) {
+    /**
+     * Testing strategy
+     * partition on board since the last get:
+     *      - never encoded
+     *      - unchanged
+     *      - changed
+     *
+     * partition on callers:
+     *      - one, several at once
+     */
+    BoardImplementation board = BoardImplementation(30, 20, 50, 1);
+    SnapshotCache cache{&board};
+
+    // never encoded
+    std::shared_ptr<const std::string> frame = cache.get();
+    EXPECT_EQ(1u, cache.encodings());
+    size_t header_end = frame->find('\n');
+    ASSERT_NE(std::string::npos, header_end);
+    std::string expected_header = "SNAPSHOT 20 30 " + std::to_string(frame->size() - header_end - 1);
+    EXPECT_EQ(expected_header, frame->substr(0, header_end)) << "Expected header with columns, rows and encoded length";
+
+    // unchanged board shares the frame
+    EXPECT_EQ(frame, cache.get()) << "Expected the cached frame while the board is unchanged";
+    EXPECT_EQ(1u, cache.encodings());
+
+    // changed board is encoded again
+    board.flag(3, 4);
+    std::shared_ptr<const std::string> flagged = cache.get();
+    EXPECT_NE(frame, flagged) << "Expected a new frame after the board changed";
+    EXPECT_EQ(2u, cache.encodings());
+    std::string view(30 * 21, '?');
+    ASSERT_TRUE(SnapshotCodec::decode(flagged->data() + flagged->find('\n') + 1, flagged->size() - flagged->find('\n') - 1, 30, 20, &view[0]));
+    EXPECT_EQ('F', view[3 * 21 + 4]) << "Expected the new frame to hold the change";
+
+    // several callers at once share one encoding
+    board.deflag(3, 4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) threads.emplace_back([&]() { cache.get(); });
+    for (std::thread& thread: threads) thread.join();
+    EXPECT_EQ(3u, cache.encodings()) << "Expected a join storm to encode once";
+}
+}
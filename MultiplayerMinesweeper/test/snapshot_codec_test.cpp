@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "board_implementation.h"
+#include "snapshot_codec.h"
+
+namespace {
+
+std::string round_trip(const std::string& view, int rows, int columns, std::string& encoded) {
+    encoded.clear();
+    SnapshotCodec::encode(view.data(), rows, columns, encoded);
+    std::string decoded(rows * (columns + 1), '?');
+    EXPECT_TRUE(SnapshotCodec::decode(encoded.data(), encoded.size(), rows, columns, &decoded[0]));
+    return decoded;
+}
+
+TEST(SnapshotCodecTest, RoundTripTest) {
+    /**
+     * Testing strategy
+     * partition on runs:
+     *      - single tiles
+     *      - runs up to 15 tiles, longer runs needing a varint
+     *      - runs crossing rows
+     *
+     * partition on tiles:
+     *      - untouched, flagged, dug empty, numbers
+     */
+    std::string encoded;
+
+    // single tiles of every kind
+    std::string view = "-F 1\n2345\n678-\n";
+    EXPECT_EQ(view, round_trip(view, 3, 4, encoded)) << "Expected every tile to survive encoding";
+    EXPECT_EQ(12u, encoded.size()) << "Expected one byte per single tile";
+
+    // runs crossing rows
+    view = "----\n--FF\nFFFF\n";
+    EXPECT_EQ(view, round_trip(view, 3, 4, encoded));
+    EXPECT_EQ(2u, encoded.size()) << "Expected runs to continue across rows";
+
+    // long runs need a varint
+    int side = 2000;
+    std::string large(side * (side + 1), '-');
+    for (int i = 0; i < side; i++) large[(i + 1) * (side + 1) - 1] = '\n';
+    large[side * 1000 + 7] = 'F';
+    EXPECT_EQ(large, round_trip(large, side, side, encoded)) << "Expected large board to survive encoding";
+    EXPECT_GT(16u, encoded.size()) << "Expected a mostly untouched large board to take a few bytes";
+
+    // a real board representation
+    BoardImplementation board = BoardImplementation(40, 60, 200, 3);
+    board.dig(20, 30);
+    board.flag(0, 0);
+    std::shared_ptr<const char[]> printed = board.print();
+    std::string printed_view{printed.get()};
+    printed_view.push_back('\n');
+    EXPECT_EQ(printed_view, round_trip(printed_view, 40, 60, encoded)) << "Expected printed board to survive encoding";
+}
+
+TEST(SnapshotCodecTest, MalformedTest) {
+    /**
+     * Testing strategy
+     * partition on input:
+     *      - unknown tile to encode
+     *      - too few or too many tiles, truncated varint, unknown symbol
+     */
+    std::string encoded;
+    EXPECT_THROW(SnapshotCodec::encode("-X\n", 1, 2, encoded), std::domain_error) << "Expected unknown tile to be rejected";
+
+    std::vector<char> view(3 * 5);
+    SnapshotCodec::encode("----\n----\n----\n", 3, 4, encoded);
+    EXPECT_FALSE(SnapshotCodec::decode(encoded.data(), encoded.size(), 4, 4, view.data())) << "Expected too few tiles to fail";
+    EXPECT_FALSE(SnapshotCodec::decode(encoded.data(), encoded.size(), 2, 4, view.data())) << "Expected too many tiles to fail";
+
+    const char truncated[] = {(char) 0x0f, (char) 0x80};
+    EXPECT_FALSE(SnapshotCodec::decode(truncated, 2, 3, 4, view.data())) << "Expected truncated varint to fail";
+    const char unknown[] = {(char) 0xb0};
+    EXPECT_FALSE(SnapshotCodec::decode(unknown, 1, 1, 1, view.data())) << "Expected unknown symbol to fail";
+}
+}
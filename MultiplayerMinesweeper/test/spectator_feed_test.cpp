@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "board_implementation.h"
+#include "spectator_feed.h"
+
+namespace {
+
+/**
+ * Board that counts how many times it has been rendered.
+ */
+class CountingBoard: public BoardImplementation {
+public:
+    CountingBoard(): BoardImplementation(10, 10, 10, 0) {}
+
+    using BoardImplementation::print;
+
+    int print(char *buffer, int buffer_len) noexcept override {
+        prints++;
+        return BoardImplementation::print(buffer, buffer_len);
+    }
+
+    std::atomic<int> prints{0};
+};
+
+TEST(SpectatorFeedTest, ConstructorTest) {
+    CountingBoard board;
+    ASSERT_NO_THROW(SpectatorFeed(&board, 10)) << "Constructor must succeed if the frame rate is positive";
+    EXPECT_THROW(SpectatorFeed(&board, 0), std::domain_error) << "Expected constructor to throw error when frame rate is not positive";
+}
+
+TEST(SpectatorFeedTest, WaitFrameTest) {
+    /**
+     * Testing strategy
+     * partition on published frames:
+     *      - none newer than the caller's sequence
+     *      - newer frame exists
+     *
+     * partition on feed state:
+     *      - running
+     *      - stopped
+     */
+    CountingBoard board;
+    SpectatorFeed feed{&board, 20};
+    uint64_t sequence = 0;
+
+    // not running, nothing published
+    EXPECT_EQ(nullptr, feed.wait_frame(sequence, 10)) << "Expected no frame before start";
+
+    // running, newer frame exists
+    feed.start();
+    std::shared_ptr<const std::string> frame = feed.wait_frame(sequence, 1000);
+    ASSERT_NE(nullptr, frame) << "Expected first frame right after start";
+    EXPECT_EQ(std::string(board.print().get()) + "\n", *frame) << "Expected frame to hold the board";
+    EXPECT_EQ(1, sequence);
+
+    // running, none newer
+    EXPECT_EQ(nullptr, feed.wait_frame(sequence, 100)) << "Expected no frame while the board is unchanged";
+
+    board.flag(0, 0);
+    feed.mark_dirty();
+    frame = feed.wait_frame(sequence, 1000);
+    ASSERT_NE(nullptr, frame) << "Expected a new frame after the board changed";
+    EXPECT_EQ('F', (*frame)[0]);
+
+    // stopped
+    feed.stop();
+    EXPECT_EQ(nullptr, feed.wait_frame(sequence, 1000)) << "Expected no frame after stop";
+}
+
+TEST(SpectatorFeedTest, SharedFrameTest) {
+    CountingBoard board;
+    SpectatorFeed feed{&board, 20};
+    feed.start();
+
+    const int spectator_count = 50;
+    std::vector<std::shared_ptr<const std::string>> frames(spectator_count);
+    std::vector<std::thread> spectators;
+    for (int i = 0; i < spectator_count; i++) {
+        spectators.emplace_back([&feed, &frames, i]() {
+            uint64_t sequence = 0;
+            frames[i] = feed.wait_frame(sequence, 1000);
+        });
+    }
+    for (std::thread& spectator: spectators) spectator.join();
+    feed.stop();
+
+    for (int i = 0; i < spectator_count; i++) {
+        EXPECT_EQ(frames[0].get(), frames[i].get()) << "Expected every spectator to share one frame";
+    }
+    EXPECT_EQ(1, board.prints.load()) << "Expected the board to be rendered once for every spectator";
+}
+
+TEST(SpectatorFeedTest, ThrottleTest) {
+    CountingBoard board;
+    SpectatorFeed feed{&board, 5};
+    feed.start();
+
+    // changes far more frequent than the frame rate are coalesced
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    while (std::chrono::steady_clock::now() < end) {
+        feed.mark_dirty();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    feed.stop();
+
+    EXPECT_GE(7, board.prints.load()) << "Expected at most about 5 frames in one second";
+    EXPECT_LE(2, board.prints.load()) << "Expected changes to keep producing frames";
+}
+}
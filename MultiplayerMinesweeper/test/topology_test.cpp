@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <sched.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#include "board_implementation.h"
+#include "topology.h"
+
+namespace {
+
+// from <numaif.h>
+#define MPOL_DEFAULT 0
+#define MPOL_BIND 2
+#define MPOL_F_ADDR (1 << 1)
+
+/**
+ * @return the memory policy of the page holding address, -1 if it cannot be read
+ */
+static int page_policy(void *address) {
+    int mode = -1;
+    if (syscall(SYS_get_mempolicy, &mode, nullptr, 0, address, MPOL_F_ADDR) != 0) return -1;
+    return mode;
+}
+
+TEST(TopologyTest, ParseCpuListTest) {
+    /**
+     * Testing strategy
+     * partition on list:
+     *      - empty
+     *      - single cpus, ranges, both
+     *      - trailing line terminator
+     *      - malformed
+     */
+    EXPECT_TRUE(Topology::parse_cpu_list("").empty()) << "Expected empty list";
+    EXPECT_EQ(std::vector<int>({3}), Topology::parse_cpu_list("3"));
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), Topology::parse_cpu_list("0-3"));
+    EXPECT_EQ(std::vector<int>({0, 1, 8, 10, 11}), Topology::parse_cpu_list("0-1,8,10-11\n"))
+        << "Expected sysfs format with line terminator to be parsed";
+
+    EXPECT_THROW(Topology::parse_cpu_list("a"), std::domain_error);
+    EXPECT_THROW(Topology::parse_cpu_list("3-1"), std::domain_error) << "Expected decreasing range to be rejected";
+    EXPECT_THROW(Topology::parse_cpu_list("1,"), std::domain_error);
+    EXPECT_THROW(Topology::parse_cpu_list("1;2"), std::domain_error);
+}
+
+TEST(TopologyTest, NodeTest) {
+    ASSERT_LE(1, Topology::node_count()) << "Expected at least one node";
+    EXPECT_FALSE(Topology::node_cpus(0).empty()) << "Expected node 0 to have cpus";
+}
+
+TEST(TopologyTest, PinTest) {
+    cpu_set_t original;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(original), &original));
+    int allowed = -1;
+    for (int cpu = 0; cpu < CPU_SETSIZE && allowed < 0; cpu++) {
+        if (CPU_ISSET(cpu, &original)) allowed = cpu;
+    }
+    ASSERT_LE(0, allowed);
+
+    EXPECT_TRUE(Topology::pin_current_thread({})) << "Expected empty list to do nothing";
+    ASSERT_TRUE(Topology::pin_current_thread({allowed})) << "Expected pinning to an allowed cpu to succeed";
+    EXPECT_EQ(allowed, sched_getcpu()) << "Expected the thread to run on the pinned cpu";
+    EXPECT_FALSE(Topology::pin_current_thread({-1})) << "Expected invalid cpu to be rejected";
+
+    sched_setaffinity(0, sizeof(original), &original);
+}
+
+TEST(TopologyTest, BindMemoryTest) {
+    std::vector<char> memory(1 << 16);
+    EXPECT_TRUE(Topology::bind_memory(memory.data(), memory.size(), -1)) << "Expected negative node to do nothing";
+    EXPECT_FALSE(Topology::bind_memory(memory.data(), memory.size(), Topology::node_count() + 100))
+        << "Expected missing node to fail";
+
+    BoardImplementation board = BoardImplementation(10, 10, 10, 0);
+    EXPECT_TRUE(board.place_on_node(-1)) << "Expected negative node to leave the board alone";
+}
+
+TEST(TopologyTest, BindMemoryNeighborsTest) {
+    /**
+     * Testing strategy
+     * partition on address: start of a page, inside a page
+     * partition on length: a whole page, part of a page
+     * partition on memory next to the bound range: before, after
+     */
+    long page = sysconf(_SC_PAGESIZE);
+    char *pages = (char *) mmap(nullptr, 4 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, (void *) pages);
+    for (int i = 0; i < 4; i++) pages[i * page] = 1;
+    if (page_policy(pages) != MPOL_DEFAULT) {
+        munmap(pages, 4 * page);
+        GTEST_SKIP() << "memory policies cannot be read here";
+    }
+
+    EXPECT_FALSE(Topology::bind_memory(pages + page / 2, page, 0)) << "Expected memory inside a page to be refused";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(pages)) << "Expected the page holding the refused memory to be left alone";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(pages + page)) << "Expected the page after the refused memory to be left alone";
+
+    ASSERT_TRUE(Topology::bind_memory(pages + page, page / 2, 0)) << "Expected memory starting a page to be bound";
+    EXPECT_EQ(MPOL_BIND, page_policy(pages + page)) << "Expected the page of the memory to be bound";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(pages)) << "Expected the page before to be left alone";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(pages + 2 * page)) << "Expected the page after to be left alone";
+
+    ASSERT_TRUE(Topology::bind_memory(pages + 2 * page, page, 0)) << "Expected a whole page to be bound";
+    EXPECT_EQ(MPOL_BIND, page_policy(pages + 2 * page)) << "Expected the page to be bound";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(pages + 3 * page)) << "Expected the page after to be left alone";
+    munmap(pages, 4 * page);
+
+    // the board's arrays take whole pages, a neighboring allocation keeps its policy
+    std::vector<char> before(64, 1);
+    BoardImplementation board = BoardImplementation(10, 10, 10, 0);
+    std::vector<char> after(64, 1);
+    EXPECT_TRUE(board.place_on_node(0)) << "Expected the board to be placed";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(before.data())) << "Expected an allocation made before the board to be left alone";
+    EXPECT_EQ(MPOL_DEFAULT, page_policy(after.data())) << "Expected an allocation made after the board to be left alone";
+}
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "util.h"
+
+namespace {
+
+/**
+ * Install a freshly generated self-signed certificate and its key in a server context.
+ */
+void use_self_signed_certificate(SSL_CTX *ctx) {
+    EVP_PKEY *key = EVP_EC_gen("P-256");
+    ASSERT_NE(nullptr, key);
+    X509 *certificate = X509_new();
+    ASSERT_NE(nullptr, certificate);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+    X509_set_pubkey(certificate, key);
+    X509_NAME *name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *) "localhost", -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    ASSERT_LT(0, X509_sign(certificate, key, EVP_sha256()));
+
+    EXPECT_EQ(1, SSL_CTX_use_certificate(ctx, certificate));
+    EXPECT_EQ(1, SSL_CTX_use_PrivateKey(ctx, key));
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+}
+
+TEST(UtilTest, KtlsFallbackTest) {
+    /**
+     * Testing strategy
+     * partition on kTLS support of the transport:
+     *      - unsupported, a Unix domain socket: the connection must fall back to
+     *        userspace encryption and still carry data both ways
+     */
+    SSL_CTX *server_ctx = Util::create_context(true);
+    SSL_CTX *client_ctx = Util::create_context(false);
+#ifdef SSL_OP_ENABLE_KTLS
+    EXPECT_TRUE(SSL_CTX_get_options(server_ctx) & SSL_OP_ENABLE_KTLS) << "Expected kTLS requested on server contexts";
+    EXPECT_TRUE(SSL_CTX_get_options(client_ctx) & SSL_OP_ENABLE_KTLS) << "Expected kTLS requested on client contexts";
+#endif
+    use_self_signed_certificate(server_ctx);
+
+    int sockets[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    SSL *server = SSL_new(server_ctx);
+    SSL *client = SSL_new(client_ctx);
+    SSL_set_fd(server, sockets[0]);
+    SSL_set_fd(client, sockets[1]);
+
+    int accepted = 0;
+    std::thread acceptor([&]() { accepted = SSL_accept(server); });
+    int connected = SSL_connect(client);
+    acceptor.join();
+    ASSERT_EQ(1, connected) << "Expected the handshake to succeed without kTLS";
+    ASSERT_EQ(1, accepted) << "Expected the handshake to succeed without kTLS";
+
+    EXPECT_STREQ("off", Util::ktls_status(server)) << "Expected the server to fall back to userspace encryption";
+    EXPECT_STREQ("off", Util::ktls_status(client)) << "Expected the client to fall back to userspace encryption";
+
+    char buffer[16];
+    ASSERT_EQ(5, SSL_write(client, "look\n", 5));
+    ASSERT_EQ(5, SSL_read(server, buffer, sizeof(buffer)));
+    EXPECT_EQ("look\n", std::string(buffer, 5)) << "Expected requests to reach the server";
+    ASSERT_EQ(6, SSL_write(server, "BOOM!\n", 6));
+    ASSERT_EQ(6, SSL_read(client, buffer, sizeof(buffer)));
+    EXPECT_EQ("BOOM!\n", std::string(buffer, 6)) << "Expected replies to reach the client";
+
+    SSL_free(server);
+    SSL_free(client);
+    close(sockets[0]);
+    close(sockets[1]);
+    SSL_CTX_free(server_ctx);
+    SSL_CTX_free(client_ctx);
+}
+}
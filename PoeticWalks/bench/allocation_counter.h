@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+/**
+ * Counts the heap allocations of the whole process. Linking allocation_counter.cpp
+ * replaces the global operator new and operator delete, so only the benchmarks
+ * measuring allocations link it.
+ *
+ * @return number of allocations made since the process started
+ */
+long allocationCount() noexcept;
+
+#endif
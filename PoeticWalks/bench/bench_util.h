@@ -0,0 +1,120 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * A stream of words drawn from a Zipf distribution over a vocabulary, the way
+ * word frequencies of natural text are distributed. The word of rank r is
+ * "word<r>", rank 0 being the most frequent.
+ */
+class ZipfWords {
+    /**
+     * Abstraction function:
+     *      - represents the words after the first position words of the stream
+     *        seeded by random's seed, distribution weighs rank r by 1 / (r + 1)
+     *
+     * Representation invariant:
+     *      - position >= 0
+     *
+     * Safety from rep exposure:
+     *      - all fields are private and never handed out
+     */
+
+private:
+    std::mt19937 random;
+    std::discrete_distribution<uint32_t> distribution;
+    bool mixedCase;
+    long position;
+
+public:
+    ZipfWords() = delete;
+
+    /**
+     * @param vocabularySize number of distinct words, must be positive
+     * @param seed seed of the stream, equal seeds give equal streams
+     * @param mixedCase true to capitalize every tenth word and break lines every 12 words,
+     *                  false for lower case words and lines of 20 words
+     */
+    ZipfWords(int vocabularySize, unsigned seed, bool mixedCase = false);
+
+    /**
+     * @return the rank of the next word of the stream
+     */
+    uint32_t next();
+
+    /**
+     * Append the next words of the stream to a text, separated by ' ' and '\n'.
+     *
+     * @param text the text to append to
+     * @param words number of words to append
+     */
+    void append(std::string& text, int words);
+
+    /**
+     * @param words number of words
+     * @return the next words of the stream, separated by ' ' and '\n'
+     */
+    std::string text(int words);
+};
+
+inline ZipfWords::ZipfWords(int vocabularySize, unsigned seed, bool mixedCase):
+    random{seed}, mixedCase{mixedCase}, position{0} {
+    std::vector<double> weights(vocabularySize);
+    for (int i = 0; i < vocabularySize; i++) weights[i] = 1.0 / (i + 1);
+    distribution = std::discrete_distribution<uint32_t>(weights.begin(), weights.end());
+}
+
+inline uint32_t ZipfWords::next() {
+    return distribution(random);
+}
+
+inline void ZipfWords::append(std::string& text, int words) {
+    int lineWords = mixedCase ? 12 : 20;
+    for (int i = 0; i < words; i++, position++) {
+        text.append(mixedCase && position % 10 == 0 ? "Word" : "word");
+        text.append(std::to_string(next()));
+        text.push_back(position % lineWords == lineWords - 1 ? '\n' : ' ');
+    }
+}
+
+inline std::string ZipfWords::text(int words) {
+    std::string text;
+    append(text, words);
+    return text;
+}
+
+/**
+ * @return space separated lower case words drawn from a Zipf distribution over a vocabulary
+ */
+inline std::string zipfText(int words, int vocabularySize, unsigned seed) {
+    return ZipfWords(vocabularySize, seed).text(words);
+}
+
+/**
+ * Generates a corpus of word ranks drawn from a Zipf distribution, the same for every call.
+ *
+ * @param vocabularySize number of distinct words, must be positive
+ * @param length number of words in the corpus
+ * @return the ranks of the corpus words, in [0, vocabularySize)
+ */
+inline std::vector<uint32_t> zipfCorpus(int vocabularySize, int length) {
+    ZipfWords words(vocabularySize, 7);
+    std::vector<uint32_t> corpus(length);
+    for (int i = 0; i < length; i++) corpus[i] = words.next();
+    return corpus;
+}
+
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif
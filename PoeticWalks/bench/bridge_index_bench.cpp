@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+
+#define POEM_WORDS 100000
+
+/**
+ * Times poem() per input word, best of a few poems.
+ */
+static void measurePoem(const char *name, GraphPoet& poet, const std::string& input) {
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        std::string output = poet.poem(input);
+        best = std::min(best, secondsSince(start));
+        if (output.size() < input.size()) exit(1);
+    }
+    std::cout << "    " << name << ": " << best * 1e9 / POEM_WORDS << " ns/word" << std::endl;
+}
+
+/**
+ * Measures poems whose bridges are searched, indexed and cached, on a corpus of
+ * the given number of words drawn from the given vocabulary size, 1000000 and
+ * 5000 by default, with the index built on 1 up to the given number of threads.
+ */
+int main(int argc, char *argv[]) {
+    int corpusWords = argc > 1 ? atoi(argv[1]) : 1000000;
+    int vocabularySize = argc > 2 ? atoi(argv[2]) : 5000;
+    unsigned maxThreads = argc > 3 ? atoi(argv[3]) : std::thread::hardware_concurrency();
+
+    char path[] = "/tmp/bridge_index_benchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    std::string corpus = zipfText(corpusWords, vocabularySize, 7);
+    if (write(fd, corpus.data(), corpus.size()) != (ssize_t) corpus.size()) {
+        perror("write");
+        return 1;
+    }
+    close(fd);
+
+    GraphPoet poet(new IndexedGraph(), path, true);
+    std::string input = zipfText(POEM_WORDS, vocabularySize, 11);
+    std::cout << "poem of " << POEM_WORDS << " words:" << std::endl;
+    measurePoem("searched", poet, input);
+
+    poet.cacheBridges(1 << 20);
+    auto start = std::chrono::steady_clock::now();
+    poet.poem(input);
+    std::cout << "    cached, cold: " << secondsSince(start) * 1e9 / POEM_WORDS << " ns/word" << std::endl;
+    measurePoem("cached, warm", poet, input);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        start = std::chrono::steady_clock::now();
+        poet.indexBridges(threads);
+        std::cout << "index built on " << threads << " threads: " << secondsSince(start) << " s" << std::endl;
+    }
+    measurePoem("indexed", poet, input);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << "peak resident memory: " << usage.ru_maxrss / 1024 << " MiB" << std::endl;
+
+    unlink(path);
+    return 0;
+}
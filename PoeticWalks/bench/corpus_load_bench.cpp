@@ -0,0 +1,110 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "corpus.h"
+#include "frozen_graph.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+
+#define VOCABULARY_SIZE 100000
+#define CHUNK_WORDS 1000000
+
+/**
+ * Writes a corpus of Zipf distributed words, every tenth capitalized, to a file.
+ *
+ * @return number of bytes written
+ */
+static size_t writeCorpus(int fd, size_t megabytes) {
+    ZipfWords words(VOCABULARY_SIZE, 7, true);
+    size_t written = 0;
+    std::string chunk;
+    while (written < megabytes << 20) {
+        chunk.clear();
+        words.append(chunk, CHUNK_WORDS);
+        if (write(fd, chunk.data(), chunk.size()) != (ssize_t) chunk.size()) {
+            perror("write");
+            exit(1);
+        }
+        written += chunk.size();
+    }
+    return written;
+}
+
+/**
+ * Measures the throughput of loading a corpus of the given size in MB, 256 by
+ * default, with the steps of the load timed separately, then the speedup of
+ * counting its bigrams on 1 up to the given maximum number of threads, 32 by default.
+ */
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? atol(argv[1]) : 256;
+    unsigned maxThreads = argc > 2 ? atoi(argv[2]) : 32;
+
+    char path[] = "/tmp/corpus_load_benchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    double size = writeCorpus(fd, megabytes) / 1048576.0;
+    std::cout << "corpus: " << size << " MB" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    GraphPoet poet(new IndexedGraph(), path, true);
+    double total = secondsSince(start);
+    std::cout << "GraphPoet constructor: " << total << " s, " << size / total << " MB/s" << std::endl;
+
+    // the same load step by step
+    SymbolTable symbols{};
+    Corpus::BigramCounts counts;
+    IndexedGraph *graph = new IndexedGraph();
+    start = std::chrono::steady_clock::now();
+    Corpus::File file(fd);
+    std::cout << "    map:          " << secondsSince(start) << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    Corpus::countBigrams(file.content(), symbols, counts);
+    double counting = secondsSince(start);
+    std::cout << "    count:        " << counting << " s, " << size / counting << " MB/s, "
+              << symbols.size() << " words, " << counts.size() << " bigrams" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    Corpus::addBigrams(counts, graph);
+    std::cout << "    bulk insert:  " << secondsSince(start) << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    FrozenGraph<uint32_t> frozen = freeze(*graph);
+    std::cout << "    freeze:       " << secondsSince(start) << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    delete graph;
+    std::cout << "    free graph:   " << secondsSince(start) << " s" << std::endl;
+
+    // counting includes interning the shards' words, the part that stays sequential
+    std::cout << "count on " << std::thread::hardware_concurrency() << " hardware threads:" << std::endl;
+    double sequential = 0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        SymbolTable threadSymbols{};
+        start = std::chrono::steady_clock::now();
+        std::vector<Corpus::BigramCounts> partitions = Corpus::countBigrams(file.content(), threadSymbols, threads);
+        double seconds = secondsSince(start);
+        if (threads == 1) sequential = seconds;
+        std::cout << "    " << threads << " threads: " << seconds << " s, " << size / seconds << " MB/s, speedup "
+                  << sequential / seconds << std::endl;
+        size_t bigrams = 0;
+        for (const Corpus::BigramCounts& partition: partitions) bigrams += partition.size();
+        if (bigrams != counts.size()) return 1;
+    }
+
+    close(fd);
+    unlink(path);
+    return frozen.edgeCount() == 0;
+}
@@ -0,0 +1,116 @@
+#include <malloc.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "concrete_edges_graph.h"
+#include "concrete_vertices_graph.h"
+#include "frozen_graph.h"
+#include "hashed_graph.h"
+#include "indexed_graph.h"
+#include "symbol_table.h"
+
+#define VOCABULARY_SIZE 50000
+#define LINEAR_SCAN_MAX_EDGES 100000
+
+/**
+ * Builds the word graph of a corpus the way GraphPoet does, incrementing the
+ * weight of the edge between every pair of adjacent words.
+ *
+ * @return the time taken in milliseconds
+ */
+static double build(Graph<std::string> *graph, const std::vector<std::string>& vocabulary, const std::vector<uint32_t>& corpus) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 1; i < corpus.size(); i++) {
+        const std::string& source = vocabulary[corpus[i - 1]];
+        const std::string& target = vocabulary[corpus[i]];
+        int previousWeight = graph->set(source, target, 1);
+        if (previousWeight > 0) graph->set(source, target, previousWeight + 1);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @return bytes currently allocated on the heap, including mapped chunks
+ */
+static size_t heapBytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+/**
+ * Builds the word graph of a corpus the way GraphPoet does, interning every
+ * word and keying the graph by the ids.
+ *
+ * @return the time taken in milliseconds
+ */
+static double buildInterned(Graph<uint32_t> *graph, const std::vector<std::string>& vocabulary, const std::vector<uint32_t>& corpus) {
+    auto start = std::chrono::steady_clock::now();
+    SymbolTable symbols{};
+    uint32_t source = symbols.intern(vocabulary[corpus[0]]);
+    for (size_t i = 1; i < corpus.size(); i++) {
+        uint32_t target = symbols.intern(vocabulary[corpus[i]]);
+        int previousWeight = graph->set(source, target, 1);
+        if (previousWeight > 0) graph->set(source, target, previousWeight + 1);
+        source = target;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * Compares the time the graph implementations need to build the word graph of
+ * corpora with the given numbers of edges (adjacent word pairs), 10^5, 10^6
+ * and 10^7 by default. The linear scan implementations are quadratic and only
+ * run up to LINEAR_SCAN_MAX_EDGES edges.
+ */
+int main(int argc, char *argv[]) {
+    std::vector<long> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(atol(argv[i]));
+    if (sizes.empty()) sizes = {100000, 1000000, 10000000};
+
+    std::vector<std::string> vocabulary;
+    for (int i = 0; i < VOCABULARY_SIZE; i++) vocabulary.push_back("word" + std::to_string(i));
+
+    for (long edges: sizes) {
+        std::vector<uint32_t> corpus = zipfCorpus(VOCABULARY_SIZE, edges + 1);
+        std::cout << edges << " edges" << std::endl;
+
+        size_t heapBefore = heapBytes();
+        IndexedGraph *indexed = new IndexedGraph();
+        std::cout << "    IndexedGraph, interned: " << buildInterned(indexed, vocabulary, corpus) << " ms, "
+                  << (heapBytes() - heapBefore) / 1024 << " KiB" << std::endl;
+
+        // the poet frees the mutable graph once it is frozen
+        auto freezeStart = std::chrono::steady_clock::now();
+        FrozenGraph<uint32_t> frozen = freeze(*indexed);
+        auto freezeEnd = std::chrono::steady_clock::now();
+        delete indexed;
+        std::cout << "    FrozenGraph:            " << std::chrono::duration<double, std::milli>(freezeEnd - freezeStart).count()
+                  << " ms to freeze, " << (heapBytes() - heapBefore) / 1024 << " KiB, "
+                  << frozen.edgeCount() << " edges" << std::endl;
+
+        HashedGraph<std::string> hashed{};
+        std::cout << "    HashedGraph:            " << build(&hashed, vocabulary, corpus) << " ms, "
+                  << hashed.vertices().size() << " vertices" << std::endl;
+
+        if (edges > LINEAR_SCAN_MAX_EDGES) {
+            std::cout << "    ConcreteVerticesGraph:  skipped" << std::endl;
+            std::cout << "    ConcreteEdgesGraph:     skipped" << std::endl;
+            continue;
+        }
+
+        ConcreteVerticesGraph<std::string> vertices{};
+        std::cout << "    ConcreteVerticesGraph:  " << build(&vertices, vocabulary, corpus) << " ms" << std::endl;
+
+        ConcreteEdgesGraph<std::string> edgesGraph{};
+        std::cout << "    ConcreteEdgesGraph:     " << build(&edgesGraph, vocabulary, corpus) << " ms" << std::endl;
+    }
+    return 0;
+}
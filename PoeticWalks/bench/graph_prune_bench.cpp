@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "bench_util.h"
+#include "concrete_edges_graph.h"
+#include "concrete_vertices_graph.h"
+
+#define MIN_COUNT 3
+
+/**
+ * Builds the word graph of a corpus, then prunes the words seen fewer than
+ * MIN_COUNT times, once with a remove() per word and once with removeVertices().
+ */
+template<typename G>
+static void measure(const char *name, const std::vector<uint32_t>& corpus, const std::unordered_set<uint32_t>& rare) {
+    for (bool bulk: {false, true}) {
+        G graph{};
+        for (size_t i = 1; i < corpus.size(); i++) {
+            int previousWeight = graph.set(corpus[i - 1], corpus[i], 1);
+            if (previousWeight > 0) graph.set(corpus[i - 1], corpus[i], previousWeight + 1);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (bulk) {
+            graph.removeVertices(rare);
+        } else {
+            for (uint32_t vertex: rare) graph.remove(vertex);
+        }
+        std::cout << "    " << name << (bulk ? ", removeVertices(): " : ", remove() per vertex: ")
+                  << millisecondsSince(start) << " ms" << std::endl;
+    }
+}
+
+/**
+ * Measures pruning rare words from the graphs of a corpus of the given number
+ * of words drawn from the given vocabulary size, 30000 and 10000 by default.
+ * Both graphs scan linearly to find an edge or vertex, so building them limits
+ * the corpus size.
+ */
+int main(int argc, char *argv[]) {
+    int corpusWords = argc > 1 ? atoi(argv[1]) : 30000;
+    int vocabularySize = argc > 2 ? atoi(argv[2]) : 10000;
+
+    std::vector<uint32_t> corpus = zipfCorpus(vocabularySize, corpusWords);
+    std::unordered_map<uint32_t, int> counts;
+    for (uint32_t word: corpus) counts[word]++;
+    std::unordered_set<uint32_t> rare;
+    for (auto& [word, count]: counts) {
+        if (count < MIN_COUNT) rare.insert(word);
+    }
+    std::cout << "pruning " << rare.size() << " of " << counts.size() << " words:" << std::endl;
+
+    measure<ConcreteEdgesGraph<uint32_t>>("ConcreteEdgesGraph", corpus, rare);
+    measure<ConcreteVerticesGraph<uint32_t>>("ConcreteVerticesGraph", corpus, rare);
+    return 0;
+}
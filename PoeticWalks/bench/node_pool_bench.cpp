@@ -0,0 +1,85 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bench_util.h"
+#include "concrete_edges_graph.h"
+#include "concrete_vertices_graph.h"
+
+/**
+ * @return bytes of memory resident for this process
+ */
+static size_t residentBytes() {
+    long pages = 0;
+    long resident = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != nullptr) {
+        if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        fclose(statm);
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Builds the word graph of a corpus the way GraphPoet does, then reads the
+ * targets and sources of every vertex, and reports the time of both and the
+ * memory the graph takes. Runs in a child process, so memory freed by earlier
+ * measurements is not reused.
+ */
+template<typename G>
+static void measure(const char *name, const std::vector<uint32_t>& corpus) {
+    pid_t child = fork();
+    if (child != 0) {
+        waitpid(child, nullptr, 0);
+        return;
+    }
+
+    size_t residentBefore = residentBytes();
+    G *graph = new G();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 1; i < corpus.size(); i++) {
+        int previousWeight = (*graph).set(corpus[i - 1], corpus[i], 1);
+        if (previousWeight > 0) (*graph).set(corpus[i - 1], corpus[i], previousWeight + 1);
+    }
+    double build = millisecondsSince(start);
+    size_t resident = residentBytes() - residentBefore;
+
+    start = std::chrono::steady_clock::now();
+    long total = 0;
+    for (uint32_t vertex: (*graph).vertices()) {
+        for (auto& [target, weight]: (*graph).targets(vertex)) total += weight;
+        for (auto& [source, weight]: (*graph).sources(vertex)) total += weight;
+    }
+    double traverse = millisecondsSince(start);
+    delete graph;
+
+    std::cout << "    " << name << ": build " << build << " ms, traverse " << traverse << " ms, resident "
+              << resident / 1024 << " KiB" << (total == 2 * (long) (corpus.size() - 1) ? "" : ", wrong weights") << std::endl;
+    exit(0);
+}
+
+/**
+ * Measures building and traversing the linked graph implementations on corpora
+ * with the given numbers of adjacent word pairs, 10^4 and 5 * 10^4 by default,
+ * drawn from a vocabulary of 10000 words. Both graphs scan linearly to find an
+ * edge or vertex, so the corpora stay small.
+ */
+int main(int argc, char *argv[]) {
+    std::vector<long> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(atol(argv[i]));
+    if (sizes.empty()) sizes = {10000, 50000};
+
+    for (long edges: sizes) {
+        std::vector<uint32_t> corpus = zipfCorpus(10000, edges + 1);
+        std::cout << edges << " word pairs" << std::endl;
+        measure<ConcreteEdgesGraph<uint32_t>>("ConcreteEdgesGraph   ", corpus);
+        measure<ConcreteVerticesGraph<uint32_t>>("ConcreteVerticesGraph", corpus);
+    }
+    return 0;
+}
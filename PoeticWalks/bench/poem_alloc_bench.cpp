@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "allocation_counter.h"
+#include "frozen_graph.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+
+#define VOCABULARY_SIZE 20000
+#define CORPUS_WORDS 1000000
+#define POEM_WORDS 100000
+
+/**
+ * Measures the allocations and time per input word of poem(), and of reading
+ * the edges of every pair of adjacent input words through the copying
+ * sources()/targets() and through the edge views.
+ */
+int main() {
+    char path[] = "/tmp/poem_alloc_benchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    std::string corpus = zipfText(CORPUS_WORDS, VOCABULARY_SIZE, 7);
+    if (write(fd, corpus.data(), corpus.size()) != (ssize_t) corpus.size()) {
+        perror("write");
+        return 1;
+    }
+    close(fd);
+
+    GraphPoet poet(new IndexedGraph(), path, true);
+    std::string input = zipfText(POEM_WORDS, VOCABULARY_SIZE, 11);
+
+    long before = allocationCount();
+    auto start = std::chrono::steady_clock::now();
+    std::string output = poet.poem(input);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "poem():                " << (double) (allocationCount() - before) / POEM_WORDS << " allocations/word, "
+              << std::chrono::duration<double, std::nano>(end - start).count() / POEM_WORDS << " ns/word" << std::endl;
+
+    // the same lookups on a frozen graph of ids, through both APIs
+    IndexedGraph graph{};
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < POEM_WORDS; i++) ids.push_back(i * 7919 % VOCABULARY_SIZE);
+    std::mt19937 random(3);
+    for (int i = 0; i < CORPUS_WORDS; i++) {
+        uint32_t source = random() % VOCABULARY_SIZE;
+        uint32_t target = random() % 64;
+        int previousWeight = graph.set(source, target, 1);
+        if (previousWeight > 0) graph.set(source, target, previousWeight + 1);
+        graph.set(target, source, 1);
+    }
+    FrozenGraph<uint32_t> frozen = freeze(graph);
+
+    long weight = 0;
+    before = allocationCount();
+    start = std::chrono::steady_clock::now();
+    for (int i = 1; i < POEM_WORDS; i++) {
+        weight += frozen.targets(ids[i - 1]).size() + frozen.sources(ids[i]).size();
+    }
+    end = std::chrono::steady_clock::now();
+    std::cout << "targets()/sources():   " << (double) (allocationCount() - before) / POEM_WORDS << " allocations/word, "
+              << std::chrono::duration<double, std::nano>(end - start).count() / POEM_WORDS << " ns/word" << std::endl;
+
+    before = allocationCount();
+    start = std::chrono::steady_clock::now();
+    for (int i = 1; i < POEM_WORDS; i++) {
+        for (Neighbor<uint32_t> edge: frozen.outEdges(frozen.index(ids[i - 1]))) weight += edge.weight;
+        for (Neighbor<uint32_t> edge: frozen.inEdges(frozen.index(ids[i]))) weight += edge.weight;
+    }
+    end = std::chrono::steady_clock::now();
+    std::cout << "outEdges()/inEdges():  " << (double) (allocationCount() - before) / POEM_WORDS << " allocations/word, "
+              << std::chrono::duration<double, std::nano>(end - start).count() / POEM_WORDS << " ns/word" << std::endl;
+
+    unlink(path);
+    return weight == 0 && output.empty();
+}
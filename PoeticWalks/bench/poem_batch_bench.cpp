@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+
+#define VOCABULARY_SIZE 20000
+#define CORPUS_WORDS 1000000
+#define POEM_COUNT 2000
+#define POEM_WORDS 50
+
+/**
+ * Measures the throughput of poems() on batches of short inputs, with the
+ * bridges searched or cached, on 1 up to the given number of threads, the
+ * hardware threads by default.
+ */
+int main(int argc, char *argv[]) {
+    unsigned maxThreads = argc > 1 ? atoi(argv[1]) : std::thread::hardware_concurrency();
+
+    char path[] = "/tmp/poem_batch_benchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    ZipfWords words(VOCABULARY_SIZE, 7);
+    std::string corpus = words.text(CORPUS_WORDS);
+    if (write(fd, corpus.data(), corpus.size()) != (ssize_t) corpus.size()) {
+        perror("write");
+        return 1;
+    }
+    close(fd);
+
+    GraphPoet poet(new IndexedGraph(), path, true);
+    std::vector<std::string> texts;
+    for (int i = 0; i < POEM_COUNT; i++) texts.push_back(words.text(POEM_WORDS));
+    std::vector<std::string_view> inputs(texts.begin(), texts.end());
+
+    for (const char *lookup: {"searched", "cached"}) {
+        if (std::string(lookup) == "cached") {
+            poet.cacheBridges(1 << 20);
+            poet.poems(inputs, 1);
+        }
+        std::cout << POEM_COUNT << " poems of " << POEM_WORDS << " words, bridges " << lookup << ":" << std::endl;
+        double sequential = 0;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::string> outputs = poet.poems(inputs, threads);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (threads == 1) sequential = seconds;
+            std::cout << "    " << threads << " threads: " << POEM_COUNT / seconds << " poems/s, speedup "
+                      << sequential / seconds << std::endl;
+            if (outputs.size() != inputs.size()) return 1;
+        }
+    }
+
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+
+/**
+ * Measures building a poet from a corpus against saving it as a snapshot and
+ * loading it back, on a corpus of the given number of words drawn from the
+ * given vocabulary size, 5000000 and 100000 by default.
+ */
+int main(int argc, char *argv[]) {
+    int corpusWords = argc > 1 ? atoi(argv[1]) : 5000000;
+    int vocabularySize = argc > 2 ? atoi(argv[2]) : 100000;
+
+    char corpusPath[] = "/tmp/snapshot_benchXXXXXX";
+    int fd = mkstemp(corpusPath);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    std::string corpus = zipfText(corpusWords, vocabularySize, 7);
+    if (write(fd, corpus.data(), corpus.size()) != (ssize_t) corpus.size()) {
+        perror("write");
+        return 1;
+    }
+    close(fd);
+    std::string snapshotPath = std::string(corpusPath) + ".snapshot";
+
+    auto start = std::chrono::steady_clock::now();
+    GraphPoet poet(new IndexedGraph(), corpusPath, true);
+    std::cout << "built from a corpus of " << corpus.size() / (1 << 20) << " MiB: " << secondsSince(start) << " s"
+              << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    poet.save(snapshotPath);
+    struct stat status;
+    stat(snapshotPath.c_str(), &status);
+    std::cout << "saved a snapshot of " << status.st_size / (1 << 20) << " MiB: " << secondsSince(start) << " s"
+              << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    GraphPoet loaded = GraphPoet::fromSnapshot(snapshotPath);
+    std::cout << "loaded the snapshot: " << secondsSince(start) << " s" << std::endl;
+
+    std::string input = zipfText(1000, vocabularySize, 11);
+    if (loaded.poem(input) != poet.poem(input)) {
+        std::cerr << "loaded poet writes another poem" << std::endl;
+        return 1;
+    }
+
+    unlink(snapshotPath.c_str());
+    unlink(corpusPath);
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_util.h"
+#include "tokenizer.h"
+
+#define VOCABULARY_SIZE 20000
+
+/**
+ * Sums the length and first character of every word so the words are not optimized away.
+ */
+struct Checksum {
+    size_t words = 0;
+    size_t sum = 0;
+
+    void add(std::string_view word) {
+        words++;
+        sum += word.size() + (word.empty() ? 0 : (unsigned char) word[0]);
+    }
+};
+
+/**
+ * Times a tokenizer over a text, best of a few runs.
+ */
+template<typename F>
+static void measure(const char *name, const std::string& text, F tokenize) {
+    double best = 1e30;
+    Checksum checksum;
+    for (int run = 0; run < 3; run++) {
+        checksum = Checksum();
+        auto start = std::chrono::steady_clock::now();
+        tokenize(text, checksum);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::cout << "    " << name << ": " << text.size() / best / 1048576.0 << " MB/s, "
+              << best * 1e9 / checksum.words << " ns/word (" << checksum.words << " words, checksum "
+              << checksum.sum << ")" << std::endl;
+}
+
+/**
+ * Measures splitting and lower casing a text of the given size in MB, 64 by default,
+ * the way the corpus is read and the way poem() reads its input, before and after
+ * the vectorized tokenizer.
+ */
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? atol(argv[1]) : 64;
+    ZipfWords words(VOCABULARY_SIZE, 3, true);
+    std::string text;
+    while (text.size() < megabytes << 20) words.append(text, 1);
+#if defined(__AVX2__)
+    std::cout << "tokenizer: AVX2" << std::endl;
+#elif defined(__SSE2__)
+    std::cout << "tokenizer: SSE2" << std::endl;
+#else
+    std::cout << "tokenizer: scalar" << std::endl;
+#endif
+
+    std::cout << "corpus, tokens split on ' ' and '\\n':" << std::endl;
+    measure("byte loop, lower case per word", text, [](const std::string& text, Checksum& checksum) {
+        char lowerCase[1024];
+        size_t start = 0;
+        for (size_t i = 0; i <= text.size(); i++) {
+            if (i < text.size() && text[i] != ' ' && text[i] != '\n') continue;
+            for (size_t j = start; j < i; j++) {
+                lowerCase[j - start] = text[j] >= 'A' && text[j] <= 'Z' ? text[j] - 'A' + 'a' : text[j];
+            }
+            checksum.add(std::string_view(lowerCase, i - start));
+            start = i + 1;
+        }
+    });
+    measure("Tokenizer", text, [](const std::string& text, Checksum& checksum) {
+        std::string lowerCase(text.size(), '\0');
+        Tokenizer::lowerCase(text, lowerCase.data());
+        Tokenizer::forEachSeparated(lowerCase, [&checksum](std::string_view word) {checksum.add(word);});
+    });
+
+    std::cout << "poem input, words split on whitespace:" << std::endl;
+    std::string input = text.substr(0, std::min(text.size(), (size_t) 4 << 20));
+    measure("std::regex and std::transform", input, [](const std::string& text, Checksum& checksum) {
+        std::regex wordRegex("\\S+");
+        for (auto it = std::sregex_iterator(text.begin(), text.end(), wordRegex); it != std::sregex_iterator(); ++it) {
+            std::string word = it->str();
+            std::transform(word.begin(), word.end(), word.begin(), [](unsigned char c) {return tolower(c);});
+            checksum.add(word);
+        }
+    });
+    measure("isspace scan and tolower", input, [](const std::string& text, Checksum& checksum) {
+        std::string buffer;
+        size_t position = 0;
+        while (true) {
+            while (position < text.size() && isspace((unsigned char) text[position])) position++;
+            if (position == text.size()) break;
+            size_t start = position;
+            while (position < text.size() && !isspace((unsigned char) text[position])) position++;
+            buffer.assign(text.data() + start, position - start);
+            for (char& c: buffer) c = tolower((unsigned char) c);
+            checksum.add(buffer);
+        }
+    });
+    measure("Tokenizer", input, [](const std::string& text, Checksum& checksum) {
+        std::string lowerCase(text.size(), '\0');
+        Tokenizer::lowerCase(text, lowerCase.data());
+        Tokenizer::forEachWord(lowerCase, [&checksum](std::string_view word) {checksum.add(word);});
+    });
+    return 0;
+}
@@ -1,9 +1,12 @@
 #ifndef CONCRETE_EDGE_GRAPH_H
 #define CONCRETE_EDGE_GRAPH_H
 
+#include <utility>
 #include <vector>
 
 #include "graph.h"
+#include "neighbor_view.h"
+#include "node_pool.h"
 
 /**
  * An immutable directed edge data structure.
@@ -41,17 +44,78 @@ class ConcreteEdgesGraph: public Graph<T> {
      *      - represents a graph.
      *      - vertices set holds the vertices in the graph
      *      - edges vector holds all the edges
+     *      - edgePool holds the edges themselves, side by side in slabs
      * 
      * Representation invariant:
      *      - for all edges, both the source and target vertex exist in vertices
      *      - for all edges, weight > 0 
+     *      - the nodes of edgePool are exactly the edges
      * 
      * Safety from rep exposure:
      *      - set and vector copies L using copy constructor.
      *      - getter functions returns by value, so a copy is made every time.
+     *      - views only hold const pointers to the edges.
      */
 
+public:
+    /**
+     * A position in the edges vector that only stops at the edges from, or to, one vertex.
+     */
+    class EdgePosition {
+    public:
+        EdgePosition(const std::vector<Edge<T>*> *edges, size_t index, const T *vertex, bool fromVertex):
+            edges{edges}, index{index}, vertex{vertex}, fromVertex{fromVertex} {
+            skip();
+        }
+
+        const Edge<T>& edge() const {
+            return *(*edges)[index];
+        }
+
+        EdgePosition& operator++() {
+            ++index;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const EdgePosition& that) const {
+            return index == that.index;
+        }
+
+        bool operator!=(const EdgePosition& that) const {
+            return index != that.index;
+        }
+
+    private:
+        void skip() {
+            while (index < (*edges).size() && (fromVertex ? edge().source : edge().target) != *vertex) ++index;
+        }
+
+        const std::vector<Edge<T>*> *edges;
+        size_t index;
+        const T *vertex;
+        bool fromVertex;
+    };
+
+    /**
+     * Turns a position into the label of the edge's other vertex and its weight.
+     */
+    struct EdgeProjection {
+        bool fromVertex;
+
+        Neighbor<T> operator()(const EdgePosition& position) const {
+            const Edge<T>& edge = position.edge();
+            return Neighbor<T>{fromVertex ? edge.target : edge.source, edge.weight};
+        }
+    };
+
+    /**
+     * The edges of a vertex, in no particular order. Iterating over them scans every edge of the graph.
+     */
+    using EdgeView = NeighborView<T, EdgePosition, EdgeProjection>;
+
 private:
+    NodePool<Edge<T>> edgePool;
     std::unordered_set<T> vertices_;
     std::vector<Edge<T>*> edges;
 
@@ -72,6 +136,40 @@ public:
 
     std::unordered_map<T, int> targets(T source) override;
 
+    /**
+     * View the edges to a vertex without copying them, as sources(target).
+     *
+     * @param target a label
+     * @return the sources and weights of the edges to target, empty if target is not in the graph
+     */
+    EdgeView sourcesView(T target) const;
+
+    /**
+     * View the edges from a vertex without copying them, as targets(source).
+     *
+     * @param source a label
+     * @return the targets and weights of the edges from source, empty if source is not in the graph
+     */
+    EdgeView targetsView(T source) const;
+
+    /**
+     * Remove vertices from this graph, along with every edge to or from them,
+     * in one pass over the edges.
+     *
+     * @param vertices labels of the vertices to remove, labels not in the graph are ignored
+     * @return the number of vertices removed
+     */
+    size_t removeVertices(const std::unordered_set<T>& vertices);
+
+    /**
+     * Remove edges from this graph, in one pass over the edges. Their vertices
+     * stay in the graph, as when an edge's weight is set to zero.
+     *
+     * @param edgesToRemove source and target labels of the edges to remove, edges not in the graph are ignored
+     * @return the number of edges removed
+     */
+    size_t removeEdges(const std::vector<std::pair<T, T>>& edgesToRemove);
+
 private:
     /**
      * Returns the index in edges vector that correspond to an edge
@@ -84,6 +182,22 @@ private:
      *         -1 if there is no such edge.
     */
     int findEdgeIndex(T source, T target);
+
+    /**
+     * @param vertex a label
+     * @param fromVertex true for the edges from vertex, false for the edges to it
+     * @return a view of the edges from or to vertex
+     */
+    EdgeView view(const T& vertex, bool fromVertex) const;
+
+    /**
+     * Delete the edges matching a predicate, keeping the others in order.
+     *
+     * @param matches called with each edge, true if the edge is to be deleted
+     * @return the number of edges deleted
+     */
+    template<typename P>
+    size_t removeEdgesIf(P matches);
 };
 
 #include "concrete_edges_graph.tpp"
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 #include "concrete_edges_graph.h"
 
@@ -14,7 +15,7 @@ Edge<T>::Edge(T source, T target, int weight):
 
 template<typename T>
 ConcreteEdgesGraph<T>::ConcreteEdgesGraph():
-    vertices_{}, edges{} {}
+    edgePool{}, vertices_{}, edges{} {}
 
 template<typename T>
 bool ConcreteEdgesGraph<T>::add(T vertex) {
@@ -34,37 +35,77 @@ int ConcreteEdgesGraph<T>::set(T source, T target, int weight) {
 
     if (edgeIndex != -1) {
         previousWeight = (*edges[edgeIndex]).weight;
-        delete edges[edgeIndex];
-        edges.erase(edges.begin() + edgeIndex);
+        edgePool.destroy(edges[edgeIndex]);
+        // the order of edges does not matter, the last edge takes the place of the deleted one
+        edges[edgeIndex] = edges.back();
+        edges.pop_back();
     }
 
     if (weight == 0) return previousWeight;
 
     if (vertices_.find(source) == vertices_.end()) vertices_.insert(source);
     if (vertices_.find(target) == vertices_.end()) vertices_.insert(target);
-    edges.push_back(new Edge(source, target, weight));
+    edges.push_back(edgePool.create(source, target, weight));
 
     return previousWeight;
 }
 
 template<typename T>
 bool ConcreteEdgesGraph<T>::remove(T vertex) {
-    if (vertices_.find(vertex) == vertices_.end()) {
-        return false;
-    }
+    if (vertices_.erase(vertex) == 0) return false;
 
-    vertices_.erase(vertex);
+    removeEdgesIf([&vertex](const Edge<T>& edge) {
+        return edge.source == vertex || edge.target == vertex;
+    });
+    return true;
+}
 
-    std::vector<int> indicesToRemove;
-    for (int i = edges.size() - 1; i >= 0; i--) {
-        if ((*edges[i]).source == vertex || (*edges[i]).target == vertex) indicesToRemove.push_back(i);
-    }
+template<typename T>
+typename ConcreteEdgesGraph<T>::EdgeView ConcreteEdgesGraph<T>::sourcesView(T target) const {
+    return view(target, false);
+}
 
-    for (int i = 0; i < indicesToRemove.size(); i++) {
-        delete edges[i];
-        edges.erase(edges.begin() + indicesToRemove[i]);
+template<typename T>
+typename ConcreteEdgesGraph<T>::EdgeView ConcreteEdgesGraph<T>::targetsView(T source) const {
+    return view(source, true);
+}
+
+template<typename T>
+typename ConcreteEdgesGraph<T>::EdgeView ConcreteEdgesGraph<T>::view(const T& vertex, bool fromVertex) const {
+    // positions point at the graph's copy of the label, the argument may not outlive the view
+    auto found = vertices_.find(vertex);
+    if (found == vertices_.end()) {
+        EdgePosition end(&edges, edges.size(), nullptr, fromVertex);
+        return EdgeView(end, end, EdgeProjection{fromVertex});
     }
-    return true;
+    return EdgeView(
+        EdgePosition(&edges, 0, &*found, fromVertex),
+        EdgePosition(&edges, edges.size(), &*found, fromVertex),
+        EdgeProjection{fromVertex}
+    );
+}
+
+template<typename T>
+size_t ConcreteEdgesGraph<T>::removeVertices(const std::unordered_set<T>& vertices) {
+    size_t removed = 0;
+    for (const T& vertex: vertices) removed += vertices_.erase(vertex);
+    if (removed == 0) return 0;
+
+    removeEdgesIf([&vertices](const Edge<T>& edge) {
+        return vertices.find(edge.source) != vertices.end() || vertices.find(edge.target) != vertices.end();
+    });
+    return removed;
+}
+
+template<typename T>
+size_t ConcreteEdgesGraph<T>::removeEdges(const std::vector<std::pair<T, T>>& edgesToRemove) {
+    std::unordered_map<T, std::unordered_set<T>> targetsToRemove;
+    for (const auto& [source, target]: edgesToRemove) targetsToRemove[source].insert(target);
+
+    return removeEdgesIf([&targetsToRemove](const Edge<T>& edge) {
+        auto targets = targetsToRemove.find(edge.source);
+        return targets != targetsToRemove.end() && (*targets).second.find(edge.target) != (*targets).second.end();
+    });
 }
 
 template<typename T>
@@ -100,10 +141,26 @@ int ConcreteEdgesGraph<T>::findEdgeIndex(T source, T target) {
     return -1;
 }
 
+template<typename T>
+template<typename P>
+size_t ConcreteEdgesGraph<T>::removeEdgesIf(P matches) {
+    size_t kept = 0;
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (matches(*edges[i])) {
+            edgePool.destroy(edges[i]);
+        } else {
+            edges[kept++] = edges[i];
+        }
+    }
+    size_t removed = edges.size() - kept;
+    edges.resize(kept);
+    return removed;
+}
+
 template<typename T>
 ConcreteEdgesGraph<T>::~ConcreteEdgesGraph() {
     for (int i = 0; i < edges.size(); i++) {
-        delete edges[i];
+        edgePool.destroy(edges[i]);
     }
 }
 
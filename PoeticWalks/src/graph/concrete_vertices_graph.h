@@ -1,9 +1,12 @@
 #ifndef CONCRETE_VERTICES_GRAPH_H
 #define CONCRETE_VERTICES_GRAPH_H
 
+#include <utility>
 #include <vector>
 
 #include "graph.h"
+#include "node_pool.h"
+#include "neighbor_view.h"
 
 /**
  * A mutable vertex data structure.
@@ -23,14 +26,31 @@ class Vertex {
      *
      *  Safety from rep exposure:
      *      - all getter function returns by value.
+     *      - views only hold const references to the edges.
      */
 
 public: 
     const T label;
+
+    using EdgeMap = std::unordered_map<Vertex<T>*, int>;
+
+    /**
+     * Turns an entry of an edge map into the label of the edge's other vertex and its weight.
+     */
+    struct EdgeProjection {
+        Neighbor<T> operator()(typename EdgeMap::const_iterator edge) const {
+            return Neighbor<T>{(*edge->first).label, edge->second};
+        }
+    };
+
+    /**
+     * The edges of a vertex, in no particular order.
+     */
+    using EdgeView = NeighborView<T, typename EdgeMap::const_iterator, EdgeProjection>;
     
 private:
-    std::unordered_map<Vertex<T>*, int> targets;
-    std::unordered_map<Vertex<T>*, int> sources;
+    EdgeMap targets;
+    EdgeMap sources;
 
 public:
     Vertex() = delete;
@@ -63,6 +83,11 @@ public:
      */
     int setTarget(Vertex<T> *target, int weight);
 
+    /**
+     * Remove every edge to or from this vertex, at both of its ends.
+     */
+    void clearEdges();
+
     /**
      * Get the source vertices with edges targeting this vertex and the
      * weights of those edges.
@@ -82,6 +107,20 @@ public:
      *         the weight of edges targetting the key from this vertex
      */
     std::unordered_map<T, int> getTargets();
+
+    /**
+     * View the edges targeting this vertex without copying them, as getSources().
+     *
+     * @return the source vertices and weights of the edges to this vertex
+     */
+    EdgeView sourcesView() const;
+
+    /**
+     * View the edges from this vertex without copying them, as getTargets().
+     *
+     * @return the target vertices and weights of the edges from this vertex
+     */
+    EdgeView targetsView() const;
 };
 
 template<typename T>
@@ -91,18 +130,24 @@ class ConcreteVerticesGraph: public Graph<T> {
      *      - represents a graph.
      *      - vertices set holds the vertices in the graph
      *      - edges vector holds all the edges
+     *      - vertexPool holds the vertices themselves, side by side in slabs
      * 
      * Representation invariant:
      *      - for all edges, both the source and target vertex exist in vertices
      *      - for all edges, weight > 0 
+     *      - noEdges is empty, it backs the views of vertices not in the graph
+     *      - the nodes of vertexPool are exactly the vertices
      * 
      * Safety from rep exposure:
      *      - set and vector copies L using copy constructor.
      *      - getter functions returns by value, so a copy is made every time.
+     *      - views only hold const references to the edges.
      */
 
 private:
+    NodePool<Vertex<T>> vertexPool;
     std::vector<Vertex<T>*> vertices_;
+    typename Vertex<T>::EdgeMap noEdges;
     
 public:
     ConcreteVerticesGraph();
@@ -121,6 +166,40 @@ public:
 
     std::unordered_map<T, int> targets(T source) override;
 
+    /**
+     * View the edges to a vertex without copying them, as sources(target).
+     *
+     * @param target a label
+     * @return the sources and weights of the edges to target, empty if target is not in the graph
+     */
+    typename Vertex<T>::EdgeView sourcesView(T target);
+
+    /**
+     * View the edges from a vertex without copying them, as targets(source).
+     *
+     * @param source a label
+     * @return the targets and weights of the edges from source, empty if source is not in the graph
+     */
+    typename Vertex<T>::EdgeView targetsView(T source);
+
+    /**
+     * Remove vertices from this graph, along with every edge to or from them,
+     * in one pass over the vertices.
+     *
+     * @param vertices labels of the vertices to remove, labels not in the graph are ignored
+     * @return the number of vertices removed
+     */
+    size_t removeVertices(const std::unordered_set<T>& vertices);
+
+    /**
+     * Remove edges from this graph, looking up each vertex once. Their vertices
+     * stay in the graph, as when an edge's weight is set to zero.
+     *
+     * @param edgesToRemove source and target labels of the edges to remove, edges not in the graph are ignored
+     * @return the number of edges removed
+     */
+    size_t removeEdges(const std::vector<std::pair<T, T>>& edgesToRemove);
+
 private:
     /**
      * Returns the index in vertices vector that correspond to a vertex
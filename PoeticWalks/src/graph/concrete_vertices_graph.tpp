@@ -2,6 +2,7 @@
 #define CONCRETE_VERTICES_GRAPH_TPP
 
 #include <stdexcept>
+#include <unordered_map>
 
 #include "concrete_vertices_graph.h"
 
@@ -33,6 +34,14 @@ int Vertex<T>::setTarget(Vertex<T> *target, int weight) {
     return previousWeight;
 }
 
+template<typename T>
+void Vertex<T>::clearEdges() {
+    for (auto& [target, weight]: targets) (*target).sources.erase(this);
+    for (auto& [source, weight]: sources) (*source).targets.erase(this);
+    targets.clear();
+    sources.clear();
+}
+
 template<typename T>
 std::unordered_map<T, int> Vertex<T>::getSources() {
     std::unordered_map<T, int> output;
@@ -51,14 +60,24 @@ std::unordered_map<T, int> Vertex<T>::getTargets() {
     return output;
 }
 
+template<typename T>
+typename Vertex<T>::EdgeView Vertex<T>::sourcesView() const {
+    return EdgeView(sources.begin(), sources.end(), EdgeProjection{});
+}
+
+template<typename T>
+typename Vertex<T>::EdgeView Vertex<T>::targetsView() const {
+    return EdgeView(targets.begin(), targets.end(), EdgeProjection{});
+}
+
 template<typename T>
 ConcreteVerticesGraph<T>::ConcreteVerticesGraph():
-    vertices_{} {}
+    vertexPool{}, vertices_{}, noEdges{} {}
 
 template<typename T>
 ConcreteVerticesGraph<T>::~ConcreteVerticesGraph() {
     for (int i = 0; i < vertices_.size(); i++) {
-        delete vertices_[i];
+        vertexPool.destroy(vertices_[i]);
     }
 }
 
@@ -66,7 +85,7 @@ template<typename T>
 bool ConcreteVerticesGraph<T>::add(T vertex) {
     if (findVertexIndex(vertex) != -1) return false;
 
-    vertices_.push_back(new Vertex<T>(vertex));
+    vertices_.push_back(vertexPool.create(vertex));
     return true; 
 }
 
@@ -81,7 +100,7 @@ int ConcreteVerticesGraph<T>::set(T source, T target, int weight) {
 
     vertexIndex = findVertexIndex(source);
     if (vertexIndex == -1) {
-        sourcePointer = new Vertex<T>(source);
+        sourcePointer = vertexPool.create(source);
         vertices_.push_back(sourcePointer);
     }
     else {
@@ -90,7 +109,7 @@ int ConcreteVerticesGraph<T>::set(T source, T target, int weight) {
 
     vertexIndex = findVertexIndex(target);
     if (vertexIndex == -1) {
-        targetPointer = new Vertex<T>(target);
+        targetPointer = vertexPool.create(target);
         vertices_.push_back(targetPointer);
     }
     else {
@@ -102,26 +121,49 @@ int ConcreteVerticesGraph<T>::set(T source, T target, int weight) {
 
 template<typename T>
 bool ConcreteVerticesGraph<T>::remove(T vertex) {
-    int vertexIndex;
-    vertexIndex = findVertexIndex(vertex);
+    int vertexIndex = findVertexIndex(vertex);
     if (vertexIndex == -1) return false;
 
-    std::unordered_map<T, int> sourcesMap = (*vertices_[vertexIndex]).getSources();
-    std::unordered_map<T, int> targetsMap = (*vertices_[vertexIndex]).getTargets();
-    for (int i = 0 ; i < vertices_.size(); i++) {
-        T vertexLabel = (*vertices_[i]).label;
-        if (sourcesMap.find(vertexLabel) != sourcesMap.end()) {
-            (*vertices_[i]).setTarget(vertices_[vertexIndex], 0);
-        }
-        if (targetsMap.find(vertexLabel) != targetsMap.end()) {
-            (*vertices_[vertexIndex]).setTarget(vertices_[i], 0);
+    (*vertices_[vertexIndex]).clearEdges();
+    vertexPool.destroy(vertices_[vertexIndex]);
+    // the order of vertices does not matter, the last vertex takes the place of the deleted one
+    vertices_[vertexIndex] = vertices_.back();
+    vertices_.pop_back();
+    return true;
+}
+
+template<typename T>
+size_t ConcreteVerticesGraph<T>::removeVertices(const std::unordered_set<T>& vertices) {
+    // a removed vertex is cleared from its neighbors, so later removed neighbors never see it
+    size_t kept = 0;
+    for (size_t i = 0; i < vertices_.size(); i++) {
+        if (vertices.find((*vertices_[i]).label) != vertices.end()) {
+            (*vertices_[i]).clearEdges();
+            vertexPool.destroy(vertices_[i]);
+        } else {
+            vertices_[kept++] = vertices_[i];
         }
     }
+    size_t removed = vertices_.size() - kept;
+    vertices_.resize(kept);
+    return removed;
+}
 
-    delete vertices_[vertexIndex];
-    vertices_.erase(vertices_.begin() + vertexIndex);
-    return true;
+template<typename T>
+size_t ConcreteVerticesGraph<T>::removeEdges(const std::vector<std::pair<T, T>>& edgesToRemove) {
+    std::unordered_map<T, Vertex<T>*> pointers;
+    for (Vertex<T> *vertex: vertices_) pointers[(*vertex).label] = vertex;
+
+    size_t removed = 0;
+    for (const auto& [source, target]: edgesToRemove) {
+        auto sourcePointer = pointers.find(source);
+        auto targetPointer = pointers.find(target);
+        if (sourcePointer == pointers.end() || targetPointer == pointers.end()) continue;
+        if ((*(*sourcePointer).second).setTarget((*targetPointer).second, 0) > 0) removed++;
+    }
+    return removed;
 }
+
 template<typename T>
 std::unordered_set<T> ConcreteVerticesGraph<T>::vertices() {
     std::unordered_set<T> output;
@@ -147,6 +189,22 @@ std::unordered_map<T, int> ConcreteVerticesGraph<T>::targets(T source) {
     return (*vertices_[vertexIndex]).getTargets();
 }
 
+template<typename T>
+typename Vertex<T>::EdgeView ConcreteVerticesGraph<T>::sourcesView(T target) {
+    int vertexIndex = findVertexIndex(target);
+    if (vertexIndex == -1) return typename Vertex<T>::EdgeView(noEdges.cbegin(), noEdges.cend(), typename Vertex<T>::EdgeProjection{});
+
+    return (*vertices_[vertexIndex]).sourcesView();
+}
+
+template<typename T>
+typename Vertex<T>::EdgeView ConcreteVerticesGraph<T>::targetsView(T source) {
+    int vertexIndex = findVertexIndex(source);
+    if (vertexIndex == -1) return typename Vertex<T>::EdgeView(noEdges.cbegin(), noEdges.cend(), typename Vertex<T>::EdgeProjection{});
+
+    return (*vertices_[vertexIndex]).targetsView();
+}
+
 template<typename T>
 int ConcreteVerticesGraph<T>::findVertexIndex(T vertex) {
     for (int i = 0 ; i < vertices_.size(); i++) {
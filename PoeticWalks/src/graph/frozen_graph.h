@@ -0,0 +1,212 @@
+#ifndef FROZEN_GRAPH_H
+#define FROZEN_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "neighbor_view.h"
+
+/**
+ * An immutable weighted directed graph in compressed sparse row layout, made by
+ * freezing a Graph. Vertices are numbered by index in label order, and the
+ * out and in edges of every vertex are contiguous and sorted by the index of
+ * the vertex at the other end.
+ *
+ * @param <T> type of vertex labels, must be immutable, hashable and ordered by <
+ */
+template<typename T>
+class FrozenGraph {
+    /**
+     * Abstraction function:
+     *      - represents the graph with vertices labels[0], labels[1], ...
+     *      - indexes maps each label to its index in labels
+     *      - the edges from vertex i go to vertices outTargets[outOffsets[i]..outOffsets[i + 1]]
+     *        with weights outWeights at the same positions
+     *      - the edges to vertex i come from vertices inSources[inOffsets[i]..inOffsets[i + 1]]
+     *        with weights inWeights at the same positions
+     *
+     * Representation invariant:
+     *      - labels is sorted, indexes[labels[i]] == i
+     *      - outOffsets and inOffsets have labels.size() + 1 non decreasing values,
+     *        starting at 0 and ending at the number of edges
+     *      - the targets of a vertex, and the sources of a vertex, are strictly increasing
+     *      - source i has target j with weight w iff target j has source i with weight w
+     *      - for all edges, weight > 0
+     *
+     * Safety from rep exposure:
+     *      - the graph is never modified after construction.
+     *      - label() returns a const reference and views only hold const pointers
+     *        into the arrays, so clients can read but never change them.
+     *      - vertices(), sources(), targets() and layout() return copies.
+     */
+
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    /**
+     * Turns a position in the edge arrays into the edge's other vertex index and weight.
+     */
+    struct EdgeProjection {
+        const uint32_t *vertices;
+        const int *weights;
+
+        Neighbor<uint32_t> operator()(uint32_t position) const {
+            return Neighbor<uint32_t>{vertices[position], weights[position]};
+        }
+    };
+
+    /**
+     * The edges of a vertex, sorted by the index of the vertex at the other end.
+     */
+    using EdgeView = NeighborView<uint32_t, uint32_t, EdgeProjection>;
+
+    /**
+     * The arrays of a frozen graph, as described by its abstraction function.
+     */
+    struct Layout {
+        std::vector<T> labels;
+        std::vector<uint32_t> outOffsets;
+        std::vector<uint32_t> outTargets;
+        std::vector<int> outWeights;
+        std::vector<uint32_t> inOffsets;
+        std::vector<uint32_t> inSources;
+        std::vector<int> inWeights;
+    };
+
+private:
+    std::vector<T> labels;
+    std::unordered_map<T, uint32_t> indexes;
+    std::vector<uint32_t> outOffsets;
+    std::vector<uint32_t> outTargets;
+    std::vector<int> outWeights;
+    std::vector<uint32_t> inOffsets;
+    std::vector<uint32_t> inSources;
+    std::vector<int> inWeights;
+
+public:
+    /**
+     * Create an empty frozen graph.
+     */
+    FrozenGraph();
+
+    /**
+     * Freeze the vertices and edges a graph has now, later changes to the graph
+     * are not seen by the frozen graph.
+     *
+     * @param graph the graph to freeze
+     * @throws runtime_error if the graph has more than NOT_FOUND - 1 vertices or edges
+     */
+    explicit FrozenGraph(Graph<T>& graph);
+
+    /**
+     * Create a frozen graph from the arrays of another, as returned by layout().
+     * Every part of the representation invariant is checked, in time linear in
+     * the size of the graph.
+     *
+     * @param layout the arrays, moved into the graph
+     * @throws runtime_error if the arrays break the representation invariant
+     */
+    explicit FrozenGraph(Layout layout);
+
+    /**
+     * @return a copy of the arrays of the graph
+     */
+    Layout layout() const;
+
+    /**
+     * @return the number of vertices in the graph
+     */
+    uint32_t vertexCount() const;
+
+    /**
+     * @return the number of edges in the graph
+     */
+    uint32_t edgeCount() const;
+
+    /**
+     * Get the index of a vertex.
+     *
+     * @param vertex label of a vertex
+     * @return the index of the vertex, NOT_FOUND if it is not in the graph
+     */
+    uint32_t index(const T& vertex) const;
+
+    /**
+     * Get the label of a vertex.
+     *
+     * @param index index of a vertex, must be less than vertexCount()
+     * @return the label of the vertex
+     */
+    const T& label(uint32_t index) const;
+
+    /**
+     * View the edges from a vertex without copying them.
+     *
+     * @param index index of the source vertex
+     * @return the indexes of the targets and the weights of the edges, in increasing
+     *         index order, empty if index is NOT_FOUND
+     */
+    EdgeView outEdges(uint32_t index) const;
+
+    /**
+     * View the edges to a vertex without copying them.
+     *
+     * @param index index of the target vertex
+     * @return the indexes of the sources and the weights of the edges, in increasing
+     *         index order, empty if index is NOT_FOUND
+     */
+    EdgeView inEdges(uint32_t index) const;
+
+    /**
+     * Get all the vertices in this graph.
+     *
+     * @return the set of labels of vertices in this graph
+     */
+    std::unordered_set<T> vertices() const;
+
+    /**
+     * Get the source vertices with directed edges to a target vertex and the
+     * weights of those edges, as Graph::sources.
+     */
+    std::unordered_map<T, int> sources(const T& target) const;
+
+    /**
+     * Get the target vertices with directed edges from a source vertex and the
+     * weights of those edges, as Graph::targets.
+     */
+    std::unordered_map<T, int> targets(const T& source) const;
+
+private:
+    /**
+     * Reverse the edges of one direction of a layout, which must pass validEdges(),
+     * into the reversed arrays. The edges of every vertex come out sorted by the
+     * index of the vertex at the other end.
+     */
+    static void transpose(size_t vertexCount, const std::vector<uint32_t>& offsets,
+                          const std::vector<uint32_t>& ends, const std::vector<int>& weights,
+                          std::vector<uint32_t>& reversedOffsets, std::vector<uint32_t>& reversedEnds,
+                          std::vector<int>& reversedWeights);
+
+    /**
+     * Check the edges of one direction of a layout.
+     *
+     * @return true if offsets has vertexCount + 1 non decreasing values from 0 to the number
+     *         of edges, and every vertex's ends are strictly increasing indexes with positive weights
+     */
+    static bool validEdges(size_t vertexCount, const std::vector<uint32_t>& offsets,
+                           const std::vector<uint32_t>& ends, const std::vector<int>& weights);
+};
+
+/**
+ * Freeze a graph, see FrozenGraph(Graph<T>&).
+ *
+ * @param graph the graph to freeze
+ * @return the frozen graph
+ */
+template<typename T>
+FrozenGraph<T> freeze(Graph<T>& graph);
+
+#include "frozen_graph.tpp"
+
+#endif
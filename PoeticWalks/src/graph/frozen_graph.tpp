@@ -0,0 +1,198 @@
+#ifndef FROZEN_GRAPH_TPP
+#define FROZEN_GRAPH_TPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "frozen_graph.h"
+
+template<typename T>
+FrozenGraph<T>::FrozenGraph():
+    labels{}, indexes{}, outOffsets{0}, outTargets{}, outWeights{}, inOffsets{0}, inSources{}, inWeights{} {}
+
+template<typename T>
+FrozenGraph<T>::FrozenGraph(Graph<T>& graph):
+    labels{}, indexes{}, outOffsets{}, outTargets{}, outWeights{}, inOffsets{}, inSources{}, inWeights{} {
+    
+    std::unordered_set<T> vertexSet = graph.vertices();
+    if (vertexSet.size() >= NOT_FOUND) throw std::runtime_error("Too many vertices to freeze.");
+
+    labels.assign(vertexSet.begin(), vertexSet.end());
+    std::sort(labels.begin(), labels.end());
+    indexes.reserve(labels.size());
+    for (uint32_t i = 0; i < labels.size(); i++) {
+        indexes.emplace(labels[i], i);
+    }
+
+    // out edges, sorted by target per source
+    std::vector<std::pair<uint32_t, int>> edges;
+    outOffsets.reserve(labels.size() + 1);
+    outOffsets.push_back(0);
+    for (uint32_t i = 0; i < labels.size(); i++) {
+        edges.clear();
+        for (auto& [target, weight]: graph.targets(labels[i])) {
+            edges.emplace_back(indexes.at(target), weight);
+        }
+        std::sort(edges.begin(), edges.end());
+        if (outTargets.size() + edges.size() >= NOT_FOUND) throw std::runtime_error("Too many edges to freeze.");
+        for (auto& [target, weight]: edges) {
+            outTargets.push_back(target);
+            outWeights.push_back(weight);
+        }
+        outOffsets.push_back(outTargets.size());
+    }
+
+    // in edges are the transpose
+    transpose(labels.size(), outOffsets, outTargets, outWeights, inOffsets, inSources, inWeights);
+}
+
+template<typename T>
+void FrozenGraph<T>::transpose(size_t vertexCount, const std::vector<uint32_t>& offsets,
+                      const std::vector<uint32_t>& ends, const std::vector<int>& weights,
+                      std::vector<uint32_t>& reversedOffsets, std::vector<uint32_t>& reversedEnds,
+                      std::vector<int>& reversedWeights) {
+    // visiting the vertices in order keeps the reversed edges of every vertex sorted
+    reversedOffsets.assign(vertexCount + 1, 0);
+    for (uint32_t end: ends) {
+        reversedOffsets[end + 1]++;
+    }
+    for (size_t i = 0; i < vertexCount; i++) {
+        reversedOffsets[i + 1] += reversedOffsets[i];
+    }
+    reversedEnds.resize(ends.size());
+    reversedWeights.resize(ends.size());
+    std::vector<uint32_t> filled(reversedOffsets.begin(), reversedOffsets.end() - 1);
+    for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+        for (uint32_t edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++) {
+            uint32_t position = filled[ends[edge]]++;
+            reversedEnds[position] = vertex;
+            reversedWeights[position] = weights[edge];
+        }
+    }
+}
+
+template<typename T>
+bool FrozenGraph<T>::validEdges(size_t vertexCount, const std::vector<uint32_t>& offsets,
+                       const std::vector<uint32_t>& ends, const std::vector<int>& weights) {
+    if (offsets.size() != vertexCount + 1 || offsets.front() != 0 || offsets.back() != ends.size()) return false;
+    if (weights.size() != ends.size()) return false;
+
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        if (offsets[vertex] > offsets[vertex + 1]) return false;
+        for (uint32_t edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++) {
+            if (ends[edge] >= vertexCount || weights[edge] <= 0) return false;
+            if (edge > offsets[vertex] && ends[edge] <= ends[edge - 1]) return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+FrozenGraph<T>::FrozenGraph(Layout layout):
+    labels{std::move(layout.labels)}, indexes{}, outOffsets{std::move(layout.outOffsets)},
+    outTargets{std::move(layout.outTargets)}, outWeights{std::move(layout.outWeights)},
+    inOffsets{std::move(layout.inOffsets)}, inSources{std::move(layout.inSources)},
+    inWeights{std::move(layout.inWeights)} {
+
+    if (labels.size() >= NOT_FOUND || outTargets.size() >= NOT_FOUND) throw std::runtime_error("Invalid frozen graph layout.");
+    for (size_t i = 1; i < labels.size(); i++) {
+        if (!(labels[i - 1] < labels[i])) throw std::runtime_error("Invalid frozen graph layout.");
+    }
+    if (!validEdges(labels.size(), outOffsets, outTargets, outWeights)
+        || !validEdges(labels.size(), inOffsets, inSources, inWeights)
+        || inSources.size() != outTargets.size()) {
+        throw std::runtime_error("Invalid frozen graph layout.");
+    }
+
+    // the in edges must be exactly the out edges reversed
+    std::vector<uint32_t> reversedOffsets;
+    std::vector<uint32_t> reversedSources;
+    std::vector<int> reversedWeights;
+    transpose(labels.size(), outOffsets, outTargets, outWeights, reversedOffsets, reversedSources, reversedWeights);
+    if (reversedOffsets != inOffsets || reversedSources != inSources || reversedWeights != inWeights) {
+        throw std::runtime_error("Invalid frozen graph layout.");
+    }
+
+    indexes.reserve(labels.size());
+    for (uint32_t i = 0; i < labels.size(); i++) {
+        indexes.emplace(labels[i], i);
+    }
+}
+
+template<typename T>
+typename FrozenGraph<T>::Layout FrozenGraph<T>::layout() const {
+    return Layout{labels, outOffsets, outTargets, outWeights, inOffsets, inSources, inWeights};
+}
+
+template<typename T>
+uint32_t FrozenGraph<T>::vertexCount() const {
+    return labels.size();
+}
+
+template<typename T>
+uint32_t FrozenGraph<T>::edgeCount() const {
+    return outTargets.size();
+}
+
+template<typename T>
+uint32_t FrozenGraph<T>::index(const T& vertex) const {
+    auto found = indexes.find(vertex);
+    if (found == indexes.end()) return NOT_FOUND;
+    return found->second;
+}
+
+template<typename T>
+const T& FrozenGraph<T>::label(uint32_t index) const {
+    return labels[index];
+}
+
+template<typename T>
+typename FrozenGraph<T>::EdgeView FrozenGraph<T>::outEdges(uint32_t index) const {
+    EdgeProjection project{outTargets.data(), outWeights.data()};
+    if (index == NOT_FOUND) return EdgeView(0, 0, project);
+    return EdgeView(outOffsets[index], outOffsets[index + 1], project);
+}
+
+template<typename T>
+typename FrozenGraph<T>::EdgeView FrozenGraph<T>::inEdges(uint32_t index) const {
+    EdgeProjection project{inSources.data(), inWeights.data()};
+    if (index == NOT_FOUND) return EdgeView(0, 0, project);
+    return EdgeView(inOffsets[index], inOffsets[index + 1], project);
+}
+
+template<typename T>
+std::unordered_set<T> FrozenGraph<T>::vertices() const {
+    return std::unordered_set<T>(labels.begin(), labels.end());
+}
+
+template<typename T>
+std::unordered_map<T, int> FrozenGraph<T>::sources(const T& target) const {
+    std::unordered_map<T, int> output;
+    uint32_t vertex = index(target);
+    if (vertex == NOT_FOUND) return output;
+
+    for (uint32_t edge = inOffsets[vertex]; edge < inOffsets[vertex + 1]; edge++) {
+        output[labels[inSources[edge]]] = inWeights[edge];
+    }
+    return output;
+}
+
+template<typename T>
+std::unordered_map<T, int> FrozenGraph<T>::targets(const T& source) const {
+    std::unordered_map<T, int> output;
+    uint32_t vertex = index(source);
+    if (vertex == NOT_FOUND) return output;
+
+    for (uint32_t edge = outOffsets[vertex]; edge < outOffsets[vertex + 1]; edge++) {
+        output[labels[outTargets[edge]]] = outWeights[edge];
+    }
+    return output;
+}
+
+template<typename T>
+FrozenGraph<T> freeze(Graph<T>& graph) {
+    return FrozenGraph<T>(graph);
+}
+
+#endif
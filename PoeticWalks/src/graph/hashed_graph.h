@@ -0,0 +1,119 @@
+#ifndef HASHED_GRAPH_H
+#define HASHED_GRAPH_H
+
+#include <vector>
+
+#include "graph.h"
+#include "neighbor_view.h"
+
+/**
+ * A graph indexing vertices by a hash of their labels, with hashed out and in
+ * adjacency per vertex. Adding a vertex, setting an edge and looking one up
+ * take constant expected time; removing a vertex, sources() and targets() take
+ * time proportional to the number of edges of the vertex.
+ */
+template<typename T>
+class HashedGraph: public Graph<T> {
+    /**
+     * Abstraction function:
+     *      - represents a graph.
+     *      - ids maps the label of every vertex to its id, an index in labels, outEdges and inEdges
+     *      - outEdges[id] maps the ids of the targets of vertex id to the weights of its edges
+     *      - inEdges[id] maps the ids of the sources of vertex id to the weights of their edges
+     *      - freeIds holds the ids of removed vertices, reused by the next added vertices
+     *
+     * Representation invariant:
+     *      - every id in 0..labels.size() - 1 is either a value of ids or in freeIds, never both
+     *      - labels[ids[label]] == label for every label in ids
+     *      - outEdges[source][target] == weight iff inEdges[target][source] == weight
+     *      - for all edges, weight > 0
+     *      - outEdges[id] and inEdges[id] are empty for every id in freeIds
+     *      - noEdges is empty, it backs the views of vertices not in the graph
+     *
+     * Safety from rep exposure:
+     *      - labels are copied in and out using copy constructor.
+     *      - getter functions returns by value, so a copy is made every time.
+     *      - views only hold const references to the adjacency.
+     */
+
+public:
+    using EdgeMap = std::unordered_map<int, int>;
+
+    /**
+     * Turns an entry of an adjacency map into the label of the edge's other vertex and its weight.
+     */
+    struct EdgeProjection {
+        const std::vector<T> *labels;
+
+        Neighbor<T> operator()(EdgeMap::const_iterator edge) const {
+            return Neighbor<T>{(*labels)[edge->first], edge->second};
+        }
+    };
+
+    /**
+     * The edges of a vertex, in no particular order.
+     */
+    using EdgeView = NeighborView<T, EdgeMap::const_iterator, EdgeProjection>;
+
+private:
+    std::unordered_map<T, int> ids;
+    std::vector<T> labels;
+    std::vector<EdgeMap> outEdges;
+    std::vector<EdgeMap> inEdges;
+    EdgeMap noEdges;
+    std::vector<int> freeIds;
+
+public:
+    HashedGraph();
+
+    ~HashedGraph() override;
+
+    bool add(T vertex) override;
+
+    int set(T source, T target, int weight) override;
+
+    bool remove(T vertex) override;
+
+    std::unordered_set<T> vertices() override;
+
+    std::unordered_map<T, int> sources(T target) override;
+
+    std::unordered_map<T, int> targets(T source) override;
+
+    /**
+     * View the edges to a vertex without copying them, as sources(target).
+     *
+     * @param target a label
+     * @return the sources and weights of the edges to target, empty if target is not in the graph
+     */
+    EdgeView sourcesView(const T& target) const;
+
+    /**
+     * View the edges from a vertex without copying them, as targets(source).
+     *
+     * @param source a label
+     * @return the targets and weights of the edges from source, empty if source is not in the graph
+     */
+    EdgeView targetsView(const T& source) const;
+
+private:
+    /**
+     * Returns the id of a vertex, adding the vertex to the graph if it does not exist.
+     *
+     * @param vertex label of the vertex
+     * @return the id of the vertex
+     */
+    int findOrAddVertex(T vertex);
+
+    /**
+     * Returns the edges of an adjacency index keyed by labels instead of ids.
+     *
+     * @param edges the out or in edges of a vertex
+     * @return a map from the label of each vertex at the other end to the edge's weight
+     */
+    std::unordered_map<T, int> labelEdges(const std::unordered_map<int, int>& edges);
+};
+
+#include "hashed_graph.tpp"
+
+#endif
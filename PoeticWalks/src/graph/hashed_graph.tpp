@@ -0,0 +1,140 @@
+#ifndef HASHED_GRAPH_TPP
+#define HASHED_GRAPH_TPP
+
+#include <stdexcept>
+
+#include "hashed_graph.h"
+
+template<typename T>
+HashedGraph<T>::HashedGraph():
+    ids{}, labels{}, outEdges{}, inEdges{}, noEdges{}, freeIds{} {}
+
+template<typename T>
+HashedGraph<T>::~HashedGraph() {}
+
+template<typename T>
+bool HashedGraph<T>::add(T vertex) {
+    if (ids.find(vertex) != ids.end()) return false;
+
+    findOrAddVertex(vertex);
+    return true;
+}
+
+template<typename T>
+int HashedGraph<T>::set(T source, T target, int weight) {
+    if (weight < 0) throw std::domain_error("Edge weight cannot be negative.");
+
+    if (weight == 0) {
+        auto sourceId = ids.find(source);
+        auto targetId = ids.find(target);
+        if (sourceId == ids.end() || targetId == ids.end()) return 0;
+
+        std::unordered_map<int, int>& targetsMap = outEdges[sourceId->second];
+        auto edge = targetsMap.find(targetId->second);
+        if (edge == targetsMap.end()) return 0;
+
+        int previousWeight = edge->second;
+        targetsMap.erase(edge);
+        inEdges[targetId->second].erase(sourceId->second);
+        return previousWeight;
+    }
+
+    int sourceId = findOrAddVertex(source);
+    int targetId = findOrAddVertex(target);
+
+    int& edgeWeight = outEdges[sourceId][targetId];
+    int previousWeight = edgeWeight;
+    edgeWeight = weight;
+    inEdges[targetId][sourceId] = weight;
+    return previousWeight;
+}
+
+template<typename T>
+bool HashedGraph<T>::remove(T vertex) {
+    auto found = ids.find(vertex);
+    if (found == ids.end()) return false;
+
+    int id = found->second;
+    for (auto& [targetId, weight]: outEdges[id]) inEdges[targetId].erase(id);
+    for (auto& [sourceId, weight]: inEdges[id]) outEdges[sourceId].erase(id);
+
+    // a self loop is in both maps of the vertex, both are cleared
+    outEdges[id].clear();
+    inEdges[id].clear();
+    ids.erase(found);
+    freeIds.push_back(id);
+    return true;
+}
+
+template<typename T>
+std::unordered_set<T> HashedGraph<T>::vertices() {
+    std::unordered_set<T> output;
+    output.reserve(ids.size());
+    for (auto& [label, id]: ids) {
+        output.insert(label);
+    }
+    return output;
+}
+
+template<typename T>
+std::unordered_map<T, int> HashedGraph<T>::sources(T target) {
+    auto found = ids.find(target);
+    if (found == ids.end()) return std::unordered_map<T, int>();
+
+    return labelEdges(inEdges[found->second]);
+}
+
+template<typename T>
+std::unordered_map<T, int> HashedGraph<T>::targets(T source) {
+    auto found = ids.find(source);
+    if (found == ids.end()) return std::unordered_map<T, int>();
+
+    return labelEdges(outEdges[found->second]);
+}
+
+template<typename T>
+typename HashedGraph<T>::EdgeView HashedGraph<T>::sourcesView(const T& target) const {
+    auto found = ids.find(target);
+    const EdgeMap& edges = found == ids.end() ? noEdges : inEdges[found->second];
+    return EdgeView(edges.begin(), edges.end(), EdgeProjection{&labels});
+}
+
+template<typename T>
+typename HashedGraph<T>::EdgeView HashedGraph<T>::targetsView(const T& source) const {
+    auto found = ids.find(source);
+    const EdgeMap& edges = found == ids.end() ? noEdges : outEdges[found->second];
+    return EdgeView(edges.begin(), edges.end(), EdgeProjection{&labels});
+}
+
+template<typename T>
+int HashedGraph<T>::findOrAddVertex(T vertex) {
+    auto found = ids.find(vertex);
+    if (found != ids.end()) return found->second;
+
+    int id;
+    if (freeIds.empty()) {
+        id = labels.size();
+        labels.push_back(vertex);
+        outEdges.emplace_back();
+        inEdges.emplace_back();
+    }
+    else {
+        id = freeIds.back();
+        freeIds.pop_back();
+        labels[id] = vertex;
+    }
+    ids.emplace(vertex, id);
+    return id;
+}
+
+template<typename T>
+std::unordered_map<T, int> HashedGraph<T>::labelEdges(const std::unordered_map<int, int>& edges) {
+    std::unordered_map<T, int> output;
+    output.reserve(edges.size());
+    for (auto& [id, weight]: edges) {
+        output[labels[id]] = weight;
+    }
+    return output;
+}
+
+#endif
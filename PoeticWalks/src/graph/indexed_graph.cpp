@@ -0,0 +1,97 @@
+#include "indexed_graph.h"
+
+#include <stdexcept>
+
+static const IndexedGraph::EdgeMap NO_EDGES{};
+
+IndexedGraph::IndexedGraph():
+    present{}, outEdges{}, inEdges{}, vertexCount{0} {}
+
+IndexedGraph::~IndexedGraph() {}
+
+bool IndexedGraph::add(uint32_t vertex) {
+    if (contains(vertex)) return false;
+
+    if (vertex >= present.size()) {
+        present.resize((size_t) vertex + 1);
+        outEdges.resize((size_t) vertex + 1);
+        inEdges.resize((size_t) vertex + 1);
+    }
+    present[vertex] = true;
+    vertexCount++;
+    return true;
+}
+
+int IndexedGraph::set(uint32_t source, uint32_t target, int weight) {
+    if (weight < 0) throw std::domain_error("Edge weight cannot be negative.");
+
+    if (weight == 0) {
+        if (!contains(source) || !contains(target)) return 0;
+
+        auto edge = outEdges[source].find(target);
+        if (edge == outEdges[source].end()) return 0;
+
+        int previousWeight = edge->second;
+        outEdges[source].erase(edge);
+        inEdges[target].erase(source);
+        return previousWeight;
+    }
+
+    add(source);
+    add(target);
+
+    int& edgeWeight = outEdges[source][target];
+    int previousWeight = edgeWeight;
+    edgeWeight = weight;
+    inEdges[target][source] = weight;
+    return previousWeight;
+}
+
+bool IndexedGraph::remove(uint32_t vertex) {
+    if (!contains(vertex)) return false;
+
+    for (auto& [target, weight]: outEdges[vertex]) inEdges[target].erase(vertex);
+    for (auto& [source, weight]: inEdges[vertex]) outEdges[source].erase(vertex);
+
+    // a self loop is in both maps of the vertex, both are cleared
+    outEdges[vertex].clear();
+    inEdges[vertex].clear();
+    present[vertex] = false;
+    vertexCount--;
+    return true;
+}
+
+std::unordered_set<uint32_t> IndexedGraph::vertices() {
+    std::unordered_set<uint32_t> output;
+    output.reserve(vertexCount);
+    for (uint32_t i = 0; i < present.size(); i++) {
+        if (present[i]) output.insert(i);
+    }
+    return output;
+}
+
+std::unordered_map<uint32_t, int> IndexedGraph::sources(uint32_t target) {
+    if (!contains(target)) return std::unordered_map<uint32_t, int>();
+
+    return inEdges[target];
+}
+
+std::unordered_map<uint32_t, int> IndexedGraph::targets(uint32_t source) {
+    if (!contains(source)) return std::unordered_map<uint32_t, int>();
+
+    return outEdges[source];
+}
+
+IndexedGraph::EdgeView IndexedGraph::sourcesView(uint32_t target) const {
+    const EdgeMap& edges = contains(target) ? inEdges[target] : NO_EDGES;
+    return EdgeView(edges.begin(), edges.end(), EdgeProjection{});
+}
+
+IndexedGraph::EdgeView IndexedGraph::targetsView(uint32_t source) const {
+    const EdgeMap& edges = contains(source) ? outEdges[source] : NO_EDGES;
+    return EdgeView(edges.begin(), edges.end(), EdgeProjection{});
+}
+
+bool IndexedGraph::contains(uint32_t vertex) const {
+    return vertex < present.size() && present[vertex];
+}
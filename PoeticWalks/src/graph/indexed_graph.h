@@ -0,0 +1,100 @@
+#ifndef INDEXED_GRAPH_H
+#define INDEXED_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "neighbor_view.h"
+
+/**
+ * A graph whose vertex labels are dense integer ids, such as the ids of a
+ * symbol table. A vertex is found by indexing with its label, so only the
+ * per-vertex adjacency is hashed, on integers. Memory grows with the largest
+ * label in the graph.
+ */
+class IndexedGraph: public Graph<uint32_t> {
+    /**
+     * Abstraction function:
+     *      - represents a graph.
+     *      - vertex id is in the graph iff present[id]
+     *      - outEdges[id] maps the targets of vertex id to the weights of its edges
+     *      - inEdges[id] maps the sources of vertex id to the weights of their edges
+     *
+     * Representation invariant:
+     *      - present, outEdges and inEdges have the same size
+     *      - vertexCount is the number of true values in present
+     *      - outEdges[source][target] == weight iff inEdges[target][source] == weight
+     *      - for all edges, weight > 0 and both vertices are present
+     *
+     * Safety from rep exposure:
+     *      - labels are integers copied by value
+     *      - getter functions returns by value, so a copy is made every time.
+     *      - views only hold const references to the adjacency.
+     */
+
+public:
+    using EdgeMap = std::unordered_map<uint32_t, int>;
+
+    /**
+     * Turns an entry of an adjacency map into the edge's other vertex and weight.
+     */
+    struct EdgeProjection {
+        Neighbor<uint32_t> operator()(EdgeMap::const_iterator edge) const {
+            return Neighbor<uint32_t>{edge->first, edge->second};
+        }
+    };
+
+    /**
+     * The edges of a vertex, in no particular order.
+     */
+    using EdgeView = NeighborView<uint32_t, EdgeMap::const_iterator, EdgeProjection>;
+
+private:
+    std::vector<bool> present;
+    std::vector<EdgeMap> outEdges;
+    std::vector<EdgeMap> inEdges;
+    uint32_t vertexCount;
+
+public:
+    IndexedGraph();
+
+    ~IndexedGraph() override;
+
+    bool add(uint32_t vertex) override;
+
+    int set(uint32_t source, uint32_t target, int weight) override;
+
+    bool remove(uint32_t vertex) override;
+
+    std::unordered_set<uint32_t> vertices() override;
+
+    std::unordered_map<uint32_t, int> sources(uint32_t target) override;
+
+    std::unordered_map<uint32_t, int> targets(uint32_t source) override;
+
+    /**
+     * View the edges to a vertex without copying them, as sources(target).
+     *
+     * @param target a label
+     * @return the sources and weights of the edges to target, empty if target is not in the graph
+     */
+    EdgeView sourcesView(uint32_t target) const;
+
+    /**
+     * View the edges from a vertex without copying them, as targets(source).
+     *
+     * @param source a label
+     * @return the targets and weights of the edges from source, empty if source is not in the graph
+     */
+    EdgeView targetsView(uint32_t source) const;
+
+private:
+    /**
+     * @param vertex label of a vertex
+     * @return whether the vertex is in the graph
+     */
+    bool contains(uint32_t vertex) const;
+};
+
+#endif
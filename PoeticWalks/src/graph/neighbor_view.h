@@ -0,0 +1,92 @@
+#ifndef NEIGHBOR_VIEW_H
+#define NEIGHBOR_VIEW_H
+
+/**
+ * An edge seen from one of its ends: the vertex at the other end and the
+ * edge's weight. The vertex is borrowed from the graph.
+ *
+ * @param <L> type of vertex labels
+ */
+template<typename L>
+struct Neighbor {
+    const L& vertex;
+    const int weight;
+};
+
+/**
+ * A range over the edges of a vertex that reads the graph's adjacency in place,
+ * without copying it. Iterating walks positions first..last of the adjacency and
+ * turns each position into a Neighbor with project.
+ *
+ * A view, and every iterator taken from it, is invalidated by any change to its graph.
+ *
+ * @param <L> type of vertex labels
+ * @param <Position> a position in the adjacency, such as an index or a map iterator
+ * @param <Projection> callable turning a position into a Neighbor<L>
+ */
+template<typename L, typename Position, typename Projection>
+class NeighborView {
+    /**
+     * Abstraction function:
+     *      - represents the edges project(p) for p from first up to, not including, last
+     *
+     * Representation invariant:
+     *      - last is reachable from first by incrementing
+     *
+     * Safety from rep exposure:
+     *      - neighbors only hold const references to the graph
+     */
+public:
+    /**
+     * Iterators carry their own projection, so they stay valid when the view
+     * they came from is gone.
+     */
+    class Iterator {
+    public:
+        Iterator(Position position, Projection project):
+            position{position}, project{project} {}
+
+        Neighbor<L> operator*() const {
+            return project(position);
+        }
+
+        Iterator& operator++() {
+            ++position;
+            return *this;
+        }
+
+        bool operator==(const Iterator& that) const {
+            return position == that.position;
+        }
+
+        bool operator!=(const Iterator& that) const {
+            return position != that.position;
+        }
+
+    private:
+        Position position;
+        Projection project;
+    };
+
+    NeighborView(Position first, Position last, Projection project):
+        first{first}, last{last}, project{project} {}
+
+    Iterator begin() const {
+        return Iterator(first, project);
+    }
+
+    Iterator end() const {
+        return Iterator(last, project);
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+private:
+    Position first;
+    Position last;
+    Projection project;
+};
+
+#endif
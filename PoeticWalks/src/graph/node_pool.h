@@ -0,0 +1,94 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * A typed slab allocator for the nodes of a linked graph. Nodes are made in
+ * slabs of contiguous slots, so nodes made one after another sit next to each
+ * other in memory, and a destroyed node's slot is reused by the next node made.
+ * A node keeps its address until it is destroyed.
+ *
+ * Nodes still alive when the pool is destroyed are freed without running their
+ * destructors, so the owner of the pool destroys them first.
+ *
+ * @param <N> type of the nodes
+ */
+template<typename N>
+class NodePool {
+    /**
+     * Abstraction function:
+     *      - represents the nodes constructed in the slots of slabs and not yet destroyed
+     *      - freeSlots is a list, linked through next, of the slots whose node was destroyed
+     *      - slabSize is the number of slots of the last slab, and its slots from
+     *        slabUsed on have never held a node
+     *
+     * Representation invariant:
+     *      - slab i has min(FIRST_SLAB_SIZE * 2^i, MAX_SLAB_SIZE) slots
+     *      - slabUsed <= slabSize, both 0 if there are no slabs
+     *      - a slot holds a node, is in freeSlots, or is past slabUsed in the last slab
+     *      - liveNodes is the number of slots holding a node
+     *
+     * Safety from rep exposure:
+     *      - the pool is neither copied nor moved, nodes are only reachable
+     *        through the pointers create() returns
+     */
+private:
+    union Slot {
+        Slot *next;
+        alignas(N) unsigned char node[sizeof(N)];
+    };
+
+    static constexpr size_t FIRST_SLAB_SIZE = 64;
+    static constexpr size_t MAX_SLAB_SIZE = 65536;
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    size_t slabSize;
+    size_t slabUsed;
+    Slot *freeSlots;
+    size_t liveNodes;
+
+public:
+    /**
+     * Create an empty pool, which allocates no memory until the first node is made.
+     */
+    NodePool();
+
+    NodePool(const NodePool&) = delete;
+
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * Construct a node in a free slot of the pool.
+     *
+     * @param arguments the arguments of a constructor of N
+     * @return the node, valid until it is given to destroy()
+     */
+    template<typename... Args>
+    N* create(Args&&... arguments);
+
+    /**
+     * Destruct a node made by create() and free its slot for the next node.
+     *
+     * @param node a node of this pool, not destroyed yet
+     */
+    void destroy(N *node);
+
+    /**
+     * @return the number of nodes made and not yet destroyed
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @return a slot that holds no node, taken off freeSlots or the last slab,
+     *         after allocating a new slab if both are used up
+     */
+    Slot* takeSlot();
+};
+
+#include "node_pool.tpp"
+
+#endif
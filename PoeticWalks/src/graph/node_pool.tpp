@@ -0,0 +1,61 @@
+#ifndef NODE_POOL_TPP
+#define NODE_POOL_TPP
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "node_pool.h"
+
+template<typename N>
+NodePool<N>::NodePool():
+    slabs{}, slabSize{0}, slabUsed{0}, freeSlots{nullptr}, liveNodes{0} {}
+
+template<typename N>
+template<typename... Args>
+N* NodePool<N>::create(Args&&... arguments) {
+    Slot *slot = takeSlot();
+    N *node;
+    try {
+        node = new ((*slot).node) N(std::forward<Args>(arguments)...);
+    } catch (...) {
+        (*slot).next = freeSlots;
+        freeSlots = slot;
+        throw;
+    }
+    liveNodes++;
+    return node;
+}
+
+template<typename N>
+void NodePool<N>::destroy(N *node) {
+    (*node).~N();
+    Slot *slot = reinterpret_cast<Slot*>(node);
+    (*slot).next = freeSlots;
+    freeSlots = slot;
+    liveNodes--;
+}
+
+template<typename N>
+size_t NodePool<N>::size() const {
+    return liveNodes;
+}
+
+template<typename N>
+typename NodePool<N>::Slot* NodePool<N>::takeSlot() {
+    if (freeSlots != nullptr) {
+        Slot *slot = freeSlots;
+        freeSlots = (*slot).next;
+        return slot;
+    }
+
+    if (slabUsed == slabSize) {
+        // slabs double in size up to a limit, so few slabs are allocated and an unused tail stays small
+        slabSize = slabs.empty() ? FIRST_SLAB_SIZE : std::min(slabSize * 2, MAX_SLAB_SIZE);
+        slabs.push_back(std::unique_ptr<Slot[]>(new Slot[slabSize]));
+        slabUsed = 0;
+    }
+    return &slabs.back()[slabUsed++];
+}
+
+#endif
@@ -0,0 +1,170 @@
+#include "bridge_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.h"
+
+#define FIBONACCI_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+static const Bridge NO_BRIDGE{FrozenGraph<uint32_t>::NOT_FOUND, 0};
+
+/**
+ * @return the key of a pair of vertices
+ */
+static inline uint64_t pairKey(uint32_t source, uint32_t target) {
+    return (uint64_t) source << 32 | target;
+}
+
+Bridge findBridge(const FrozenGraph<uint32_t>& graph, uint32_t source, uint32_t target) {
+    FrozenGraph<uint32_t>::EdgeView targets = graph.outEdges(source);
+    FrozenGraph<uint32_t>::EdgeView sources = graph.inEdges(target);
+
+    Bridge bridge = NO_BRIDGE;
+    auto out = targets.begin();
+    auto in = sources.begin();
+    while (out != targets.end() && in != sources.end()) {
+        Neighbor<uint32_t> first = *out;
+        Neighbor<uint32_t> second = *in;
+        if (first.vertex < second.vertex) {
+            ++out;
+            continue;
+        }
+        if (second.vertex < first.vertex) {
+            ++in;
+            continue;
+        }
+        if (first.weight + second.weight > bridge.weight) bridge = Bridge{first.vertex, first.weight + second.weight};
+        ++out;
+        ++in;
+    }
+    return bridge;
+}
+
+BridgeIndex::BridgeIndex():
+    slots(2, Slot{EMPTY, NO_BRIDGE}), used{0} {}
+
+BridgeIndex::BridgeIndex(const FrozenGraph<uint32_t>& graph, unsigned threads, uint64_t maxPaths):
+    BridgeIndex() {
+    uint32_t vertexCount = graph.vertexCount();
+    uint64_t paths = 0;
+    for (uint32_t middle = 0; middle < vertexCount; middle++) {
+        FrozenGraph<uint32_t>::EdgeView sources = graph.inEdges(middle);
+        FrozenGraph<uint32_t>::EdgeView targets = graph.outEdges(middle);
+        uint64_t in = 0;
+        uint64_t out = 0;
+        for (auto source = sources.begin(); source != sources.end(); ++source) in++;
+        for (auto target = targets.begin(); target != targets.end(); ++target) out++;
+        paths += in * out;
+    }
+    if (paths > maxPaths) throw std::length_error("Too many paths to index bridges.");
+
+    // sources are dealt out in turn, the first words of a corpus tend to have the most edges
+    threads = std::max(threads, 1u);
+    std::vector<std::vector<Slot>> found(threads);
+    runParallel(threads, [&graph, &found, vertexCount, threads](size_t thread) {
+        std::vector<int> weights(vertexCount, 0);
+        std::vector<uint32_t> bridges(vertexCount);
+        std::vector<uint32_t> targets;
+        for (uint32_t source = thread; source < vertexCount; source += threads) {
+            // middles come in increasing index order so ties keep the lowest
+            for (Neighbor<uint32_t> middle: graph.outEdges(source)) {
+                for (Neighbor<uint32_t> target: graph.outEdges(middle.vertex)) {
+                    int weight = middle.weight + target.weight;
+                    if (weight <= weights[target.vertex]) continue;
+
+                    if (weights[target.vertex] == 0) targets.push_back(target.vertex);
+                    weights[target.vertex] = weight;
+                    bridges[target.vertex] = middle.vertex;
+                }
+            }
+
+            for (uint32_t target: targets) {
+                found[thread].push_back(Slot{pairKey(source, target), Bridge{bridges[target], weights[target]}});
+                weights[target] = 0;
+            }
+            targets.clear();
+        }
+    });
+
+    size_t total = 0;
+    for (const std::vector<Slot>& slotsFound: found) total += slotsFound.size();
+    size_t slotCount = 2;
+    while (slotCount <= total * 2) slotCount *= 2;
+    slots.assign(slotCount, Slot{EMPTY, NO_BRIDGE});
+    for (std::vector<Slot>& slotsFound: found) {
+        for (const Slot& slot: slotsFound) slots[find(slot.key)] = slot;
+        std::vector<Slot>().swap(slotsFound);
+    }
+    used = total;
+}
+
+Bridge BridgeIndex::find(uint32_t source, uint32_t target) const {
+    if (source == FrozenGraph<uint32_t>::NOT_FOUND || target == FrozenGraph<uint32_t>::NOT_FOUND) return NO_BRIDGE;
+    const Slot& slot = slots[find(pairKey(source, target))];
+    return slot.key == EMPTY ? NO_BRIDGE : slot.bridge;
+}
+
+size_t BridgeIndex::size() const {
+    return used;
+}
+
+size_t BridgeIndex::find(uint64_t key) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = (key * FIBONACCI_MULTIPLIER) >> 32 & mask;
+    while (slots[slot].key != key && slots[slot].key != EMPTY) slot = (slot + 1) & mask;
+    return slot;
+}
+
+BridgeCache::BridgeCache(size_t capacity):
+    shardCapacity{(capacity + SHARD_COUNT - 1) / SHARD_COUNT}, shards{new Shard[SHARD_COUNT]} {
+    if (capacity == 0) throw std::domain_error("Cache capacity must be positive.");
+    for (size_t i = 0; i < SHARD_COUNT; i++) shards[i].positions.reserve(shardCapacity);
+}
+
+Bridge BridgeCache::find(const FrozenGraph<uint32_t>& graph, uint32_t source, uint32_t target) {
+    if (source == FrozenGraph<uint32_t>::NOT_FOUND || target == FrozenGraph<uint32_t>::NOT_FOUND) return NO_BRIDGE;
+
+    uint64_t key = pairKey(source, target);
+    Shard& shard = shardOf(key);
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto position = shard.positions.find(key);
+        if (position != shard.positions.end()) {
+            shard.recent.splice(shard.recent.begin(), shard.recent, position->second);
+            return position->second->bridge;
+        }
+    }
+
+    // the graph is searched without the lock, another thread may cache the pair meanwhile
+    Bridge bridge = findBridge(graph, source, target);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if (shard.positions.count(key) != 0) return bridge;
+
+    if (shard.recent.size() < shardCapacity) {
+        shard.recent.push_front(Entry{key, bridge});
+        shard.positions.emplace(key, shard.recent.begin());
+        return bridge;
+    }
+
+    // the least recently used entry and its map node are reused for the new pair
+    shard.recent.splice(shard.recent.begin(), shard.recent, std::prev(shard.recent.end()));
+    auto node = shard.positions.extract(shard.recent.front().key);
+    shard.recent.front() = Entry{key, bridge};
+    node.key() = key;
+    shard.positions.insert(std::move(node));
+    return bridge;
+}
+
+size_t BridgeCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        total += shards[i].recent.size();
+    }
+    return total;
+}
+
+BridgeCache::Shard& BridgeCache::shardOf(uint64_t key) const {
+    return shards[(key * FIBONACCI_MULTIPLIER) >> 60 & (SHARD_COUNT - 1)];
+}
@@ -0,0 +1,180 @@
+#ifndef BRIDGE_INDEX_H
+#define BRIDGE_INDEX_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "frozen_graph.h"
+
+/**
+ * The bridge from a source to a target vertex: the vertex b maximizing the weight
+ * of source -> b plus the weight of b -> target, the lowest index among ties.
+ */
+struct Bridge {
+    uint32_t vertex;
+    int weight;
+};
+
+/**
+ * Find a bridge by intersecting the out edges of the source with the in edges of
+ * the target, both sorted so they are intersected in one pass.
+ *
+ * @param graph the frozen word graph
+ * @param source index of the source vertex, or NOT_FOUND
+ * @param target index of the target vertex, or NOT_FOUND
+ * @return the bridge, with vertex NOT_FOUND and weight 0 if there is none
+ */
+Bridge findBridge(const FrozenGraph<uint32_t>& graph, uint32_t source, uint32_t target);
+
+/**
+ * The bridges of every pair of vertices of a frozen graph, computed ahead of time
+ * so finding one is a single probe of a flat hash table.
+ */
+class BridgeIndex {
+    /**
+     * Abstraction function:
+     *      - represents the bridge slot.bridge from vertex slot.key >> 32 to vertex
+     *        slot.key & UINT32_MAX for every slot whose key is not EMPTY
+     *      - pairs of vertices in no slot have no bridge
+     *
+     * Representation invariant:
+     *      - slots.size() is a power of two, more than twice used
+     *      - used is the number of slots whose key is not EMPTY
+     *      - a key is in the first slot found by linear probing from its hash that
+     *        holds it or is EMPTY
+     *
+     * Safety from rep exposure:
+     *      - bridges are returned by value
+     */
+public:
+    static constexpr uint64_t DEFAULT_MAX_PATHS = (uint64_t) 1 << 28;
+
+private:
+    struct Slot {
+        uint64_t key;
+        Bridge bridge;
+    };
+
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    std::vector<Slot> slots;
+    size_t used;
+
+public:
+    /**
+     * Create an index with no bridges.
+     */
+    BridgeIndex();
+
+    /**
+     * Index the bridges of a graph. Every path of two edges is followed once, the
+     * sources being split among threads. The index holds a slot per pair of vertices
+     * joined by such a path, which for a large corpus nears the square of its vocabulary.
+     *
+     * @param graph the frozen word graph, later bridges are found by its indexes
+     * @param threads number of threads following paths, at least 1
+     * @param maxPaths the most paths of two edges the graph may have
+     * @throws length_error if the graph has more than maxPaths paths of two edges
+     */
+    explicit BridgeIndex(const FrozenGraph<uint32_t>& graph, unsigned threads = 1, uint64_t maxPaths = DEFAULT_MAX_PATHS);
+
+    /**
+     * Find a bridge, as findBridge on the indexed graph.
+     *
+     * @param source index of the source vertex, or NOT_FOUND
+     * @param target index of the target vertex, or NOT_FOUND
+     * @return the bridge, with vertex NOT_FOUND and weight 0 if there is none
+     */
+    Bridge find(uint32_t source, uint32_t target) const;
+
+    /**
+     * @return the number of pairs of vertices with a bridge
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @return the slot of a key, or the EMPTY slot where it would go
+     */
+    size_t find(uint64_t key) const;
+};
+
+/**
+ * The bridges of the most recently used pairs of vertices, found by findBridge on
+ * a miss. Safe to use from several threads, pairs are split among shards that
+ * each have their own lock.
+ */
+class BridgeCache {
+    /**
+     * Abstraction function:
+     *      - represents the bridge entry.bridge from vertex entry.key >> 32 to vertex
+     *        entry.key & UINT32_MAX for every entry of the recent lists of shards
+     *      - a shard's recent list is ordered from the most to the least recently used
+     *
+     * Representation invariant:
+     *      - a key is in the shard shardOf(key) only, at most once
+     *      - positions maps the key of every entry of recent to its position in recent
+     *      - recent.size() <= shardCapacity
+     *
+     * Safety from rep exposure:
+     *      - bridges are returned by value
+     *      - a shard's lists are only used under its lock
+     */
+private:
+    struct Entry {
+        uint64_t key;
+        Bridge bridge;
+    };
+
+    struct Shard {
+        std::mutex lock;
+        std::list<Entry> recent;
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> positions;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    size_t shardCapacity;
+    std::unique_ptr<Shard[]> shards;
+
+public:
+    BridgeCache() = delete;
+
+    BridgeCache(const BridgeCache& that) = delete;
+
+    BridgeCache& operator=(const BridgeCache& that) = delete;
+
+    /**
+     * Create an empty cache.
+     *
+     * @param capacity the most pairs the cache holds, rounded up to a multiple of 16, must be positive
+     */
+    explicit BridgeCache(size_t capacity);
+
+    /**
+     * Find a bridge, as findBridge, remembering it as the most recently used.
+     *
+     * @param graph the frozen word graph, the same for every call
+     * @param source index of the source vertex, or NOT_FOUND
+     * @param target index of the target vertex, or NOT_FOUND
+     * @return the bridge, with vertex NOT_FOUND and weight 0 if there is none
+     */
+    Bridge find(const FrozenGraph<uint32_t>& graph, uint32_t source, uint32_t target);
+
+    /**
+     * @return the number of pairs cached
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @return the shard a key goes in
+     */
+    Shard& shardOf(uint64_t key) const;
+};
+
+#endif
@@ -0,0 +1,292 @@
+#include "corpus.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "parallel.h"
+#include "tokenizer.h"
+
+#define WORD_MAX 1024
+#define READ_BLOCK 1048576
+#define SHARD_MIN 16384
+#define SEGMENT_SIZE 65536
+#define INITIAL_SLOTS 1024
+#define FIBONACCI_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+Corpus::File::File(int fd):
+    mapped{nullptr}, length{0}, buffer{} {
+    struct stat status;
+    if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        void *pointer = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pointer != MAP_FAILED) {
+            madvise(pointer, status.st_size, MADV_SEQUENTIAL);
+            mapped = (char *) pointer;
+            length = status.st_size;
+            return;
+        }
+    }
+
+    // pipes and other files that cannot be mapped are read in large blocks
+    size_t used = 0;
+    ssize_t count;
+    do {
+        buffer.resize(used + READ_BLOCK);
+        count = read(fd, &buffer[used], READ_BLOCK);
+        if (count > 0) used += count;
+    } while (count > 0);
+    buffer.resize(used);
+    if (count == -1) throw std::runtime_error("File not found/read failed.");
+}
+
+Corpus::File::~File() {
+    if (mapped != nullptr) munmap(mapped, length);
+}
+
+std::string_view Corpus::File::content() const {
+    if (mapped != nullptr) return std::string_view(mapped, length);
+    return buffer;
+}
+
+Corpus::BigramCounts::BigramCounts():
+    slots(INITIAL_SLOTS, Slot{EMPTY, 0}), used{0} {}
+
+void Corpus::BigramCounts::add(uint32_t source, uint32_t target, int count) {
+    uint64_t key = (uint64_t) source << 32 | target;
+    size_t slot = find(key);
+    if (slots[slot].key == key) {
+        slots[slot].count += count;
+        return;
+    }
+
+    slots[slot] = Slot{key, count};
+    if (++used * 2 > slots.size()) grow();
+}
+
+int Corpus::BigramCounts::count(uint32_t source, uint32_t target) const {
+    const Slot& slot = slots[find((uint64_t) source << 32 | target)];
+    return slot.key == EMPTY ? 0 : slot.count;
+}
+
+size_t Corpus::BigramCounts::size() const {
+    return used;
+}
+
+size_t Corpus::BigramCounts::find(uint64_t key) const {
+    // the high bits of a fibonacci hash mix both words of the key
+    size_t mask = slots.size() - 1;
+    size_t slot = (key * FIBONACCI_MULTIPLIER) >> 32 & mask;
+    while (slots[slot].key != key && slots[slot].key != EMPTY) slot = (slot + 1) & mask;
+    return slot;
+}
+
+void Corpus::BigramCounts::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{EMPTY, 0});
+    old.swap(slots);
+    for (const Slot& slot: old) {
+        if (slot.key != EMPTY) slots[find(slot.key)] = slot;
+    }
+}
+
+/**
+ * Count the bigrams of a text as countBigrams does, and find the words at both ends
+ * of the text so the bigram across two consecutive texts can be counted.
+ *
+ * @param firstWord set to the id of the first word, NOT_FOUND if the text starts with an empty word
+ * @return the id of the last word, NOT_FOUND if the text ends with an empty word
+ */
+static uint32_t countChain(std::string_view text, SymbolTable& symbols, Corpus::BigramCounts& counts, uint32_t& firstWord) {
+    uint32_t lastWord = SymbolTable::NOT_FOUND;
+    bool first = true;
+    auto countWord = [&](std::string_view word) {
+        if (word.size() >= WORD_MAX) throw std::runtime_error("Word is too long.");
+
+        // an empty word breaks the chain of words
+        uint32_t newWord = SymbolTable::NOT_FOUND;
+        if (!word.empty()) {
+            newWord = symbols.intern(word);
+            if (lastWord != SymbolTable::NOT_FOUND) counts.add(lastWord, newWord);
+        }
+        if (first) firstWord = newWord;
+        first = false;
+        lastWord = newWord;
+    };
+
+    // the text is lower cased a segment at a time, each segment ending at a separator
+    std::vector<char> lowerCase;
+    size_t start = 0;
+    do {
+        size_t end = std::min(text.size(), start + SEGMENT_SIZE);
+        while (end < text.size() && text[end] != ' ' && text[end] != '\n') end++;
+
+        if (lowerCase.size() < end - start) lowerCase.resize(end - start);
+        Tokenizer::lowerCase(text.substr(start, end - start), lowerCase.data());
+        Tokenizer::forEachSeparated(std::string_view(lowerCase.data(), end - start), countWord);
+        start = end + 1;
+    } while (start <= text.size());
+    return lastWord;
+}
+
+void Corpus::countBigrams(std::string_view text, SymbolTable& symbols, BigramCounts& counts) {
+    uint32_t firstWord;
+    countChain(text, symbols, counts, firstWord);
+}
+
+namespace {
+    /**
+     * A word and where it is first used in a text: the index of a shard in the high
+     * bits of position, the id of the word in the shard in the low bits.
+     */
+    struct FirstUse {
+        uint64_t position;
+        std::string_view word;
+    };
+
+    /**
+     * A part of a text counted by a single thread, with its words interned apart.
+     */
+    struct Shard {
+        SymbolTable symbols;
+        Corpus::BigramCounts counts;
+        uint32_t firstWord = SymbolTable::NOT_FOUND;
+        uint32_t lastWord = SymbolTable::NOT_FOUND;
+
+        // the words of symbols split by the partition of their hash, keyed by their position
+        std::vector<std::vector<FirstUse>> words;
+
+        // the id in the text's symbols of every word of symbols
+        std::vector<uint32_t> ids;
+
+        // the bigrams of counts keyed by the text's ids, split by the partition of their source
+        std::vector<std::vector<Corpus::BigramCounts::Slot>> partitions;
+    };
+}
+
+/**
+ * Split a text right after separators into at most a number of parts of about the
+ * same size. Counting the parts one after another with a separator between each
+ * sees the same words as counting the text.
+ */
+static std::vector<std::string_view> splitShards(std::string_view text, unsigned count) {
+    std::vector<std::string_view> shards;
+    size_t start = 0;
+    for (unsigned i = 1; i < count; i++) {
+        size_t end = std::max(start, text.size() / count * i);
+        while (end < text.size() && text[end] != ' ' && text[end] != '\n') end++;
+        if (end == text.size()) break;
+
+        shards.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    shards.push_back(text.substr(start));
+    return shards;
+}
+
+std::vector<Corpus::BigramCounts> Corpus::countBigrams(std::string_view text, SymbolTable& symbols, unsigned threads) {
+    unsigned shardCount = std::min<size_t>(std::max(threads, 1u), text.size() / SHARD_MIN + 1);
+    std::vector<std::string_view> texts = splitShards(text, shardCount);
+    if (texts.size() == 1) {
+        std::vector<BigramCounts> partitions(1);
+        countBigrams(text, symbols, partitions[0]);
+        return partitions;
+    }
+
+    std::vector<Shard> shards(texts.size());
+    runParallel(shards.size(), [&shards, &texts](size_t i) {
+        shards[i].lastWord = countChain(texts[i], shards[i].symbols, shards[i].counts, shards[i].firstWord);
+    });
+
+    // the text's words are interned in the order they are first used, as a sequential count does
+    size_t partitionCount = shards.size();
+    runParallel(shards.size(), [&shards, partitionCount](size_t i) {
+        Shard& shard = shards[i];
+        shard.words.resize(partitionCount);
+        for (uint32_t id = 0; id < shard.symbols.size(); id++) {
+            std::string_view word = shard.symbols.word(id);
+            size_t partition = std::hash<std::string_view>{}(word) % partitionCount;
+            shard.words[partition].push_back(FirstUse{(uint64_t) i << 32 | id, word});
+        }
+    });
+
+    std::vector<std::vector<FirstUse>> firstUses(partitionCount);
+    runParallel(partitionCount, [&shards, &firstUses](size_t i) {
+        SymbolTable seen{};
+        for (const Shard& shard: shards) {
+            for (const FirstUse& use: shard.words[i]) {
+                size_t seenCount = seen.size();
+                seen.intern(use.word);
+                if (seen.size() > seenCount) firstUses[i].push_back(use);
+            }
+        }
+    });
+
+    std::vector<FirstUse> textWords;
+    for (const std::vector<FirstUse>& uses: firstUses) textWords.insert(textWords.end(), uses.begin(), uses.end());
+    std::sort(textWords.begin(), textWords.end(), [](const FirstUse& first, const FirstUse& second) {
+        return first.position < second.position;
+    });
+    for (const FirstUse& use: textWords) symbols.intern(use.word);
+
+    runParallel(shards.size(), [&shards, &symbols, partitionCount](size_t i) {
+        Shard& shard = shards[i];
+        shard.ids.resize(shard.symbols.size());
+        for (uint32_t id = 0; id < shard.ids.size(); id++) shard.ids[id] = symbols.find(shard.symbols.word(id));
+
+        shard.partitions.resize(partitionCount);
+        shard.counts.forEach([&shard, partitionCount](uint32_t source, uint32_t target, int count) {
+            uint64_t key = (uint64_t) shard.ids[source] << 32 | shard.ids[target];
+            shard.partitions[shard.ids[source] % partitionCount].push_back(BigramCounts::Slot{key, count});
+        });
+        shard.symbols = SymbolTable();
+        shard.counts = BigramCounts();
+        shard.words.clear();
+    });
+
+    // each partition sums the bigrams of its sources over every shard
+    std::vector<BigramCounts> partitions(partitionCount);
+    runParallel(partitionCount, [&shards, &partitions](size_t i) {
+        for (Shard& shard: shards) {
+            for (const BigramCounts::Slot& slot: shard.partitions[i]) {
+                partitions[i].add(slot.key >> 32, (uint32_t) slot.key, slot.count);
+            }
+            std::vector<BigramCounts::Slot>().swap(shard.partitions[i]);
+        }
+    });
+
+    for (size_t i = 1; i < shards.size(); i++) {
+        const Shard& previous = shards[i - 1];
+        if (previous.lastWord == SymbolTable::NOT_FOUND || shards[i].firstWord == SymbolTable::NOT_FOUND) continue;
+
+        uint32_t source = previous.ids[previous.lastWord];
+        partitions[source % partitionCount].add(source, shards[i].ids[shards[i].firstWord]);
+    }
+    return partitions;
+}
+
+void Corpus::addBigrams(const BigramCounts& counts, Graph<uint32_t> *graph) {
+    // inserting in source order fills one vertex's edges at a time
+    std::vector<BigramCounts::Slot> sorted;
+    sorted.reserve(counts.size());
+    counts.forEach([&sorted](uint32_t source, uint32_t target, int count) {
+        sorted.push_back(BigramCounts::Slot{(uint64_t) source << 32 | target, count});
+    });
+    std::sort(sorted.begin(), sorted.end(), [](const BigramCounts::Slot& first, const BigramCounts::Slot& second) {
+        return first.key < second.key;
+    });
+
+    for (const BigramCounts::Slot& slot: sorted) {
+        uint32_t source = slot.key >> 32;
+        uint32_t target = (uint32_t) slot.key;
+        int previousWeight = graph->set(source, target, slot.count);
+        if (previousWeight > 0) graph->set(source, target, previousWeight + slot.count);
+    }
+}
+
+void Corpus::load(int fd, SymbolTable& symbols, Graph<uint32_t> *graph, unsigned threads) {
+    File file(fd);
+    for (const BigramCounts& partition: countBigrams(file.content(), symbols, threads)) addBigrams(partition, graph);
+}
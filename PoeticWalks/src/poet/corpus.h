@@ -0,0 +1,185 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "graph.h"
+#include "symbol_table.h"
+
+namespace Corpus {
+    /**
+     * The whole content of an open file, memory mapped when the file allows it and
+     * read in large blocks otherwise.
+     */
+    class File {
+        /**
+         * Abstraction function:
+         *      - represents the bytes mapped[0..length] if mapped != nullptr, the bytes of buffer otherwise
+         *
+         * Representation invariant:
+         *      - buffer is empty if mapped != nullptr
+         *
+         * Safety from rep exposure:
+         *      - the content is only returned as a view to const characters
+         *      - copying is disabled, the mapping is unmapped once
+         */
+    private:
+        char *mapped;
+        size_t length;
+        std::string buffer;
+
+    public:
+        File() = delete;
+
+        File(const File& that) = delete;
+
+        File& operator=(const File& that) = delete;
+
+        File(File&& that) = delete;
+
+        File& operator=(File&& that) = delete;
+
+        /**
+         * Map or read the whole content of a file.
+         *
+         * @param fd descriptor of the file opened for reading, still owned by the caller
+         * @throws runtime_error if the file cannot be read
+         */
+        explicit File(int fd);
+
+        ~File();
+
+        /**
+         * @return the content of the file, valid as long as this
+         */
+        std::string_view content() const;
+    };
+
+    /**
+     * The number of times each word follows another, in a flat open addressing
+     * table so counting a bigram touches a single cache line most of the time.
+     */
+    class BigramCounts {
+        /**
+         * Abstraction function:
+         *      - represents the count slot.count of the bigram (slot.key >> 32, slot.key & UINT32_MAX)
+         *        for every slot of slots whose key is not EMPTY
+         *
+         * Representation invariant:
+         *      - slots.size() is a power of two, at least twice used
+         *      - used is the number of slots whose key is not EMPTY
+         *      - a key is in the first slot found by linear probing from its hash that
+         *        holds it or is EMPTY
+         *      - count > 0 for every key that is not EMPTY
+         *
+         * Safety from rep exposure:
+         *      - slots are only visited by const reference
+         */
+    public:
+        struct Slot {
+            uint64_t key;
+            int count;
+        };
+
+    private:
+        std::vector<Slot> slots;
+        size_t used;
+
+    public:
+        BigramCounts();
+
+        /**
+         * Add to the count of a bigram.
+         *
+         * @param source id of the first word, less than SymbolTable::NOT_FOUND
+         * @param target id of the word following it, less than SymbolTable::NOT_FOUND
+         * @param count positive number of times to count the bigram
+         */
+        void add(uint32_t source, uint32_t target, int count = 1);
+
+        /**
+         * @return the count of a bigram, 0 if it was never added
+         */
+        int count(uint32_t source, uint32_t target) const;
+
+        /**
+         * @return the number of distinct bigrams
+         */
+        size_t size() const;
+
+        /**
+         * Call visit(source, target, count) for every bigram, in no particular order.
+         */
+        template<typename F>
+        void forEach(F visit) const {
+            for (const Slot& slot: slots) {
+                if (slot.key != EMPTY) visit((uint32_t) (slot.key >> 32), (uint32_t) slot.key, slot.count);
+            }
+        }
+
+    private:
+        static constexpr uint64_t EMPTY = UINT64_MAX;
+
+        /**
+         * @return the slot of a key, or the EMPTY slot where it would go
+         */
+        size_t find(uint64_t key) const;
+
+        /**
+         * Double the number of slots.
+         */
+        void grow();
+    };
+
+    /**
+     * Count the bigrams of a text. Words are separated by ' ' and '\n' and lower
+     * cased, an empty word (two separators in a row) ends a chain of words.
+     *
+     * @param text the corpus
+     * @param symbols interns the words of the text
+     * @param counts incremented by the number of times each bigram is in the text
+     * @throws runtime_error if a word is 1024 characters or longer
+     */
+    void countBigrams(std::string_view text, SymbolTable& symbols, BigramCounts& counts);
+
+    /**
+     * Count the bigrams of a text on several threads, with the same counts and word ids
+     * as countBigrams(text, symbols, counts). The text is split right after separators
+     * into shards of at least 16 KiB, each counted by its own thread with its own symbols.
+     * The shards' words are then interned in order, and their bigrams summed by as many
+     * threads, each for the sources of its own partition.
+     *
+     * @param text the corpus
+     * @param symbols interns the words of the text
+     * @param threads maximum number of threads counting, 1 counts on the calling thread
+     * @return the number of times each bigram is in the text, in one table per partition
+     *         of the sources so that no bigram is in two tables
+     * @throws runtime_error if a word is 1024 characters or longer
+     */
+    std::vector<BigramCounts> countBigrams(std::string_view text, SymbolTable& symbols, unsigned threads);
+
+    /**
+     * Add bigram counts to the weights of a graph, one set() per distinct bigram.
+     *
+     * @param counts the bigram counts
+     * @param graph the graph whose vertices are ids of the bigrams' symbols
+     */
+    void addBigrams(const BigramCounts& counts, Graph<uint32_t> *graph);
+
+    /**
+     * Read a corpus into a graph, the weight of the edge from a word to another is
+     * incremented by the number of times the second follows the first.
+     *
+     * @param fd descriptor of the corpus opened for reading
+     * @param symbols interns the words of the corpus
+     * @param graph the graph to add the corpus to
+     * @param threads maximum number of threads counting the bigrams of the corpus
+     * @throws runtime_error if the corpus cannot be read or holds a word too long
+     */
+    void load(int fd, SymbolTable& symbols, Graph<uint32_t> *graph, unsigned threads = 1);
+}
+
+#endif
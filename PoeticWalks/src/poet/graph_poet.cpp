@@ -5,13 +5,14 @@
 #include <unistd.h>
 #include <linux/limits.h>
 
+#include <atomic>
 #include <cstring>
-#include <algorithm>
-#include <cctype>
-#include <regex>
 #include <stdexcept>
 
-#define WORD_MAX 1024
+#include "corpus.h"
+#include "parallel.h"
+#include "snapshot.h"
+#include "tokenizer.h"
 
 int appendStrToCharPointer(char *bufferPtr, std::string str, int bufferSize) {
     int bufferLength = strlen(bufferPtr);
@@ -43,119 +44,99 @@ int appendCharPointer(char *bufferPtr, char *charPtr, int bufferSize) {
     return finalLength;
 }
 
-void processWord(Graph<std::string> *graph, std::string newWord, std::string lastWord) {
-    if (newWord.length() == 0 || lastWord.length() == 0) return;
+GraphPoet::GraphPoet(Graph<uint32_t> *graphImplementation, std::string poetFilePath, bool absolutePath, unsigned threads):
+    graph{}, symbols{}, bridgeIndex{}, bridgeCache{}, fd{} {
+    std::unique_ptr<Graph<uint32_t>> corpusGraph{graphImplementation};
 
-    std::unordered_map<std::string, int> lastWordEdges = graph->targets(lastWord);
-    int newWeight;
-
-    if (lastWordEdges.find(newWord) == lastWordEdges.end()) newWeight = 1;
-    else newWeight = lastWordEdges[newWord] + 1;
-
-    graph->set(lastWord, newWord, newWeight);
-}
-
-void processPoet(Graph<std::string> *graph, int fd) {
-    char buffer;
-    char lastWord[WORD_MAX]{0};
-    char newWord[WORD_MAX]{0};
-    int i = 0;
-
-    while (read(fd, &buffer, sizeof(buffer)) > 0) {
-        if (i == WORD_MAX) throw std::runtime_error("Word is too long.");
-
-        if (buffer == ' ' || buffer == '\n') {
-            newWord[i] = '\0';
-            processWord(graph, std::string(newWord), std::string(lastWord));
-            
-            i = 0;
-            strncpy(lastWord, newWord, WORD_MAX);
-
-            continue;
-        }
-
-        newWord[i++] = tolower(buffer);
-    }
-
-    if (i == WORD_MAX) throw std::runtime_error("Word is too long.");
-
-    if (i > 0) {
-        newWord[i++]= '\0';
-        processWord(graph, std::string(newWord), std::string(lastWord));
-    }
-}
-
-GraphPoet::GraphPoet(Graph<std::string> *graphImplementation, std::string poetFilePath, bool absolutePath):
-    graph{graphImplementation}, fd{} {
-    
     char path[PATH_MAX] {};
     if (!absolutePath) getcwd(path, PATH_MAX);
     if (appendStrToCharPointer(path, poetFilePath, PATH_MAX) == -1) throw std::runtime_error("File path is too long.");
 
     fd = open(path, O_RDONLY);
     if (fd == -1) throw std::runtime_error("File not found/read failed.");
-    processPoet(graph, fd);
+    Corpus::load(fd, symbols, corpusGraph.get(), threads);
+    graph = freeze(*corpusGraph);
 }
 
-std::string GraphPoet::poem(std::string input) {    
-    std::regex word_find("\\S+");
-    std::sregex_iterator begin = std::sregex_iterator(input.begin(), input.end(), word_find);
-    std::sregex_iterator end = std::sregex_iterator();
+GraphPoet::GraphPoet(FrozenGraph<uint32_t> graph, SymbolTable symbols):
+    graph{std::move(graph)}, symbols{std::move(symbols)}, bridgeIndex{}, bridgeCache{}, fd{-1} {}
 
-    if (std::distance(begin, end) == 0) return "";
+GraphPoet GraphPoet::fromSnapshot(const std::string& snapshotPath) {
+    FrozenGraph<uint32_t> graph{};
+    SymbolTable symbols{};
+    Snapshot::load(snapshotPath, symbols, graph);
+    return GraphPoet(std::move(graph), std::move(symbols));
+}
 
-    std::string prevWord;
-    std::unordered_map<std::string, int> prevWordTargets;
+void GraphPoet::save(const std::string& snapshotPath) const {
+    Snapshot::save(snapshotPath, symbols, graph);
+}
 
-    std::string nextWord = ((std::smatch) *begin).str();
-    std::unordered_map<std::string, int> nextWordSource;
+std::string GraphPoet::poem(std::string_view input) const {
+    // words are looked up lower cased and written as they are in the input
+    std::string lowerCase(input.size(), '\0');
+    Tokenizer::lowerCase(input, lowerCase.data());
 
-    std::string nextWordLowerCase = nextWord;
-    std::transform(nextWordLowerCase.begin(), nextWordLowerCase.end(), nextWordLowerCase.begin(), [](unsigned char c) {return tolower(c);});
-    
     std::string output;
-
-    for (std::sregex_iterator i = ++begin; i != end; i++) {
-        output = output.append(nextWord);
-        output = output.append(" ");
-        
-        prevWord = nextWordLowerCase;
-        prevWordTargets = graph->targets(prevWord);
-
-        nextWord = ((std::smatch) *i).str();
-        nextWordLowerCase = nextWord;
-        std::transform(nextWordLowerCase.begin(), nextWordLowerCase.end(), nextWordLowerCase.begin(), [](unsigned char c) {return tolower(c);});
-        nextWordSource = graph->sources(nextWordLowerCase);
-
-        std::string bridgeWord = "";
-        int maxWeight = 0;
-        for (auto&[key, val] : nextWordSource) {
-            if (prevWordTargets.find(key) == prevWordTargets.end()) continue;
-            int newWeight = val + prevWordTargets[key];
-            if (newWeight > maxWeight) {
-                bridgeWord = key;
-                maxWeight = newWeight;
+    uint32_t previous = FrozenGraph<uint32_t>::NOT_FOUND;
+    Tokenizer::forEachWord(input, [&](std::string_view word) {
+        // words missing from the corpus have no vertex and no bridge
+        std::string_view lowerCaseWord(lowerCase.data() + (word.data() - input.data()), word.size());
+        uint32_t next = graph.index(symbols.find(lowerCaseWord));
+        if (!output.empty()) {
+            uint32_t bridgeVertex = bridge(previous, next).vertex;
+            output.push_back(' ');
+            if (bridgeVertex != FrozenGraph<uint32_t>::NOT_FOUND) {
+                output.append(symbols.word(graph.label(bridgeVertex)));
+                output.push_back(' ');
             }
         }
-        if (bridgeWord == "") continue;
-        output = output.append(bridgeWord);
-        output = output.append(" ");
-    }
-    output.append(nextWord);
+        output.append(word);
+        previous = next;
+    });
     return output;
 }
 
+std::vector<std::string> GraphPoet::poems(const std::vector<std::string_view>& inputs, unsigned threads) const {
+    std::vector<std::string> outputs(inputs.size());
+    if (inputs.empty()) return outputs;
+
+    // inputs are taken one at a time so a long input does not hold back a whole share
+    std::atomic<size_t> next{0};
+    runParallel(std::min<size_t>(std::max(threads, 1u), inputs.size()), [this, &inputs, &outputs, &next](size_t) {
+        for (size_t i = next++; i < inputs.size(); i = next++) outputs[i] = poem(inputs[i]);
+    });
+    return outputs;
+}
+
+void GraphPoet::indexBridges(unsigned threads) {
+    bridgeIndex = std::make_unique<BridgeIndex>(graph, threads);
+    bridgeCache.reset();
+}
+
+void GraphPoet::cacheBridges(size_t capacity) {
+    bridgeCache = std::make_unique<BridgeCache>(capacity);
+    bridgeIndex.reset();
+}
+
+Bridge GraphPoet::bridge(uint32_t source, uint32_t target) const {
+    if (bridgeIndex) return (*bridgeIndex).find(source, target);
+    if (bridgeCache) return (*bridgeCache).find(graph, source, target);
+    return findBridge(graph, source, target);
+}
+
 GraphPoet& GraphPoet::operator=(GraphPoet&& that) {
-    this->graph = that.graph;
+    this->graph = std::move(that.graph);
+    this->symbols = std::move(that.symbols);
+    this->bridgeIndex = std::move(that.bridgeIndex);
+    this->bridgeCache = std::move(that.bridgeCache);
     this->fd = that.fd;
 
-    that.graph = nullptr;
     that.fd = 0;
 
     return *this;
 }
 
 GraphPoet::~GraphPoet() {
-    delete graph;
     close(fd);
 }
\ No newline at end of file
@@ -1,14 +1,42 @@
 #ifndef GRAPH_POET_H
 #define GRAPH_POET_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "graph.h"
+#include "bridge_index.h"
+#include "frozen_graph.h"
+#include "symbol_table.h"
 
 class GraphPoet {
+    /**
+     * Abstraction function:
+     *      - represents a poet whose word graph has an edge from a word to the word
+     *        following it in the corpus, weighted by the number of times it follows
+     *      - the vertices of graph are the ids of the lower case words in symbols
+     *      - graph is frozen once the corpus is read, poems only read it, so poems
+     *        can be generated by several threads at once
+     *      - bridges are found in bridgeIndex if it is not null, else through bridgeCache
+     *        if it is not null, else by searching graph
+     *
+     * Representation invariant:
+     *      - every vertex of graph is an id of symbols
+     *      - bridgeIndex and bridgeCache are not both set, and were made from graph
+     *
+     * Safety from rep exposure:
+     *      - graph and symbols are never returned
+     */
+
 private:
-    Graph<std::string> *graph;
+    FrozenGraph<uint32_t> graph;
+    SymbolTable symbols;
+    std::unique_ptr<BridgeIndex> bridgeIndex;
+    std::unique_ptr<BridgeCache> bridgeCache;
     int fd;
     
 public:
@@ -17,24 +45,90 @@ public:
     /**
      * Create a new poet with the graph from corpus (as described above).
      * 
-     * @param graphImplementation pointer to a graph implementation (dependency injection)
+     * @param graphImplementation pointer to a graph implementation (dependency injection),
+     *                            its vertices are the ids of interned words. The poet takes
+     *                            ownership and frees it once the corpus is read and frozen
      * @param poetFilePath a string path to the poem txt file
      * @param absolutePath whether the path given is relative or not
+     * @param threads maximum number of threads reading the corpus, the poet is the same
+     *                for any number of threads
      * @throws runtime_error if the file given by the path cannot be found or read
      */
-    GraphPoet(Graph<std::string> *graphImplementation, std::string poetFilePath, bool absolutePath = false);
+    GraphPoet(Graph<uint32_t> *graphImplementation, std::string poetFilePath, bool absolutePath = false, unsigned threads = 1);
 
     ~GraphPoet();
 
     /**
-     * Generate a poem.
+     * Generate a poem. Safe to call from several threads at once, as long as no
+     * other method changes the poet meanwhile.
      * 
      * @param input string from which to create the poem
      * @return poem (as described above)
      */
-    std::string poem(std::string input);
+    std::string poem(std::string_view input) const;
+
+    /**
+     * Generate a poem for each input, the inputs split among threads that share
+     * this poet's graph.
+     *
+     * @param inputs strings from which to create the poems
+     * @param threads maximum number of threads generating poems
+     * @return the poem of inputs[i] at index i, as poem(inputs[i])
+     */
+    std::vector<std::string> poems(const std::vector<std::string_view>& inputs,
+                                   unsigned threads = std::thread::hardware_concurrency()) const;
+
+    /**
+     * Find the bridge of every pair of words of the corpus ahead of time, so a poem
+     * finds each bridge with a single hash probe. Replaces a bridge cache, must not
+     * be called while poems are generated.
+     *
+     * @param threads number of threads finding bridges
+     * @throws length_error if the corpus has too many pairs of words to index,
+     *         see BridgeIndex, the poet is unchanged
+     */
+    void indexBridges(unsigned threads = 1);
+
+    /**
+     * Remember the bridges of the pairs of words most recently used by poems,
+     * for corpora too large to index. Replaces a bridge index, must not be called
+     * while poems are generated.
+     *
+     * @param capacity the most pairs remembered, must be positive
+     */
+    void cacheBridges(size_t capacity);
+
+    /**
+     * Save the poet's words and graph, so a later process can load the poet with
+     * fromSnapshot() instead of reading the corpus again. A bridge index or cache
+     * is not saved.
+     *
+     * @param snapshotPath path of the snapshot file, replaced if it exists
+     * @throws runtime_error if the snapshot cannot be written
+     */
+    void save(const std::string& snapshotPath) const;
+
+    /**
+     * Load a poet saved by save().
+     *
+     * @param snapshotPath path of the snapshot file
+     * @return the poet, the same as the one saved
+     * @throws runtime_error if the snapshot cannot be read, is of another version or is corrupt
+     */
+    static GraphPoet fromSnapshot(const std::string& snapshotPath);
 
     GraphPoet& operator=(GraphPoet&& that);
+
+private:
+    /**
+     * Create a poet from the words and graph of a corpus read before.
+     */
+    GraphPoet(FrozenGraph<uint32_t> graph, SymbolTable symbols);
+
+    /**
+     * @return the bridge between the vertices of two words, NOT_FOUND vertex if there is none
+     */
+    Bridge bridge(uint32_t source, uint32_t target) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * Run task(i) for every i less than count, each on its own thread except task(0)
+ * which runs on the calling thread.
+ *
+ * @throws the exception thrown by the task of the lowest i, once every task is done
+ */
+template<typename F>
+void runParallel(size_t count, F task) {
+    std::vector<std::exception_ptr> errors(count);
+    auto run = [&task, &errors](size_t i) {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < count; i++) workers.emplace_back(run, i);
+    run(0);
+    for (std::thread& worker: workers) worker.join();
+    for (const std::exception_ptr& error: errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+#endif
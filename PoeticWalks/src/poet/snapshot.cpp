@@ -0,0 +1,178 @@
+#include "snapshot.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "corpus.h"
+
+#define BYTE_ORDER_MARK 0x01020304
+#define ALIGNMENT 8
+
+static const char MAGIC[8] = {'P', 'W', 'G', 'R', 'A', 'P', 'H', '\0'};
+
+namespace {
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t wordCount;
+        uint64_t wordBytes;
+        uint64_t vertexCount;
+        uint64_t edgeCount;
+    };
+}
+
+/**
+ * Write bytes to a file, then zeros up to the next multiple of ALIGNMENT bytes.
+ *
+ * @param position number of bytes written to the file so far, moved past the bytes written
+ * @throws runtime_error if the file cannot be written
+ */
+static void writeSection(int fd, const void *data, size_t length, size_t& position) {
+    static const char PADDING[ALIGNMENT] {};
+    const char *bytes = (const char *) data;
+    size_t padding = (ALIGNMENT - (position + length) % ALIGNMENT) % ALIGNMENT;
+    while (length > 0 || padding > 0) {
+        ssize_t written = length > 0 ? write(fd, bytes, length) : write(fd, PADDING, padding);
+        if (written <= 0) throw std::runtime_error("Snapshot write failed.");
+
+        position += written;
+        if (length > 0) {
+            bytes += written;
+            length -= written;
+        } else {
+            padding -= written;
+        }
+    }
+}
+
+template<typename V>
+static void writeArray(int fd, const std::vector<V>& values, size_t& position) {
+    writeSection(fd, values.data(), values.size() * sizeof(V), position);
+}
+
+void Snapshot::save(const std::string& path, const SymbolTable& symbols, const FrozenGraph<uint32_t>& graph) {
+    std::vector<uint64_t> wordEnds;
+    std::string words;
+    for (uint32_t id = 0; id < symbols.size(); id++) {
+        words.append(symbols.word(id));
+        wordEnds.push_back(words.size());
+    }
+    FrozenGraph<uint32_t>::Layout layout = graph.layout();
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.wordCount = wordEnds.size();
+    header.wordBytes = words.size();
+    header.vertexCount = layout.labels.size();
+    header.edgeCount = layout.outTargets.size();
+
+    // the snapshot replaces the file only once it is complete
+    std::string temporaryPath = path + ".tmp";
+    int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) throw std::runtime_error("Snapshot write failed.");
+    try {
+        size_t position = 0;
+        writeSection(fd, &header, sizeof(header), position);
+        writeArray(fd, wordEnds, position);
+        writeSection(fd, words.data(), words.size(), position);
+        writeArray(fd, layout.labels, position);
+        writeArray(fd, layout.outOffsets, position);
+        writeArray(fd, layout.outTargets, position);
+        writeArray(fd, layout.outWeights, position);
+        writeArray(fd, layout.inOffsets, position);
+        writeArray(fd, layout.inSources, position);
+        writeArray(fd, layout.inWeights, position);
+    } catch (...) {
+        close(fd);
+        unlink(temporaryPath.c_str());
+        throw;
+    }
+    if (close(fd) != 0 || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        unlink(temporaryPath.c_str());
+        throw std::runtime_error("Snapshot write failed.");
+    }
+}
+
+/**
+ * Copy a section of a snapshot into an array.
+ *
+ * @param content the snapshot
+ * @param position offset of the section, moved to the next section
+ * @param count number of values in the section
+ * @throws runtime_error if the section does not fit in the snapshot
+ */
+template<typename V>
+static void readArray(std::string_view content, size_t& position, uint64_t count, std::vector<V>& values) {
+    if (count > (content.size() - position) / sizeof(V)) throw std::runtime_error("Snapshot is corrupt.");
+
+    size_t length = count * sizeof(V);
+    values.resize(count);
+    // an empty vector's data() may be null, which memcpy must not be given
+    if (count != 0) memcpy(values.data(), content.data() + position, length);
+    position += length;
+    position += std::min((ALIGNMENT - position % ALIGNMENT) % ALIGNMENT, content.size() - position);
+}
+
+void Snapshot::load(const std::string& path, SymbolTable& symbols, FrozenGraph<uint32_t>& graph) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) throw std::runtime_error("Snapshot not found/read failed.");
+    std::unique_ptr<Corpus::File> file;
+    try {
+        file = std::make_unique<Corpus::File>(fd);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+    std::string_view content = (*file).content();
+
+    Header header;
+    if (content.size() < sizeof(header)) throw std::runtime_error("Snapshot is corrupt.");
+    memcpy(&header, content.data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("Not a snapshot.");
+    if (header.version != VERSION) throw std::runtime_error("Unsupported snapshot version.");
+    if (header.byteOrder != BYTE_ORDER_MARK) throw std::runtime_error("Snapshot saved in another byte order.");
+    if (header.vertexCount >= FrozenGraph<uint32_t>::NOT_FOUND) throw std::runtime_error("Snapshot is corrupt.");
+
+    size_t position = sizeof(header);
+    std::vector<uint64_t> wordEnds;
+    std::vector<char> words;
+    readArray(content, position, header.wordCount, wordEnds);
+    readArray(content, position, header.wordBytes, words);
+
+    // words are interned in id order, so they keep their ids unless one is repeated
+    SymbolTable loadedSymbols{};
+    uint64_t start = 0;
+    for (uint64_t id = 0; id < wordEnds.size(); id++) {
+        if (wordEnds[id] < start || wordEnds[id] > words.size()) throw std::runtime_error("Snapshot is corrupt.");
+        if (loadedSymbols.intern(std::string_view(words.data() + start, wordEnds[id] - start)) != id) {
+            throw std::runtime_error("Snapshot is corrupt.");
+        }
+        start = wordEnds[id];
+    }
+
+    FrozenGraph<uint32_t>::Layout layout;
+    readArray(content, position, header.vertexCount, layout.labels);
+    readArray(content, position, header.vertexCount + 1, layout.outOffsets);
+    readArray(content, position, header.edgeCount, layout.outTargets);
+    readArray(content, position, header.edgeCount, layout.outWeights);
+    readArray(content, position, header.vertexCount + 1, layout.inOffsets);
+    readArray(content, position, header.edgeCount, layout.inSources);
+    readArray(content, position, header.edgeCount, layout.inWeights);
+    if (position != content.size()) throw std::runtime_error("Snapshot is corrupt.");
+    if (!layout.labels.empty() && layout.labels.back() >= loadedSymbols.size()) throw std::runtime_error("Snapshot is corrupt.");
+
+    graph = FrozenGraph<uint32_t>(std::move(layout));
+    symbols = std::move(loadedSymbols);
+}
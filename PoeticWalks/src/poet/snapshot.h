@@ -0,0 +1,50 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+#include "frozen_graph.h"
+#include "symbol_table.h"
+
+/**
+ * A binary file holding a poet's words and frozen graph, loaded by copying its
+ * arrays out of a memory mapping instead of reading the corpus again.
+ *
+ * The file is in the byte order of the machine that saved it, every section
+ * starting at a multiple of 8 bytes:
+ *      - header: magic "PWGRAPH\0", uint32 version, uint32 0x01020304 in the saving
+ *        machine's byte order, then uint64 counts of words, word bytes, vertices and edges
+ *      - uint64 end offset of every word in the word bytes, in id order
+ *      - the word bytes, words one after another
+ *      - uint32 labels of the vertices, then the graph's compressed sparse row arrays:
+ *        uint32 out offsets, uint32 out targets, int32 out weights, uint32 in offsets,
+ *        uint32 in sources, int32 in weights
+ */
+namespace Snapshot {
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * Save words and a graph of their ids, replacing the file at path once it is
+     * completely written.
+     *
+     * @param path the snapshot file
+     * @param symbols the words
+     * @param graph the graph, whose labels are ids of symbols
+     * @throws runtime_error if the file cannot be written
+     */
+    void save(const std::string& path, const SymbolTable& symbols, const FrozenGraph<uint32_t>& graph);
+
+    /**
+     * Load words and a graph saved by save().
+     *
+     * @param path the snapshot file
+     * @param symbols replaced by the saved words, with the same ids
+     * @param graph replaced by the saved graph
+     * @throws runtime_error if the file cannot be read, is not a snapshot of this version
+     *         and byte order, or is corrupt
+     */
+    void load(const std::string& path, SymbolTable& symbols, FrozenGraph<uint32_t>& graph);
+}
+
+#endif
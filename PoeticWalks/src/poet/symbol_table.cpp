@@ -0,0 +1,90 @@
+#include "symbol_table.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#define BLOCK_SIZE 65536
+#define INITIAL_SLOTS 1024
+#define HASH_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+SymbolTable::SymbolTable():
+    blocks{}, blockUsed{0}, blockSize{0}, words{}, slots(INITIAL_SLOTS, Slot{0, NOT_FOUND}) {}
+
+uint32_t SymbolTable::intern(std::string_view word) {
+    uint32_t wordHash = hash(word);
+    size_t slot = find(word, wordHash);
+    if (slots[slot].id != NOT_FOUND) return slots[slot].id;
+
+    if (words.size() == NOT_FOUND - 1) throw std::runtime_error("Too many distinct words.");
+
+    uint32_t id = words.size();
+    words.push_back(store(word));
+    slots[slot] = Slot{wordHash, id};
+    if (words.size() * 2 > slots.size()) grow();
+    return id;
+}
+
+uint32_t SymbolTable::find(std::string_view word) const {
+    return slots[find(word, hash(word))].id;
+}
+
+std::string_view SymbolTable::word(uint32_t id) const {
+    return words[id];
+}
+
+uint32_t SymbolTable::size() const {
+    return words.size();
+}
+
+uint32_t SymbolTable::hash(std::string_view word) {
+    // eight characters at a time, mixed by multiplication
+    uint64_t state = word.size() * HASH_MULTIPLIER;
+    size_t i = 0;
+    for (; i + 8 <= word.size(); i += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, word.data() + i, 8);
+        state = (state ^ chunk) * HASH_MULTIPLIER;
+        state ^= state >> 29;
+    }
+    uint64_t rest = 0;
+    memcpy(&rest, word.data() + i, word.size() - i);
+    state = (state ^ rest) * HASH_MULTIPLIER;
+    state ^= state >> 32;
+    return (uint32_t) state;
+}
+
+size_t SymbolTable::find(std::string_view word, uint32_t wordHash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = wordHash & mask;
+    while (slots[slot].id != NOT_FOUND) {
+        if (slots[slot].hash == wordHash && words[slots[slot].id] == word) return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void SymbolTable::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{0, NOT_FOUND});
+    old.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (const Slot& entry: old) {
+        if (entry.id == NOT_FOUND) continue;
+        size_t slot = entry.hash & mask;
+        while (slots[slot].id != NOT_FOUND) slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+}
+
+std::string_view SymbolTable::store(std::string_view word) {
+    if (blocks.empty() || blockUsed + word.size() > blockSize) {
+        // a word longer than a block gets a block of its own
+        blockSize = word.size() > BLOCK_SIZE ? word.size() : BLOCK_SIZE;
+        blocks.push_back(std::make_unique<char[]>(blockSize));
+        blockUsed = 0;
+    }
+
+    char *copy = blocks.back().get() + blockUsed;
+    memcpy(copy, word.data(), word.size());
+    blockUsed += word.size();
+    return std::string_view(copy, word.size());
+}
@@ -0,0 +1,116 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * An append only table of interned words. Each distinct word is stored once
+ * and mapped to a dense id, the first word interned gets id 0, the next new
+ * word id 1 and so on. Words are never removed.
+ */
+class SymbolTable {
+    /**
+     * Abstraction function:
+     *      - represents the words words[0], words[1], ... with ids 0, 1, ...
+     *      - slots is an open addressing index from words to ids, a slot holds the
+     *        hash of a word and its id, or NOT_FOUND as id if it is empty
+     *
+     * Representation invariant:
+     *      - slots.size() is a power of two, at least twice words.size()
+     *      - every id is in exactly one slot, with hash == hash(words[id])
+     *      - an id is in the first slot found by linear probing from its hash that
+     *        holds it or is empty
+     *      - every view in words points into a block of blocks
+     *      - blocks are never moved nor freed before the table is destroyed
+     *      - blockUsed <= blockSize, the size of the last block
+     *
+     * Safety from rep exposure:
+     *      - words are returned as views to const characters
+     *      - copying is disabled, the views of a copy would point into this table's blocks
+     */
+
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockUsed;
+    size_t blockSize;
+    std::vector<std::string_view> words;
+
+    struct Slot {
+        uint32_t hash;
+        uint32_t id;
+    };
+    std::vector<Slot> slots;
+
+public:
+    SymbolTable();
+
+    SymbolTable(const SymbolTable& that) = delete;
+
+    SymbolTable& operator=(const SymbolTable& that) = delete;
+
+    SymbolTable(SymbolTable&& that) = default;
+
+    SymbolTable& operator=(SymbolTable&& that) = default;
+
+    /**
+     * Get the id of a word, adding the word to the table if it is not in it.
+     *
+     * @param word the word to intern
+     * @return the id of the word
+     * @throws runtime_error if the table already holds NOT_FOUND words
+     */
+    uint32_t intern(std::string_view word);
+
+    /**
+     * Get the id of a word without adding it.
+     *
+     * @param word the word to look up
+     * @return the id of the word, NOT_FOUND if it was never interned
+     */
+    uint32_t find(std::string_view word) const;
+
+    /**
+     * Get the word with an id.
+     *
+     * @param id id of an interned word, must be less than size()
+     * @return the word, valid as long as the table
+     */
+    std::string_view word(uint32_t id) const;
+
+    /**
+     * @return number of distinct words in the table
+     */
+    uint32_t size() const;
+
+private:
+    /**
+     * @return the hash of a word
+     */
+    static uint32_t hash(std::string_view word);
+
+    /**
+     * @return the slot holding a word, or the empty slot where it would go
+     */
+    size_t find(std::string_view word, uint32_t wordHash) const;
+
+    /**
+     * Double the number of slots.
+     */
+    void grow();
+
+    /**
+     * Copy a word to the arena.
+     *
+     * @param word the word to copy
+     * @return a view of the copy
+     */
+    std::string_view store(std::string_view word);
+};
+
+#endif
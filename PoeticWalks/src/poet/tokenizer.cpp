@@ -0,0 +1,125 @@
+#include "tokenizer.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+
+uint64_t Tokenizer::separators(const char *block) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 2; i++) {
+        __m256i characters = _mm256_loadu_si256((const __m256i *) (block + 32 * i));
+        __m256i found = _mm256_or_si256(
+            _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(' ')),
+            _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('\n'))
+        );
+        mask |= (uint64_t) (uint32_t) _mm256_movemask_epi8(found) << 32 * i;
+    }
+    return mask;
+}
+
+uint64_t Tokenizer::spaces(const char *block) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 2; i++) {
+        // '\t' to '\r' are 9 to 13
+        __m256i characters = _mm256_loadu_si256((const __m256i *) (block + 32 * i));
+        __m256i found = _mm256_or_si256(
+            _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(' ')),
+            _mm256_and_si256(
+                _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('\t' - 1)),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), characters)
+            )
+        );
+        mask |= (uint64_t) (uint32_t) _mm256_movemask_epi8(found) << 32 * i;
+    }
+    return mask;
+}
+
+void Tokenizer::lowerCase(std::string_view text, char *buffer) {
+    size_t i = 0;
+    for (; i + 32 <= text.size(); i += 32) {
+        // bytes from 128 are negative, so never between 'A' and 'Z'
+        __m256i characters = _mm256_loadu_si256((const __m256i *) (text.data() + i));
+        __m256i upperCase = _mm256_and_si256(
+            _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), characters)
+        );
+        characters = _mm256_add_epi8(characters, _mm256_and_si256(upperCase, _mm256_set1_epi8('a' - 'A')));
+        _mm256_storeu_si256((__m256i *) (buffer + i), characters);
+    }
+    for (; i < text.size(); i++) buffer[i] = text[i] >= 'A' && text[i] <= 'Z' ? text[i] - 'A' + 'a' : text[i];
+}
+
+#elif defined(__SSE2__)
+
+uint64_t Tokenizer::separators(const char *block) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i characters = _mm_loadu_si128((const __m128i *) (block + 16 * i));
+        __m128i found = _mm_or_si128(
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8(' ')),
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8('\n'))
+        );
+        mask |= (uint64_t) _mm_movemask_epi8(found) << 16 * i;
+    }
+    return mask;
+}
+
+uint64_t Tokenizer::spaces(const char *block) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        // '\t' to '\r' are 9 to 13
+        __m128i characters = _mm_loadu_si128((const __m128i *) (block + 16 * i));
+        __m128i found = _mm_or_si128(
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8(' ')),
+            _mm_and_si128(
+                _mm_cmpgt_epi8(characters, _mm_set1_epi8('\t' - 1)),
+                _mm_cmplt_epi8(characters, _mm_set1_epi8('\r' + 1))
+            )
+        );
+        mask |= (uint64_t) _mm_movemask_epi8(found) << 16 * i;
+    }
+    return mask;
+}
+
+void Tokenizer::lowerCase(std::string_view text, char *buffer) {
+    size_t i = 0;
+    for (; i + 16 <= text.size(); i += 16) {
+        // bytes from 128 are negative, so never between 'A' and 'Z'
+        __m128i characters = _mm_loadu_si128((const __m128i *) (text.data() + i));
+        __m128i upperCase = _mm_and_si128(
+            _mm_cmpgt_epi8(characters, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(characters, _mm_set1_epi8('Z' + 1))
+        );
+        characters = _mm_add_epi8(characters, _mm_and_si128(upperCase, _mm_set1_epi8('a' - 'A')));
+        _mm_storeu_si128((__m128i *) (buffer + i), characters);
+    }
+    for (; i < text.size(); i++) buffer[i] = text[i] >= 'A' && text[i] <= 'Z' ? text[i] - 'A' + 'a' : text[i];
+}
+
+#else
+
+uint64_t Tokenizer::separators(const char *block) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        if (block[i] == ' ' || block[i] == '\n') mask |= (uint64_t) 1 << i;
+    }
+    return mask;
+}
+
+uint64_t Tokenizer::spaces(const char *block) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        if (block[i] == ' ' || (block[i] >= '\t' && block[i] <= '\r')) mask |= (uint64_t) 1 << i;
+    }
+    return mask;
+}
+
+void Tokenizer::lowerCase(std::string_view text, char *buffer) {
+    for (size_t i = 0; i < text.size(); i++) buffer[i] = text[i] >= 'A' && text[i] <= 'Z' ? text[i] - 'A' + 'a' : text[i];
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Splitting and case folding of ASCII text, vectorized with AVX2 when the build
+ * targets it, SSE2 otherwise on x86-64, and scalar on other targets. Characters
+ * are looked at 64 at a time: a block is turned into a mask with a bit per
+ * character that is a separator, then words are read off the set bits.
+ */
+namespace Tokenizer {
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    /**
+     * @param block BLOCK_SIZE characters
+     * @return a mask whose bit i is set if block[i] is ' ' or '\n'
+     */
+    uint64_t separators(const char *block);
+
+    /**
+     * @param block BLOCK_SIZE characters
+     * @return a mask whose bit i is set if block[i] is whitespace, as isspace in the "C" locale
+     */
+    uint64_t spaces(const char *block);
+
+    /**
+     * Lower case ASCII text, as tolower in the "C" locale.
+     *
+     * @param text the text
+     * @param buffer set to the lower case text, at least text.size() characters
+     */
+    void lowerCase(std::string_view text, char *buffer);
+
+    /**
+     * Call visit(token) for every token of a text in order, the tokens being
+     * the texts between the separators found by mask(block). Two separators in a row,
+     * a separator first or last, make empty tokens.
+     *
+     * @param text the text
+     * @param mask separators or spaces
+     * @param visit called with views into text
+     */
+    template<typename M, typename F>
+    void forEachToken(std::string_view text, M mask, F visit) {
+        size_t start = 0;
+        for (size_t block = 0; block < text.size(); block += BLOCK_SIZE) {
+            uint64_t found;
+            if (text.size() - block >= BLOCK_SIZE) {
+                found = mask(text.data() + block);
+            } else {
+                // the last block is copied so nothing past the text is read
+                char last[BLOCK_SIZE] {};
+                text.copy(last, BLOCK_SIZE, block);
+                found = mask(last) & (((uint64_t) 1 << (text.size() - block)) - 1);
+            }
+
+            while (found != 0) {
+                size_t separator = block + __builtin_ctzll(found);
+                visit(text.substr(start, separator - start));
+                start = separator + 1;
+                found &= found - 1;
+            }
+        }
+        visit(text.substr(start));
+    }
+
+    /**
+     * Call visit(token) for every token of a text separated by ' ' and '\n', as forEachToken.
+     */
+    template<typename F>
+    void forEachSeparated(std::string_view text, F visit) {
+        forEachToken(text, separators, visit);
+    }
+
+    /**
+     * Call visit(word) for every word of a text in order, a word being a run of
+     * characters other than whitespace.
+     */
+    template<typename F>
+    void forEachWord(std::string_view text, F visit) {
+        forEachToken(text, spaces, [&visit](std::string_view token) {
+            if (!token.empty()) visit(token);
+        });
+    }
+}
+
+#endif
@@ -2,6 +2,9 @@
 
 #include <string>
 #include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "concrete_vertices_graph.h"
 
@@ -294,4 +297,96 @@ TEST_F(ConcreteVerticesGraphIntTest, TargetTest) {
         EXPECT_EQ(i, graph.targets(1)[i]) << "Expected correct weight of edge";
     }
 }
+
+TEST_F(ConcreteVerticesGraphIntTest, ViewTest) {
+    /**
+     * Testing strategy:
+     * partition on vertex:
+     *      - with edges
+     *      - without edges
+     *      - not in the graph
+     */
+    for (int i = 2; i < 6; i++) {
+        graph.set(1, i, i);
+        graph.set(i, 1, 10 * i);
+    }
+    graph.add(7);
+
+    // with edges
+    std::unordered_map<int, int> edges;
+    for (Neighbor<int> edge: graph.targetsView(1)) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.targets(1), edges) << "Expected the view to match targets()";
+    edges.clear();
+    for (Neighbor<int> edge: graph.sourcesView(1)) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.sources(1), edges) << "Expected the view to match sources()";
+
+    // without edges, not in the graph
+    EXPECT_TRUE(graph.targetsView(7).empty()) << "Expected no edges";
+    EXPECT_TRUE(graph.sourcesView(8).empty()) << "Expected no edges of a missing vertex";
+}
+
+TEST_F(ConcreteVerticesGraphIntTest, RemoveVerticesTest) {
+    /**
+     * Testing strategy:
+     * partition on @param vertices:
+     *      - empty
+     *      - some in the graph, some not
+     *      - all of the graph
+     *
+     * partition on edges with a removed vertex as one of their endpoints:
+     *      - none, one, many
+     *      - between two removed vertices, a loop
+     */
+
+    // empty
+    EXPECT_EQ(0, graph.removeVertices({})) << "Expected no vertices removed";
+
+    // some in the graph, many edges, edges between removed vertices, a loop
+    for (int i = 0; i < 10; i++) {
+        graph.set(0, i, i + 1);
+        graph.set(i, (i + 1) % 10, 2);
+    }
+    graph.set(5, 5, 3);
+    graph.add(20);
+    EXPECT_EQ(3, graph.removeVertices({0, 5, 6, 42})) << "Expected the vertices in the graph removed";
+    EXPECT_EQ(8, graph.vertices().size()) << "Expected correct number of vertices";
+    for (int i: {1, 2, 3, 4, 7, 8, 9, 20}) {
+        EXPECT_TRUE(graph.vertices().find(i) != graph.vertices().end()) << "Expected vertex " << i << " kept";
+    }
+    EXPECT_EQ(0, graph.sources(1).size()) << "Expected edges from removed vertices removed";
+    EXPECT_EQ(0, graph.targets(4).size()) << "Expected edges to removed vertices removed";
+    EXPECT_EQ(2, graph.targets(7)[8]) << "Expected other edges kept";
+    EXPECT_EQ(1, graph.sources(2).size()) << "Expected other edges kept";
+
+    // all of the graph
+    EXPECT_EQ(8, graph.removeVertices(graph.vertices())) << "Expected every vertex removed";
+    EXPECT_EQ(0, graph.vertices().size()) << "Expected an empty graph";
+}
+
+TEST_F(ConcreteVerticesGraphIntTest, RemoveEdgesTest) {
+    /**
+     * Testing strategy:
+     * partition on @param edgesToRemove:
+     *      - empty
+     *      - in the graph, not in the graph, with vertices not in the graph, repeated
+     */
+    for (int i = 1; i < 6; i++) {
+        graph.set(0, i, i);
+        graph.set(i, 0, i);
+    }
+
+    // empty
+    EXPECT_EQ(0, graph.removeEdges({})) << "Expected no edges removed";
+
+    // in the graph, not in the graph, vertices not in the graph, repeated
+    std::vector<std::pair<int, int>> edges{{0, 1}, {0, 3}, {3, 0}, {1, 2}, {7, 0}, {0, 7}, {0, 3}};
+    EXPECT_EQ(3, graph.removeEdges(edges)) << "Expected each edge in the graph removed once";
+    EXPECT_EQ(6, graph.vertices().size()) << "Expected the vertices kept";
+    EXPECT_EQ(3, graph.targets(0).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.targets(0).count(1)) << "Expected the edge removed";
+    EXPECT_EQ(0, graph.targets(0).count(3)) << "Expected the edge removed";
+    EXPECT_EQ(0, graph.sources(0).count(3)) << "Expected the edge removed";
+    EXPECT_EQ(5, graph.targets(0)[5]) << "Expected other edges kept";
+    EXPECT_EQ(1, graph.sources(0)[1]) << "Expected other edges kept";
+}
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frozen_graph.h"
+#include "hashed_graph.h"
+#include "indexed_graph.h"
+
+namespace {
+
+TEST(FrozenGraphTest, EmptyTest) {
+    /**
+     * Testing strategy:
+     * partition on the frozen graph:
+     *      - default constructed
+     *      - frozen from an empty graph
+     */
+    FrozenGraph<int> empty{};
+    EXPECT_EQ(0, empty.vertexCount()) << "Expected no vertices";
+    EXPECT_EQ(0, empty.edgeCount()) << "Expected no edges";
+    EXPECT_EQ(FrozenGraph<int>::NOT_FOUND, empty.index(1)) << "Expected NOT_FOUND for a missing vertex";
+    EXPECT_EQ(0, empty.targets(1).size()) << "Expected to return empty map if vertex does not exist";
+
+    HashedGraph<int> graph{};
+    FrozenGraph<int> frozen = freeze(graph);
+    EXPECT_EQ(0, frozen.vertexCount()) << "Expected no vertices";
+    EXPECT_EQ(0, frozen.vertices().size()) << "Expected no vertices";
+}
+
+TEST(FrozenGraphTest, FreezeTest) {
+    /**
+     * Testing strategy:
+     * partition on vertices:
+     *      - with out and in edges
+     *      - without edges
+     *      - with a self loop
+     *
+     * partition on the graph after freezing:
+     *      - unchanged
+     *      - changed
+     */
+    HashedGraph<std::string> graph{};
+    graph.set("to", "be", 2);
+    graph.set("be", "or", 1);
+    graph.set("or", "not", 1);
+    graph.set("not", "to", 1);
+    graph.set("to", "not", 3);
+    graph.set("be", "be", 4);
+    graph.add("question");
+
+    FrozenGraph<std::string> frozen = freeze(graph);
+    EXPECT_EQ(5, frozen.vertexCount()) << "Expected correct number of vertices";
+    EXPECT_EQ(6, frozen.edgeCount()) << "Expected correct number of edges";
+    EXPECT_EQ(graph.vertices(), frozen.vertices()) << "Expected the same vertices";
+    for (const std::string& vertex: graph.vertices()) {
+        EXPECT_EQ(graph.targets(vertex), frozen.targets(vertex)) << "Expected the same targets of " << vertex;
+        EXPECT_EQ(graph.sources(vertex), frozen.sources(vertex)) << "Expected the same sources of " << vertex;
+    }
+
+    // vertices are indexed in label order
+    for (uint32_t i = 0; i < frozen.vertexCount(); i++) {
+        EXPECT_EQ(i, frozen.index(frozen.label(i))) << "Expected index and label to match";
+        if (i > 0) {
+            EXPECT_LT(frozen.label(i - 1), frozen.label(i)) << "Expected labels in order";
+        }
+    }
+
+    // changed after freezing
+    graph.set("to", "be", 0);
+    graph.remove("or");
+    EXPECT_EQ(2, frozen.targets("to")["be"]) << "Expected the frozen graph not to see later changes";
+    EXPECT_EQ(1, frozen.sources("or").size()) << "Expected the frozen graph not to see later changes";
+}
+
+TEST(FrozenGraphTest, ManyEdgesTest) {
+    /**
+     * Testing strategy:
+     * partition on degree: vertices with many out and in edges, from a Graph<uint32_t>
+     */
+    IndexedGraph graph{};
+    for (uint32_t i = 0; i < 200; i++) {
+        graph.set(i % 7, i, i + 1);
+        graph.set(i, (i * 31) % 200, 2 * i + 1);
+    }
+    FrozenGraph<uint32_t> frozen = freeze(graph);
+    for (uint32_t vertex: graph.vertices()) {
+        EXPECT_EQ(graph.targets(vertex), frozen.targets(vertex)) << "Expected the same targets of " << vertex;
+        EXPECT_EQ(graph.sources(vertex), frozen.sources(vertex)) << "Expected the same sources of " << vertex;
+    }
+}
+
+TEST(FrozenGraphTest, EdgeViewTest) {
+    /**
+     * Testing strategy:
+     * partition on vertex:
+     *      - with edges
+     *      - without edges
+     *      - NOT_FOUND
+     * partition on the view: iterated in a range for, iterator kept after the view is gone
+     */
+    HashedGraph<std::string> graph{};
+    graph.set("to", "be", 2);
+    graph.set("to", "or", 1);
+    graph.set("not", "be", 3);
+    graph.add("question");
+    FrozenGraph<std::string> frozen = freeze(graph);
+
+    // with edges, sorted by index
+    std::unordered_map<std::string, int> targets;
+    uint32_t last = 0;
+    for (Neighbor<uint32_t> edge: frozen.outEdges(frozen.index("to"))) {
+        EXPECT_LE(last, edge.vertex) << "Expected edges sorted by index";
+        last = edge.vertex;
+        targets[frozen.label(edge.vertex)] = edge.weight;
+    }
+    EXPECT_EQ(frozen.targets("to"), targets) << "Expected the view to match targets()";
+
+    std::unordered_map<std::string, int> sources;
+    for (Neighbor<uint32_t> edge: frozen.inEdges(frozen.index("be"))) {
+        sources[frozen.label(edge.vertex)] = edge.weight;
+    }
+    EXPECT_EQ(frozen.sources("be"), sources) << "Expected the view to match sources()";
+
+    // an iterator outlives its view
+    auto first = frozen.outEdges(frozen.index("to")).begin();
+    EXPECT_EQ(frozen.targets("to")[frozen.label((*first).vertex)], (*first).weight) << "Expected the iterator to stay valid";
+
+    // without edges, NOT_FOUND
+    EXPECT_TRUE(frozen.outEdges(frozen.index("question")).empty()) << "Expected no edges";
+    EXPECT_TRUE(frozen.inEdges(frozen.index("to")).empty()) << "Expected no edges";
+    EXPECT_TRUE(frozen.outEdges(FrozenGraph<std::string>::NOT_FOUND).empty()) << "Expected no edges of a missing vertex";
+}
+
+TEST(FrozenGraphTest, LayoutTest) {
+    /**
+     * Testing strategy:
+     * partition on the layout:
+     *      - of a frozen graph
+     *      - labels out of order, repeated
+     *      - offsets not starting at 0, decreasing, past the edges
+     *      - targets out of range, repeated
+     *      - weight not positive
+     *      - out and in edges of different counts
+     *      - in edges valid on their own but not the out edges reversed
+     */
+    HashedGraph<std::string> graph{};
+    graph.set("to", "be", 2);
+    graph.set("be", "or", 1);
+    graph.set("or", "to", 3);
+    graph.set("to", "or", 1);
+    graph.add("question");
+    FrozenGraph<std::string> frozen = freeze(graph);
+
+    // of a frozen graph
+    FrozenGraph<std::string> copy(frozen.layout());
+    EXPECT_EQ(frozen.vertices(), copy.vertices()) << "Expected the same vertices";
+    for (const std::string& vertex: frozen.vertices()) {
+        EXPECT_EQ(frozen.index(vertex), copy.index(vertex)) << "Expected the same index of " << vertex;
+        EXPECT_EQ(frozen.targets(vertex), copy.targets(vertex)) << "Expected the same targets of " << vertex;
+        EXPECT_EQ(frozen.sources(vertex), copy.sources(vertex)) << "Expected the same sources of " << vertex;
+    }
+
+    using Layout = FrozenGraph<std::string>::Layout;
+    std::vector<std::function<void(Layout&)>> breaks{
+        [](Layout& layout) { std::swap(layout.labels[0], layout.labels[1]); },
+        [](Layout& layout) { layout.labels[1] = layout.labels[0]; },
+        [](Layout& layout) { layout.outOffsets[0] = 1; },
+        [](Layout& layout) { std::swap(layout.outOffsets[1], layout.outOffsets[3]); },
+        [](Layout& layout) { layout.inOffsets.back()++; },
+        [](Layout& layout) { layout.outTargets[0] = 4; },
+        [](Layout& layout) { layout.inSources[1] = layout.inSources[0]; },
+        [](Layout& layout) { layout.outWeights[0] = 0; },
+        [](Layout& layout) { layout.inWeights.pop_back(); },
+        [](Layout& layout) { layout.outOffsets.pop_back(); },
+        [](Layout& layout) { layout.inSources[0] = 2; },
+        [](Layout& layout) { layout.inWeights[0]++; },
+    };
+    for (size_t i = 0; i < breaks.size(); i++) {
+        Layout layout = frozen.layout();
+        breaks[i](layout);
+        EXPECT_THROW(FrozenGraph<std::string>{std::move(layout)}, std::runtime_error) << "Expected broken layout " << i << " rejected";
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <stdexcept>
+
+#include "hashed_graph.h"
+
+namespace {
+
+class HashedGraphIntTest: public ::testing::Test {
+protected:
+    void SetUp(void)
+    {
+        
+    }
+    
+    void TearDown(void)
+    {
+
+    }
+    HashedGraph<int> graph{};
+};
+
+TEST_F(HashedGraphIntTest, ConstructorTest) {
+    ASSERT_NO_THROW(HashedGraph<int>()) << "Constructor must work";
+}
+
+TEST_F(HashedGraphIntTest, EmptyVerticesIsEmptyTest) {
+    EXPECT_EQ(0, HashedGraph<int>().vertices().size());
+}
+
+TEST_F(HashedGraphIntTest, AddTest) {
+    EXPECT_TRUE(graph.add(1)) << "Expected adding new vertex returns true";
+    EXPECT_FALSE(graph.add(1)) << "Expected adding new vertex returns false";
+}
+
+TEST_F(HashedGraphIntTest, SetTest) {
+    /**
+     * Testing strategy:
+     * partition on @param source:
+     *      - exist in the graph
+     *      - does not exist in the graph
+     * 
+     * partition on @param target:
+     *      - exist in the graph
+     *      - does not exist in the graph
+     *      - same as source
+     * 
+     * partition on @param weight:
+     *      - zero
+     *      - positive
+     *      - negative
+     * 
+     * partition on edges with target/source as one of their endpoints:
+     *      - exist in the graph
+     *      - does not exist
+     */
+
+    // source and target vertices do not exist, positive weight, edge does not exist.
+    EXPECT_EQ(0, graph.set(1, 2, 3)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(3, graph.targets(1)[2]) << "Expected correct edge weight";
+    EXPECT_EQ(3, graph.sources(2)[1]) << "Expected correct edge weight";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected correct number of vertices";
+    
+    // source and target vertices exist, positive weight, edge exist.
+    EXPECT_EQ(3, graph.set(1, 2, 10)) << "Expected modifying existing edge returns the edge's previous weight";
+    EXPECT_EQ(10, graph.targets(1)[2]) << "Expected correct edge weight";
+    EXPECT_EQ(10, graph.sources(2)[1]) << "Expected correct edge weight";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected correct number of vertices";
+
+    // source and target vertices exist, zero weight.
+    EXPECT_EQ(10, graph.set(1, 2, 0)) << "Expected removing existing edge returns the edge's previous weight";
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.sources(2).size()) << "Expected correct number of edges";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected removing an edge keeps its vertices";
+
+    // source and target vertices do not exist, zero weight.
+    EXPECT_EQ(0, graph.set(3, 4, 0)) << "Expected removing non existing edge returns zero";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected removing non existing edge does not add vertices";
+
+    // target same as source
+    EXPECT_EQ(0, graph.set(1, 1, 4)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(4, graph.targets(1)[1]) << "Expected correct edge weight";
+    EXPECT_EQ(4, graph.sources(1)[1]) << "Expected correct edge weight";
+
+    // negative weight.
+    EXPECT_THROW(graph.set(1, 2, -1), std::domain_error);
+}
+
+TEST_F(HashedGraphIntTest, RemoveTest) {
+    /**
+     * Testing strategy:
+     * partition on @param vertex:
+     *      - exist in the graph
+     *      - does not exist in the graph
+     * 
+     * partition on edges with vertex as one of their endpoints:
+     *      - exist in the graph, as source, target or both
+     *      - does not exist
+     *
+     * partition on vertices added after the removal:
+     *      - same label as the removed vertex
+     *      - new label
+     */
+
+    // vertex does not exist in the graph, edge does not exist in the graph.
+    EXPECT_FALSE(graph.remove(1)) << "Expected removing non existing vertex returns false";
+
+    // vertex exist in the graph, edge exist in the graph.
+    graph.set(1, 2, 10);
+    graph.set(2, 3, 5);
+    graph.set(2, 2, 1);
+    EXPECT_TRUE(graph.remove(2)) << "Expected removing existing vertex returns true";
+    EXPECT_FALSE(graph.remove(2)) << "Expected removing a removed vertex returns false";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected correct number of vertices";
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.sources(3).size()) << "Expected correct number of edges";
+
+    // same label as the removed vertex
+    EXPECT_TRUE(graph.add(2)) << "Expected adding a removed vertex returns true";
+    EXPECT_EQ(0, graph.targets(2).size()) << "Expected a vertex added again to have no edges";
+    EXPECT_EQ(0, graph.sources(2).size()) << "Expected a vertex added again to have no edges";
+
+    // new label
+    graph.remove(2);
+    EXPECT_EQ(0, graph.set(4, 1, 7)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(7, graph.sources(1)[4]) << "Expected correct edge weight";
+    EXPECT_EQ(0, graph.targets(4).count(2)) << "Expected no edge to a removed vertex";
+    EXPECT_EQ(3, graph.vertices().size()) << "Expected correct number of vertices";
+}
+
+TEST_F(HashedGraphIntTest, VerticesTest) {
+    /**
+     * Testing strategy:
+     * partition on vertices:
+     *      - empty
+     *      - non empty
+     * 
+     * partition on previous condition:
+     *      - no removed vertex
+     *      - some removed vertex
+     */
+
+    // empty vertices, no removed vertex
+    EXPECT_EQ(0, graph.vertices().size()) << "Expected correct number of vertices";
+
+    // non empty vertices, some removed vertex
+    for (int i = 1; i < 6; i++) {
+        graph.add(i);
+    }
+    graph.remove(2);
+    EXPECT_EQ(4, graph.vertices().size()) << "Expected correct number of vertices";
+    for (int i = 1; i < 6; i++) {
+        if (i == 2) continue;
+        EXPECT_TRUE(graph.vertices().find(i) != graph.vertices().end()) << "Expected correct vertices in graph";
+    }
+}
+
+TEST_F(HashedGraphIntTest, SourcesTest) {
+    /**
+     * Testing strategy:
+     * partition on target vertex:
+     *      - vertex exist
+     *      - vertex does not exist
+     * 
+     * partition on edges with vertex as target:
+     *      - empty
+     *      - non empty, no removed edges
+     *      - non empty, some removed edges
+     */
+    
+    // target vertex does not exist
+    EXPECT_EQ(0, graph.sources(1).size()) << "Expected to return empty map if target vertex does not exist";
+    
+    // empty edges, no removed edges
+    graph.add(1);
+    EXPECT_EQ(0, graph.sources(1).size()) << "Expected correct number of edges";
+
+    // non empty edges, no removed edges
+    for (int i = 2; i < 10; i++) {
+        graph.set(i, 1, i);
+    }
+    EXPECT_EQ(8, graph.sources(1).size()) << "Expected correct number of edges";
+    for (int i = 2; i < 10; i++) {
+        EXPECT_EQ(i, graph.sources(1)[i]) << "Expected correct weight of edge";
+    }
+
+    // non empty edges, some removed edges
+    graph.set(3, 1, 0);
+    graph.remove(9);
+    EXPECT_EQ(6, graph.sources(1).size()) << "Expected correct number of edges";
+    for (int i = 2; i < 9; i++) {
+        if (i == 3) continue;
+        EXPECT_EQ(i, graph.sources(1)[i]) << "Expected correct weight of edge";
+    }
+}
+
+TEST_F(HashedGraphIntTest, TargetTest) {
+    /**
+     * Testing strategy:
+     * partition on source vertex:
+     *      - vertex exist
+     *      - vertex does not exist
+     * 
+     * partition on edges with vertex as source:
+     *      - empty
+     *      - non empty, no removed edges
+     *      - non empty, some removed edges
+     */
+
+    // source vertex does not exist
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected to return empty map if source vertex does not exist";
+    
+    // empty edges, no removed edges
+    graph.add(1);
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected correct number of edges";
+
+    // non empty edges, no removed edges
+    for (int i = 2; i < 10; i++) {
+        graph.set(1, i, i);
+    }
+    EXPECT_EQ(8, graph.targets(1).size()) << "Expected correct number of edges";
+    for (int i = 2; i < 10; i++) {
+        EXPECT_EQ(i, graph.targets(1)[i]) << "Expected correct weight of edge";
+    }
+
+    // non empty edges, some removed edges
+    graph.set(1, 3, 0);
+    graph.remove(9);
+    EXPECT_EQ(6, graph.targets(1).size()) << "Expected correct number of edges";
+    for (int i = 2; i < 9; i++) {
+        if (i == 3) continue;
+        EXPECT_EQ(i, graph.targets(1)[i]) << "Expected correct weight of edge";
+    }
+}
+
+TEST(HashedGraphStringTest, MatchesConcreteGraphsTest) {
+    HashedGraph<std::string> graph{};
+    EXPECT_EQ(0, graph.set("to", "be", 1)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(0, graph.set("be", "or", 1)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(1, graph.set("to", "be", 2)) << "Expected modifying existing edge returns the edge's previous weight";
+    EXPECT_EQ(2, graph.targets("to")["be"]) << "Expected correct edge weight";
+    EXPECT_EQ(1, graph.sources("or")["be"]) << "Expected correct edge weight";
+    EXPECT_EQ(3, graph.vertices().size()) << "Expected correct number of vertices";
+}
+
+TEST(HashedGraphStringTest, ViewTest) {
+    /**
+     * Testing strategy:
+     * partition on vertex:
+     *      - with edges
+     *      - removed
+     *      - not in the graph
+     */
+    HashedGraph<std::string> graph{};
+    graph.set("to", "be", 2);
+    graph.set("to", "or", 1);
+    graph.set("not", "be", 3);
+
+    // with edges
+    std::unordered_map<std::string, int> edges;
+    for (Neighbor<std::string> edge: graph.targetsView("to")) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.targets("to"), edges) << "Expected the view to match targets()";
+    edges.clear();
+    for (Neighbor<std::string> edge: graph.sourcesView("be")) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.sources("be"), edges) << "Expected the view to match sources()";
+
+    // removed, not in the graph
+    graph.remove("not");
+    EXPECT_TRUE(graph.targetsView("not").empty()) << "Expected no edges of a removed vertex";
+    EXPECT_TRUE(graph.sourcesView("question").empty()) << "Expected no edges of a missing vertex";
+    edges.clear();
+    for (Neighbor<std::string> edge: graph.sourcesView("be")) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.sources("be"), edges) << "Expected the view to match sources()";
+}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+#include "indexed_graph.h"
+
+namespace {
+
+class IndexedGraphTest: public ::testing::Test {
+protected:
+    void SetUp(void)
+    {
+        
+    }
+    
+    void TearDown(void)
+    {
+
+    }
+    IndexedGraph graph{};
+};
+
+TEST_F(IndexedGraphTest, ConstructorTest) {
+    ASSERT_NO_THROW(IndexedGraph()) << "Constructor must work";
+}
+
+TEST_F(IndexedGraphTest, EmptyVerticesIsEmptyTest) {
+    EXPECT_EQ(0, IndexedGraph().vertices().size());
+}
+
+TEST_F(IndexedGraphTest, AddTest) {
+    /**
+     * Testing strategy:
+     * partition on @param vertex:
+     *      - in the graph
+     *      - not in the graph, below the largest vertex
+     *      - not in the graph, above the largest vertex
+     */
+    EXPECT_TRUE(graph.add(5)) << "Expected adding new vertex returns true";
+    EXPECT_FALSE(graph.add(5)) << "Expected adding existing vertex returns false";
+    EXPECT_TRUE(graph.add(2)) << "Expected adding new vertex returns true";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected only added vertices in the graph";
+}
+
+TEST_F(IndexedGraphTest, SetTest) {
+    /**
+     * Testing strategy:
+     * partition on @param source and @param target:
+     *      - exist in the graph
+     *      - does not exist in the graph
+     *      - same vertex
+     * 
+     * partition on @param weight:
+     *      - zero
+     *      - positive
+     *      - negative
+     * 
+     * partition on the edge:
+     *      - exist in the graph
+     *      - does not exist
+     */
+
+    // source and target vertices do not exist, positive weight, edge does not exist.
+    EXPECT_EQ(0, graph.set(1, 2, 3)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(3, graph.targets(1)[2]) << "Expected correct edge weight";
+    EXPECT_EQ(3, graph.sources(2)[1]) << "Expected correct edge weight";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected correct number of vertices";
+    
+    // source and target vertices exist, positive weight, edge exist.
+    EXPECT_EQ(3, graph.set(1, 2, 10)) << "Expected modifying existing edge returns the edge's previous weight";
+    EXPECT_EQ(10, graph.targets(1)[2]) << "Expected correct edge weight";
+
+    // source and target vertices exist, zero weight.
+    EXPECT_EQ(10, graph.set(1, 2, 0)) << "Expected removing existing edge returns the edge's previous weight";
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.sources(2).size()) << "Expected correct number of edges";
+
+    // source and target vertices do not exist, zero weight.
+    EXPECT_EQ(0, graph.set(7, 8, 0)) << "Expected removing non existing edge returns zero";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected removing non existing edge does not add vertices";
+
+    // same vertex
+    EXPECT_EQ(0, graph.set(1, 1, 4)) << "Expected adding a new edge returns zero";
+    EXPECT_EQ(4, graph.sources(1)[1]) << "Expected correct edge weight";
+
+    // negative weight.
+    EXPECT_THROW(graph.set(1, 2, -1), std::domain_error);
+}
+
+TEST_F(IndexedGraphTest, RemoveTest) {
+    /**
+     * Testing strategy:
+     * partition on @param vertex:
+     *      - exist in the graph
+     *      - does not exist in the graph, below or above the largest vertex
+     * 
+     * partition on edges with vertex as one of their endpoints:
+     *      - exist in the graph, as source, target or both
+     *      - does not exist
+     */
+
+    // vertex does not exist in the graph
+    EXPECT_FALSE(graph.remove(1)) << "Expected removing non existing vertex returns false";
+    graph.add(3);
+    EXPECT_FALSE(graph.remove(1)) << "Expected removing non existing vertex returns false";
+
+    // vertex exist in the graph, edges exist in the graph.
+    graph.set(1, 2, 10);
+    graph.set(2, 3, 5);
+    graph.set(2, 2, 1);
+    EXPECT_TRUE(graph.remove(2)) << "Expected removing existing vertex returns true";
+    EXPECT_FALSE(graph.remove(2)) << "Expected removing a removed vertex returns false";
+    EXPECT_EQ(2, graph.vertices().size()) << "Expected correct number of vertices";
+    EXPECT_EQ(0, graph.targets(1).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.sources(3).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.targets(2).size()) << "Expected no edges from a removed vertex";
+
+    // vertex added again
+    EXPECT_TRUE(graph.add(2)) << "Expected adding a removed vertex returns true";
+    EXPECT_EQ(0, graph.sources(2).size()) << "Expected a vertex added again to have no edges";
+}
+
+TEST_F(IndexedGraphTest, SourcesAndTargetsTest) {
+    /**
+     * Testing strategy:
+     * partition on vertex:
+     *      - exist, with no edges
+     *      - exist, with some edges, some removed
+     *      - does not exist
+     */
+
+    // does not exist
+    EXPECT_EQ(0, graph.sources(100).size()) << "Expected to return empty map if vertex does not exist";
+    EXPECT_EQ(0, graph.targets(100).size()) << "Expected to return empty map if vertex does not exist";
+
+    // exist, no edges
+    graph.add(0);
+    EXPECT_EQ(0, graph.sources(0).size()) << "Expected correct number of edges";
+    EXPECT_EQ(0, graph.targets(0).size()) << "Expected correct number of edges";
+
+    // exist, some edges, some removed
+    for (uint32_t i = 1; i < 10; i++) {
+        graph.set(0, i, i);
+        graph.set(i, 0, i + 1);
+    }
+    graph.set(0, 3, 0);
+    graph.remove(9);
+    EXPECT_EQ(7, graph.targets(0).size()) << "Expected correct number of edges";
+    EXPECT_EQ(8, graph.sources(0).size()) << "Expected correct number of edges";
+    for (uint32_t i = 1; i < 9; i++) {
+        if (i != 3) {
+            EXPECT_EQ(i, graph.targets(0)[i]) << "Expected correct weight of edge";
+        }
+        EXPECT_EQ(i + 1, graph.sources(0)[i]) << "Expected correct weight of edge";
+    }
+}
+
+TEST_F(IndexedGraphTest, ViewTest) {
+    /**
+     * Testing strategy:
+     * partition on vertex:
+     *      - with edges
+     *      - not in the graph, below or above the largest vertex
+     */
+    for (uint32_t i = 1; i < 6; i++) {
+        graph.set(0, i, i);
+        graph.set(i, 0, 10 * i);
+    }
+    graph.remove(3);
+
+    // with edges
+    std::unordered_map<uint32_t, int> edges;
+    for (Neighbor<uint32_t> edge: graph.targetsView(0)) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.targets(0), edges) << "Expected the view to match targets()";
+    edges.clear();
+    for (Neighbor<uint32_t> edge: graph.sourcesView(0)) edges[edge.vertex] = edge.weight;
+    EXPECT_EQ(graph.sources(0), edges) << "Expected the view to match sources()";
+
+    // not in the graph
+    EXPECT_TRUE(graph.targetsView(3).empty()) << "Expected no edges of a missing vertex";
+    EXPECT_TRUE(graph.sourcesView(100).empty()) << "Expected no edges of a missing vertex";
+}
+}
\ No newline at end of file
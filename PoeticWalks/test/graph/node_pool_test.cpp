@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "node_pool.h"
+
+namespace {
+
+/**
+ * A node that counts the nodes alive and can fail to be constructed.
+ */
+struct CountedNode {
+    static int alive;
+
+    std::string label;
+
+    CountedNode(std::string label):
+        label{label} {
+        if (label.empty()) throw std::invalid_argument("Empty label.");
+        alive++;
+    }
+
+    ~CountedNode() {
+        alive--;
+    }
+};
+
+int CountedNode::alive = 0;
+
+TEST(NodePoolTest, CreateTest) {
+    /**
+     * Testing strategy:
+     * partition on the nodes made: none, one, more than a slab
+     * partition on the constructor: succeeds, throws
+     */
+    NodePool<CountedNode> pool{};
+    EXPECT_EQ(0, pool.size()) << "Expected no nodes";
+
+    CountedNode *first = pool.create("first");
+    EXPECT_EQ("first", (*first).label) << "Expected the node constructed";
+    EXPECT_EQ(1, pool.size()) << "Expected one node";
+
+    std::vector<CountedNode*> nodes{first};
+    std::unordered_set<CountedNode*> addresses{first};
+    for (int i = 0; i < 1000; i++) {
+        nodes.push_back(pool.create(std::to_string(i)));
+        addresses.insert(nodes.back());
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(nodes.back()) % alignof(CountedNode)) << "Expected aligned nodes";
+    }
+    EXPECT_EQ(1001, pool.size()) << "Expected correct number of nodes";
+    EXPECT_EQ(1001, addresses.size()) << "Expected a slot per node";
+    EXPECT_EQ("first", (*first).label) << "Expected nodes to keep their address as slabs are added";
+    EXPECT_EQ("999", (*nodes.back()).label) << "Expected the node constructed";
+
+    EXPECT_THROW(pool.create(""), std::invalid_argument) << "Expected the constructor's exception";
+    EXPECT_EQ(1001, pool.size()) << "Expected no node made by a failed constructor";
+
+    for (CountedNode *node: nodes) pool.destroy(node);
+    EXPECT_EQ(0, CountedNode::alive) << "Expected every node destructed";
+}
+
+TEST(NodePoolTest, DestroyTest) {
+    /**
+     * Testing strategy:
+     * partition on the destroyed node: the only node, one of many
+     * partition on the next node made: reuses a destroyed slot, takes a new one
+     */
+    NodePool<CountedNode> pool{};
+    CountedNode *only = pool.create("only");
+    pool.destroy(only);
+    EXPECT_EQ(0, pool.size()) << "Expected no nodes";
+    EXPECT_EQ(0, CountedNode::alive) << "Expected the node destructed";
+    EXPECT_EQ(only, pool.create("again")) << "Expected the destroyed slot reused";
+
+    std::vector<CountedNode*> nodes;
+    for (int i = 0; i < 100; i++) nodes.push_back(pool.create(std::to_string(i)));
+    pool.destroy(nodes[40]);
+    pool.destroy(nodes[7]);
+    EXPECT_EQ(99, pool.size()) << "Expected correct number of nodes";
+    EXPECT_EQ(nodes[7], pool.create("7")) << "Expected the last destroyed slot reused first";
+    EXPECT_EQ(nodes[40], pool.create("40")) << "Expected the destroyed slot reused";
+    CountedNode *fresh = pool.create("fresh");
+    for (CountedNode *node: nodes) EXPECT_NE(node, fresh) << "Expected a new slot once none is free";
+    EXPECT_EQ("41", (*nodes[41]).label) << "Expected other nodes unchanged";
+
+    for (CountedNode *node: nodes) pool.destroy(node);
+    pool.destroy(fresh);
+    pool.destroy(only);
+    EXPECT_EQ(0, pool.size()) << "Expected no nodes";
+    EXPECT_EQ(0, CountedNode::alive) << "Expected every node destructed";
+}
+}
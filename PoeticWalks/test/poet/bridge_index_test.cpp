@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "bridge_index.h"
+#include "frozen_graph.h"
+#include "indexed_graph.h"
+
+namespace {
+
+/**
+ * A graph with random edges of small weights, so many pairs have several bridges of the same weight.
+ */
+FrozenGraph<uint32_t> randomGraph(uint32_t vertexCount, int edgeCount, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<uint32_t> vertexDistribution(0, vertexCount - 1);
+    std::uniform_int_distribution<int> weightDistribution(1, 3);
+    IndexedGraph graph{};
+    for (int i = 0; i < edgeCount; i++) {
+        graph.set(vertexDistribution(random), vertexDistribution(random), weightDistribution(random));
+    }
+    return freeze(graph);
+}
+
+TEST(BridgeIndexTest, FindBridgeTest) {
+    /**
+     * Testing strategy:
+     * partition on the bridges of a pair:
+     *      - none, one, several of the same weight, several of different weights
+     *
+     * partition on the vertices of a pair:
+     *      - NOT_FOUND, in the graph
+     */
+    IndexedGraph graph{};
+    graph.set(0, 1, 1);
+    graph.set(1, 2, 1);
+    graph.set(0, 3, 1);
+    graph.set(3, 2, 1);
+    graph.set(0, 4, 2);
+    graph.set(4, 5, 1);
+    graph.set(0, 6, 1);
+    graph.set(6, 5, 1);
+    FrozenGraph<uint32_t> frozen = freeze(graph);
+
+    EXPECT_EQ(frozen.index(1), findBridge(frozen, frozen.index(0), frozen.index(2)).vertex) << "Expected the lowest of tied bridges";
+    EXPECT_EQ(2, findBridge(frozen, frozen.index(0), frozen.index(2)).weight) << "Expected correct bridge weight";
+    EXPECT_EQ(frozen.index(4), findBridge(frozen, frozen.index(0), frozen.index(5)).vertex) << "Expected the heaviest bridge";
+    EXPECT_EQ(FrozenGraph<uint32_t>::NOT_FOUND, findBridge(frozen, frozen.index(2), frozen.index(0)).vertex) << "Expected no bridge";
+    EXPECT_EQ(FrozenGraph<uint32_t>::NOT_FOUND, findBridge(frozen, FrozenGraph<uint32_t>::NOT_FOUND, frozen.index(2)).vertex) << "Expected no bridge for a missing vertex";
+}
+
+TEST(BridgeIndexTest, IndexTest) {
+    /**
+     * Testing strategy:
+     * partition on the graph: empty, random with ties
+     * partition on threads: 1, several
+     * partition on maxPaths: below the paths of the graph, above
+     */
+    BridgeIndex empty{};
+    EXPECT_EQ(0, empty.size()) << "Expected no bridges";
+    EXPECT_EQ(FrozenGraph<uint32_t>::NOT_FOUND, empty.find(0, 1).vertex) << "Expected no bridge";
+
+    FrozenGraph<uint32_t> graph = randomGraph(60, 600, 1);
+    for (unsigned threads: {1u, 3u}) {
+        BridgeIndex index(graph, threads);
+        size_t pairs = 0;
+        for (uint32_t source = 0; source < graph.vertexCount(); source++) {
+            for (uint32_t target = 0; target < graph.vertexCount(); target++) {
+                Bridge expected = findBridge(graph, source, target);
+                Bridge bridge = index.find(source, target);
+                EXPECT_EQ(expected.vertex, bridge.vertex) << "Expected the bridge of findBridge with " << threads << " threads";
+                EXPECT_EQ(expected.weight, bridge.weight) << "Expected the weight of findBridge with " << threads << " threads";
+                if (expected.vertex != FrozenGraph<uint32_t>::NOT_FOUND) pairs++;
+            }
+        }
+        EXPECT_EQ(pairs, index.size()) << "Expected a slot per pair with a bridge";
+        EXPECT_EQ(FrozenGraph<uint32_t>::NOT_FOUND, index.find(FrozenGraph<uint32_t>::NOT_FOUND, 0).vertex) << "Expected no bridge for a missing vertex";
+    }
+
+    EXPECT_THROW(BridgeIndex(graph, 1, 10), std::length_error) << "Expected too many paths rejected";
+}
+
+TEST(BridgeIndexTest, CacheTest) {
+    /**
+     * Testing strategy:
+     * partition on a pair: cached, not cached, evicted
+     * partition on threads: 1, several at once
+     * partition on capacity: 0, less than the pairs used, more
+     */
+    EXPECT_THROW(BridgeCache(0), std::domain_error) << "Expected a capacity of 0 rejected";
+
+    FrozenGraph<uint32_t> graph = randomGraph(60, 600, 2);
+    BridgeCache small(32);
+    BridgeCache large(4096);
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t source = 0; source < graph.vertexCount(); source++) {
+            for (uint32_t target = 0; target < graph.vertexCount(); target++) {
+                Bridge expected = findBridge(graph, source, target);
+                EXPECT_EQ(expected.vertex, small.find(graph, source, target).vertex) << "Expected the bridge of findBridge";
+                EXPECT_EQ(expected.vertex, large.find(graph, source, target).vertex) << "Expected the bridge of findBridge";
+            }
+        }
+    }
+    EXPECT_EQ(32, small.size()) << "Expected the cache full and no larger";
+    EXPECT_EQ(3600, large.size()) << "Expected every pair cached";
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&graph, &small, &mismatches, thread]() {
+            std::mt19937 random(thread);
+            std::uniform_int_distribution<uint32_t> vertexDistribution(0, graph.vertexCount() - 1);
+            for (int i = 0; i < 20000; i++) {
+                uint32_t source = vertexDistribution(random);
+                uint32_t target = vertexDistribution(random);
+                if (small.find(graph, source, target).vertex != findBridge(graph, source, target).vertex) mismatches[thread]++;
+            }
+        });
+    }
+    for (std::thread& thread: threads) thread.join();
+    for (int thread = 0; thread < 4; thread++) {
+        EXPECT_EQ(0, mismatches[thread]) << "Expected the bridge of findBridge from every thread";
+    }
+    EXPECT_EQ(32, small.size()) << "Expected the cache full and no larger";
+}
+}
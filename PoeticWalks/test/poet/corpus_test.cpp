@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "corpus.h"
+#include "indexed_graph.h"
+
+namespace {
+
+TEST(CorpusTest, BigramCountsTest) {
+    /**
+     * Testing strategy:
+     * partition on bigrams:
+     *      - added once, added several times, never added
+     *      - few, enough to grow the table several times
+     */
+    Corpus::BigramCounts counts;
+    EXPECT_EQ(0, counts.size()) << "Expected no bigrams";
+    EXPECT_EQ(0, counts.count(0, 0)) << "Expected 0 for a bigram never added";
+
+    for (uint32_t i = 0; i < 10000; i++) {
+        counts.add(i, i * 7 % 101);
+        if (i % 3 == 0) counts.add(i, i * 7 % 101, 4);
+    }
+    EXPECT_EQ(10000, counts.size()) << "Expected correct number of bigrams";
+    EXPECT_EQ(1, counts.count(1, 7)) << "Expected correct count";
+    EXPECT_EQ(5, counts.count(3, 21)) << "Expected correct count";
+    EXPECT_EQ(0, counts.count(7, 1)) << "Expected 0 for a bigram never added";
+
+    long total = 0;
+    size_t visited = 0;
+    counts.forEach([&](uint32_t source, uint32_t target, int count) {
+        EXPECT_EQ(source * 7 % 101, target) << "Expected only added bigrams";
+        total += count;
+        visited++;
+    });
+    EXPECT_EQ(10000, visited) << "Expected every bigram visited once";
+    EXPECT_EQ(10000 + 4 * 3334, total) << "Expected correct counts";
+}
+
+TEST(CorpusTest, CountBigramsTest) {
+    /**
+     * Testing strategy:
+     * partition on words:
+     *      - lower case, mixed case
+     *      - separated by ' ', '\n', or two separators in a row
+     *      - last word followed by a separator or not
+     *      - 1023 characters, 1024 characters
+     */
+    SymbolTable symbols{};
+    Corpus::BigramCounts counts;
+
+    // lower and mixed case, last word not followed by a separator
+    Corpus::countBigrams("to be\nTo BE", symbols, counts);
+    uint32_t to = symbols.find("to");
+    uint32_t be = symbols.find("be");
+    EXPECT_EQ(2, symbols.size()) << "Expected words lower cased";
+    EXPECT_EQ(2, counts.count(to, be)) << "Expected correct count";
+    EXPECT_EQ(1, counts.count(be, to)) << "Expected correct count";
+    EXPECT_EQ(2, counts.size()) << "Expected correct number of bigrams";
+
+    // two separators in a row, last word followed by a separator
+    counts = Corpus::BigramCounts();
+    Corpus::countBigrams("to  be or\n\nnot ", symbols, counts);
+    EXPECT_EQ(0, counts.count(to, be)) << "Expected an empty word to break the chain";
+    EXPECT_EQ(1, counts.count(be, symbols.find("or"))) << "Expected correct count";
+    EXPECT_EQ(1, counts.size()) << "Expected correct number of bigrams";
+
+    // 1023 and 1024 characters
+    EXPECT_NO_THROW(Corpus::countBigrams(std::string(1023, 'a') + " b", symbols, counts)) << "Expected words below 1024 characters read";
+    EXPECT_THROW(Corpus::countBigrams("a " + std::string(1024, 'b'), symbols, counts), std::runtime_error) << "Expected words of 1024 characters rejected";
+}
+
+TEST(CorpusTest, CountBigramsParallelTest) {
+    /**
+     * Testing strategy:
+     * partition on the number of threads:
+     *      - 1, 2, more than the text can be split in
+     *
+     * partition on the split between two shards:
+     *      - between two words, after an empty word, before an empty word
+     *
+     * partition on the symbols:
+     *      - empty, with words of the text already
+     *
+     * partition on words:
+     *      - shorter than 1024 characters, 1024 characters in the last shard
+     */
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> wordDistribution(0, 499);
+    std::string text;
+    while (text.size() < 300000) {
+        int word = wordDistribution(random);
+        text.append(word % 7 == 0 ? "Word" : "word");
+        text.append(std::to_string(word));
+        text.push_back(word % 5 == 0 ? '\n' : ' ');
+        if (word % 13 == 0) text.push_back(' ');
+    }
+
+    SymbolTable expectedSymbols{};
+    expectedSymbols.intern("word3");
+    Corpus::BigramCounts expectedCounts;
+    Corpus::countBigrams(text, expectedSymbols, expectedCounts);
+
+    for (unsigned threads: {1u, 2u, 7u, 1000u}) {
+        SymbolTable symbols{};
+        symbols.intern("word3");
+        std::vector<Corpus::BigramCounts> partitions = Corpus::countBigrams(text, symbols, threads);
+        Corpus::BigramCounts counts;
+        for (const Corpus::BigramCounts& partition: partitions) {
+            partition.forEach([&](uint32_t source, uint32_t target, int count) {
+                EXPECT_EQ(0, counts.count(source, target)) << "Expected every bigram in a single partition";
+                counts.add(source, target, count);
+            });
+        }
+
+        ASSERT_EQ(expectedSymbols.size(), symbols.size()) << "Expected the same words with " << threads << " threads";
+        for (uint32_t id = 0; id < symbols.size(); id++) {
+            EXPECT_EQ(expectedSymbols.word(id), symbols.word(id)) << "Expected the same id of every word with " << threads << " threads";
+        }
+        ASSERT_EQ(expectedCounts.size(), counts.size()) << "Expected the same number of bigrams with " << threads << " threads";
+        expectedCounts.forEach([&](uint32_t source, uint32_t target, int count) {
+            EXPECT_EQ(count, counts.count(source, target)) << "Expected the same count of every bigram with " << threads << " threads";
+        });
+    }
+
+    SymbolTable symbols{};
+    EXPECT_THROW(Corpus::countBigrams(text + std::string(1024, 'b'), symbols, 8), std::runtime_error) << "Expected words of 1024 characters rejected";
+}
+
+TEST(CorpusTest, LoadTest) {
+    /**
+     * Testing strategy:
+     * partition on the corpus file:
+     *      - regular file, mapped
+     *      - pipe, read in blocks
+     *      - empty
+     *
+     * partition on the graph:
+     *      - empty
+     *      - with edges of the corpus already
+     */
+    char path[] = "/tmp/corpus_testXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(-1, fd) << "Expected a temporary file";
+    std::string text = "a b a b c\na b";
+    ASSERT_EQ(text.size(), write(fd, text.data(), text.size()));
+
+    // regular file, empty graph
+    SymbolTable symbols{};
+    IndexedGraph graph{};
+    lseek(fd, 0, SEEK_SET);
+    Corpus::load(fd, symbols, &graph);
+    uint32_t a = symbols.find("a");
+    uint32_t b = symbols.find("b");
+    EXPECT_EQ(3, graph.targets(a)[b]) << "Expected correct edge weight";
+    EXPECT_EQ(1, graph.targets(b)[a]) << "Expected correct edge weight";
+    EXPECT_EQ(3, graph.vertices().size()) << "Expected correct number of vertices";
+
+    // pipe, graph with edges already
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe(pipeFds));
+    ASSERT_EQ(text.size(), write(pipeFds[1], text.data(), text.size()));
+    close(pipeFds[1]);
+    Corpus::load(pipeFds[0], symbols, &graph);
+    close(pipeFds[0]);
+    EXPECT_EQ(6, graph.targets(a)[b]) << "Expected loading to add to existing weights";
+    EXPECT_EQ(3, graph.vertices().size()) << "Expected correct number of vertices";
+
+    // empty
+    ASSERT_EQ(0, ftruncate(fd, 0));
+    Corpus::load(fd, symbols, &graph);
+    EXPECT_EQ(6, graph.targets(a)[b]) << "Expected an empty corpus to add nothing";
+
+    close(fd);
+    unlink(path);
+}
+}
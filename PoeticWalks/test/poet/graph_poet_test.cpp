@@ -3,22 +3,30 @@
 #include <unistd.h>
 #include <linux/limits.h>
 
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 #include "graph_poet.h"
 #include "concrete_vertices_graph.h"
+#include "hashed_graph.h"
+#include "indexed_graph.h"
 
 namespace {
 
 TEST(GraphPoetTest, ConstructorTest) {
     std::string relativePath{"/../test/poet/alphabet.txt"};
-    ASSERT_NO_THROW(GraphPoet(new ConcreteVerticesGraph<std::string>(), relativePath, false)) << "Constructor must work with relative path";
+    ASSERT_NO_THROW(GraphPoet(new ConcreteVerticesGraph<uint32_t>(), relativePath, false)) << "Constructor must work with relative path";
     
     char buffer[PATH_MAX];
     getcwd(buffer, PATH_MAX);
     std::string absolutePath{buffer};
     absolutePath = absolutePath.append(relativePath);
-    ASSERT_NO_THROW(GraphPoet(new ConcreteVerticesGraph<std::string>(), absolutePath, true)) << "Constructor must work with absolute path.";
+    ASSERT_NO_THROW(GraphPoet(new ConcreteVerticesGraph<uint32_t>(), absolutePath, true)) << "Constructor must work with absolute path.";
 
-    ASSERT_THROW(GraphPoet(new ConcreteVerticesGraph<std::string>(), "asdf"), std::runtime_error) << "Expected constructor fail if file does not exist.";
+    ASSERT_THROW(GraphPoet(new ConcreteVerticesGraph<uint32_t>(), "asdf"), std::runtime_error) << "Expected constructor fail if file does not exist.";
 }
 
 TEST(GraphPoetTest, PoemTest) {
@@ -41,7 +49,7 @@ TEST(GraphPoetTest, PoemTest) {
      *      - multiple bridge exist 
      */
     
-    GraphPoet graphPoet = GraphPoet(new ConcreteVerticesGraph<std::string>(), "/../test/poet/alphabet.txt");
+    GraphPoet graphPoet = GraphPoet(new ConcreteVerticesGraph<uint32_t>(), "/../test/poet/alphabet.txt");
 
     // empty input
     EXPECT_EQ("", graphPoet.poem("")) << "Expected empty string when input is empty";
@@ -58,10 +66,118 @@ TEST(GraphPoetTest, PoemTest) {
     // more than two word input, mixed case, single bridge exist
     EXPECT_EQ("a b C d e f G", graphPoet.poem("a C e G")) << "Expected correct string";
 
-    graphPoet = GraphPoet(new ConcreteVerticesGraph<std::string>(), "/../test/poet/multi-edge-test.txt");
+    graphPoet = GraphPoet(new ConcreteVerticesGraph<uint32_t>(), "/../test/poet/multi-edge-test.txt");
 
     graphPoet.poem("");
     // more than two edges, all upper case, multiple bridge exist
     EXPECT_EQ("FOO bar FOOBAR bar FOO", graphPoet.poem("FOO FOOBAR FOO")) << "Expected correct string";
 }
-}
\ No newline at end of file
+
+TEST(GraphPoetTest, GraphImplementationsPoemTest) {
+    /**
+     * Testing strategy:
+     * partition on graph implementation: HashedGraph, IndexedGraph, matching the poems of ConcreteVerticesGraph
+     * partition bridge options:
+     *      - no bridge exist
+     *      - single bridge edge exist
+     *      - multiple bridge exist
+     */
+
+    std::vector<std::function<Graph<uint32_t> *()>> implementations{
+        []() -> Graph<uint32_t> * {return new HashedGraph<uint32_t>();},
+        []() -> Graph<uint32_t> * {return new IndexedGraph();},
+    };
+    for (auto& implementation: implementations) {
+        // single bridge exist, no bridge exist
+        GraphPoet graphPoet = GraphPoet(implementation(), "/../test/poet/alphabet.txt");
+        EXPECT_EQ("a b c", graphPoet.poem("a c")) << "Expected correct string";
+        EXPECT_EQ("a d g", graphPoet.poem("a d g")) << "Expected same string when no bridge exist";
+        EXPECT_EQ("a b C d e f G", graphPoet.poem("a C e G")) << "Expected correct string";
+        EXPECT_EQ("hello a b c", graphPoet.poem("hello a c")) << "Expected words missing from the corpus kept as they are";
+
+        // multiple bridge exist
+        GraphPoet multiEdgePoet = GraphPoet(implementation(), "/../test/poet/multi-edge-test.txt");
+        EXPECT_EQ("FOO bar FOOBAR bar FOO", multiEdgePoet.poem("FOO FOOBAR FOO")) << "Expected correct string";
+    }
+}
+
+TEST(GraphPoetTest, BridgeLookupTest) {
+    /**
+     * Testing strategy:
+     * partition on bridge lookup: searched, indexed, cached, cache smaller than the pairs used
+     * partition bridge options:
+     *      - no bridge exist
+     *      - single bridge edge exist
+     *      - multiple bridge exist
+     */
+    std::vector<std::function<void(GraphPoet&)>> lookups{
+        [](GraphPoet& poet) {poet.indexBridges(2);},
+        [](GraphPoet& poet) {poet.cacheBridges(1000);},
+        [](GraphPoet& poet) {poet.cacheBridges(1);},
+    };
+    for (auto& lookup: lookups) {
+        GraphPoet graphPoet = GraphPoet(new IndexedGraph(), "/../test/poet/alphabet.txt");
+        lookup(graphPoet);
+        for (int pass = 0; pass < 2; pass++) {
+            EXPECT_EQ("a b c", graphPoet.poem("a c")) << "Expected correct string";
+            EXPECT_EQ("a d g", graphPoet.poem("a d g")) << "Expected same string when no bridge exist";
+            EXPECT_EQ("a b C d e f G", graphPoet.poem("a C e G")) << "Expected correct string";
+        }
+
+        GraphPoet multiEdgePoet = GraphPoet(new IndexedGraph(), "/../test/poet/multi-edge-test.txt");
+        lookup(multiEdgePoet);
+        EXPECT_EQ("FOO bar FOOBAR bar FOO", multiEdgePoet.poem("FOO FOOBAR FOO")) << "Expected correct string";
+    }
+}
+
+TEST(GraphPoetTest, PoemsTest) {
+    /**
+     * Testing strategy:
+     * partition on number of inputs: zero, one, more than the threads
+     * partition on threads: 1, several
+     * partition on bridge lookup: searched, indexed, cached
+     * partition on callers: one thread, several threads calling poem() at once
+     */
+    std::vector<std::string> texts;
+    for (int i = 0; i < 200; i++) {
+        std::string text;
+        for (int j = 0; j <= i % 9; j++) text.append(j % 2 == 0 ? "a " : "C e G ").append(i % 3 == 0 ? "FOO " : "d ");
+        texts.push_back(text);
+    }
+    std::vector<std::string_view> inputs(texts.begin(), texts.end());
+
+    std::vector<std::function<void(GraphPoet&)>> lookups{
+        [](GraphPoet&) {},
+        [](GraphPoet& poet) {poet.indexBridges();},
+        [](GraphPoet& poet) {poet.cacheBridges(8);},
+    };
+    for (auto& lookup: lookups) {
+        GraphPoet graphPoet = GraphPoet(new IndexedGraph(), "/../test/poet/alphabet.txt");
+        lookup(graphPoet);
+        const GraphPoet& poet = graphPoet;
+        std::vector<std::string> expected;
+        for (std::string_view input: inputs) expected.push_back(poet.poem(input));
+
+        EXPECT_TRUE(poet.poems({}).empty()) << "Expected no poems for no inputs";
+        EXPECT_EQ(std::vector<std::string>{"a b c"}, poet.poems({"a c"}, 4)) << "Expected correct poem";
+        EXPECT_EQ(expected, poet.poems(inputs, 1)) << "Expected the poems of poem() in input order";
+        EXPECT_EQ(expected, poet.poems(inputs, 8)) << "Expected the poems of poem() in input order";
+
+        std::vector<std::thread> threads;
+        std::vector<int> mismatches(4, 0);
+        for (int thread = 0; thread < 4; thread++) {
+            threads.emplace_back([&poet, &inputs, &expected, &mismatches, thread]() {
+                for (int round = 0; round < 5; round++) {
+                    for (size_t i = thread; i < inputs.size(); i += 2) {
+                        if (poet.poem(inputs[i]) != expected[i]) mismatches[thread]++;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread: threads) thread.join();
+        for (int thread = 0; thread < 4; thread++) {
+            EXPECT_EQ(0, mismatches[thread]) << "Expected the same poems from every thread";
+        }
+    }
+}
+}
@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "frozen_graph.h"
+#include "graph_poet.h"
+#include "indexed_graph.h"
+#include "snapshot.h"
+#include "symbol_table.h"
+
+namespace {
+
+/**
+ * A path for a temporary snapshot, removed when the test ends.
+ */
+class TemporaryPath {
+public:
+    TemporaryPath() {
+        char name[] = "/tmp/snapshot_testXXXXXX";
+        int fd = mkstemp(name);
+        if (fd != -1) close(fd);
+        path = name;
+    }
+
+    ~TemporaryPath() {
+        unlink(path.c_str());
+    }
+
+    std::string path;
+};
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+TEST(SnapshotTest, RoundTripTest) {
+    /**
+     * Testing strategy:
+     * partition on the graph:
+     *      - empty
+     *      - with edges, a vertex without edges and words without vertices
+     */
+    TemporaryPath snapshot;
+
+    // empty
+    SymbolTable symbols{};
+    FrozenGraph<uint32_t> graph{};
+    Snapshot::save(snapshot.path, symbols, graph);
+    SymbolTable loadedSymbols{};
+    loadedSymbols.intern("stale");
+    IndexedGraph staleEdges{};
+    staleEdges.set(0, 0, 1);
+    FrozenGraph<uint32_t> loadedGraph = freeze(staleEdges);
+    Snapshot::load(snapshot.path, loadedSymbols, loadedGraph);
+    EXPECT_EQ(0, loadedSymbols.size()) << "Expected no words";
+    EXPECT_EQ(0, loadedGraph.vertexCount()) << "Expected no vertices";
+
+    // with edges
+    uint32_t to = symbols.intern("to");
+    uint32_t be = symbols.intern("be");
+    uint32_t orWord = symbols.intern("or");
+    uint32_t question = symbols.intern("question");
+    symbols.intern("unused");
+    IndexedGraph edges{};
+    edges.set(to, be, 2);
+    edges.set(be, orWord, 1);
+    edges.set(orWord, to, 3);
+    edges.set(be, be, 4);
+    edges.add(question);
+    graph = freeze(edges);
+    Snapshot::save(snapshot.path, symbols, graph);
+    Snapshot::load(snapshot.path, loadedSymbols, loadedGraph);
+
+    EXPECT_EQ(symbols.size(), loadedSymbols.size()) << "Expected the same number of words";
+    for (uint32_t id = 0; id < symbols.size(); id++) {
+        EXPECT_EQ(symbols.word(id), loadedSymbols.word(id)) << "Expected the same word for id " << id;
+    }
+    EXPECT_EQ(graph.vertices(), loadedGraph.vertices()) << "Expected the same vertices";
+    for (uint32_t vertex: graph.vertices()) {
+        EXPECT_EQ(graph.targets(vertex), loadedGraph.targets(vertex)) << "Expected the same targets of " << vertex;
+        EXPECT_EQ(graph.sources(vertex), loadedGraph.sources(vertex)) << "Expected the same sources of " << vertex;
+    }
+}
+
+TEST(SnapshotTest, InvalidTest) {
+    /**
+     * Testing strategy:
+     * partition on the file:
+     *      - missing
+     *      - not a snapshot
+     *      - another version
+     *      - another byte order
+     *      - truncated
+     *      - longer than its sections
+     *      - corrupt offsets
+     */
+    TemporaryPath snapshot;
+    SymbolTable symbols{};
+    uint32_t a = symbols.intern("a");
+    uint32_t b = symbols.intern("b");
+    IndexedGraph edges{};
+    edges.set(a, b, 1);
+    edges.set(b, a, 2);
+    FrozenGraph<uint32_t> graph = freeze(edges);
+    Snapshot::save(snapshot.path, symbols, graph);
+    std::string saved = readFile(snapshot.path);
+
+    SymbolTable loadedSymbols{};
+    FrozenGraph<uint32_t> loadedGraph{};
+    EXPECT_THROW(Snapshot::load(snapshot.path + ".missing", loadedSymbols, loadedGraph), std::runtime_error) << "Expected a missing file rejected";
+
+    std::string changed = saved;
+    changed[0] = 'X';
+    writeFile(snapshot.path, changed);
+    EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected a file that is not a snapshot rejected";
+
+    // version follows the 8 byte magic, the byte order mark follows the version
+    changed = saved;
+    changed[8] ^= 0x7f;
+    writeFile(snapshot.path, changed);
+    EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected another version rejected";
+
+    changed = saved;
+    std::swap(changed[12], changed[15]);
+    writeFile(snapshot.path, changed);
+    EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected another byte order rejected";
+
+    for (size_t length: {(size_t) 0, (size_t) 20, saved.size() / 2, saved.size() - 1}) {
+        writeFile(snapshot.path, saved.substr(0, length));
+        EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected a file truncated to " << length << " bytes rejected";
+    }
+
+    writeFile(snapshot.path, saved + std::string(8, '\0'));
+    EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected trailing bytes rejected";
+
+    // every out target is the last 4 byte value before the out weights, which end 2 sections before the in weights
+    changed = saved;
+    size_t outTargetsEnd = saved.size() - 8 - 8 - 16 - 8;
+    changed[outTargetsEnd - 4] = (char) 0xff;
+    writeFile(snapshot.path, changed);
+    EXPECT_THROW(Snapshot::load(snapshot.path, loadedSymbols, loadedGraph), std::runtime_error) << "Expected a target out of range rejected";
+
+    EXPECT_EQ(0, loadedSymbols.size()) << "Expected the words unchanged after a failed load";
+    EXPECT_EQ(0, loadedGraph.vertexCount()) << "Expected the graph unchanged after a failed load";
+}
+
+TEST(SnapshotTest, GraphPoetTest) {
+    /**
+     * Testing strategy:
+     * partition on the poet: built from a corpus, loaded from a snapshot of it
+     */
+    TemporaryPath snapshot;
+    GraphPoet poet(new IndexedGraph(), "/../test/poet/alphabet.txt");
+    poet.save(snapshot.path);
+    GraphPoet loaded = GraphPoet::fromSnapshot(snapshot.path);
+    for (std::string input: {"", "a", "a c", "A C e", "z a c x", "b d f h"}) {
+        EXPECT_EQ(poet.poem(input), loaded.poem(input)) << "Expected the same poem of \"" << input << "\"";
+    }
+    EXPECT_THROW(GraphPoet::fromSnapshot(snapshot.path + ".missing"), std::runtime_error) << "Expected a missing snapshot rejected";
+}
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+
+#include "symbol_table.h"
+
+namespace {
+
+TEST(SymbolTableTest, InternTest) {
+    /**
+     * Testing strategy:
+     * partition on @param word:
+     *      - not in the table
+     *      - already in the table
+     *      - empty
+     *      - longer than an arena block
+     */
+    SymbolTable symbols{};
+
+    // not in the table
+    EXPECT_EQ(0, symbols.intern("to")) << "Expected ids to start at zero";
+    EXPECT_EQ(1, symbols.intern("be")) << "Expected dense ids";
+
+    // already in the table
+    std::string copy{"to"};
+    EXPECT_EQ(0, symbols.intern(copy)) << "Expected the same id for an equal word";
+    EXPECT_EQ(2, symbols.size()) << "Expected each distinct word stored once";
+
+    // empty
+    EXPECT_EQ(2, symbols.intern("")) << "Expected the empty word to be a word";
+    EXPECT_EQ("", symbols.word(2)) << "Expected correct word";
+
+    // longer than an arena block
+    std::string longWord(100000, 'x');
+    EXPECT_EQ(3, symbols.intern(longWord)) << "Expected dense ids";
+    EXPECT_EQ(4, symbols.intern("or")) << "Expected dense ids";
+    EXPECT_EQ(longWord, symbols.word(3)) << "Expected correct word";
+    EXPECT_EQ("or", symbols.word(4)) << "Expected correct word";
+}
+
+TEST(SymbolTableTest, FindTest) {
+    /**
+     * Testing strategy:
+     * partition on @param word:
+     *      - in the table
+     *      - not in the table
+     */
+    SymbolTable symbols{};
+    symbols.intern("not");
+
+    EXPECT_EQ(0, symbols.find("not")) << "Expected the id of an interned word";
+    EXPECT_EQ(SymbolTable::NOT_FOUND, symbols.find("to")) << "Expected NOT_FOUND for a missing word";
+    EXPECT_EQ(1, symbols.size()) << "Expected find not to add words";
+}
+
+TEST(SymbolTableTest, WordTest) {
+    /**
+     * Testing strategy:
+     * partition on the table:
+     *      - words spanning several arena blocks
+     *      - moved to another table
+     */
+    SymbolTable symbols{};
+    for (int i = 0; i < 20000; i++) {
+        EXPECT_EQ(i, symbols.intern("word" + std::to_string(i))) << "Expected dense ids";
+    }
+    for (int i = 0; i < 20000; i++) {
+        EXPECT_EQ("word" + std::to_string(i), symbols.word(i)) << "Expected the words to stay valid as blocks are added";
+    }
+
+    // moved to another table
+    std::string_view before = symbols.word(7);
+    SymbolTable moved = std::move(symbols);
+    EXPECT_EQ(before.data(), moved.word(7).data()) << "Expected moving a table to keep its words in place";
+    EXPECT_EQ(7, moved.find("word7")) << "Expected a moved table to find its words";
+}
+}
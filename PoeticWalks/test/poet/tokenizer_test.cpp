@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tokenizer.h"
+
+namespace {
+
+/**
+ * Split a text one character at a time, as forEachToken with the given separators.
+ */
+std::vector<std::string> splitEach(const std::string& text, const std::string& separators) {
+    std::vector<std::string> tokens{""};
+    for (char c: text) {
+        if (separators.find(c) == std::string::npos) {
+            tokens.back().push_back(c);
+        } else {
+            tokens.emplace_back();
+        }
+    }
+    return tokens;
+}
+
+/**
+ * Text of random characters, mostly letters of both cases and separators.
+ */
+std::string randomText(std::mt19937& random, size_t length) {
+    static const std::string CHARACTERS = "abcXYZ \n\t\r\v\f@[`{\x80\xc3\xff";
+    std::uniform_int_distribution<size_t> distribution(0, CHARACTERS.size() - 1);
+    std::string text;
+    for (size_t i = 0; i < length; i++) text.push_back(CHARACTERS[distribution(random)]);
+    return text;
+}
+
+TEST(TokenizerTest, MaskTest) {
+    /**
+     * Testing strategy:
+     * partition on characters: every value from 0 to 255
+     * partition on position in the block: first, middle, last
+     */
+    for (int c = 0; c < 256; c++) {
+        for (size_t position: {(size_t) 0, (size_t) 31, Tokenizer::BLOCK_SIZE - 1}) {
+            char block[Tokenizer::BLOCK_SIZE];
+            std::fill(block, block + Tokenizer::BLOCK_SIZE, 'a');
+            block[position] = (char) c;
+
+            uint64_t bit = (uint64_t) 1 << position;
+            EXPECT_EQ(c == ' ' || c == '\n' ? bit : 0, Tokenizer::separators(block)) << "Expected correct separators for " << c;
+            EXPECT_EQ(isspace(c) ? bit : 0, Tokenizer::spaces(block)) << "Expected correct spaces for " << c;
+        }
+    }
+}
+
+TEST(TokenizerTest, LowerCaseTest) {
+    /**
+     * Testing strategy:
+     * partition on characters: every value from 0 to 255
+     * partition on length: 0, shorter than a vector, several vectors and a remainder
+     */
+    std::string text;
+    for (int c = 0; c < 256; c++) text.push_back((char) c);
+    for (size_t length: {0, 1, 15, 16, 33, 256}) {
+        std::string buffer(length, '\0');
+        Tokenizer::lowerCase(std::string_view(text.data() + 256 - length, length), buffer.data());
+        for (size_t i = 0; i < length; i++) {
+            unsigned char c = text[256 - length + i];
+            EXPECT_EQ((char) tolower(c), buffer[i]) << "Expected tolower of " << (int) c;
+        }
+    }
+}
+
+TEST(TokenizerTest, ForEachTokenTest) {
+    /**
+     * Testing strategy:
+     * partition on length: 0, shorter than a block, a block, several blocks and a remainder
+     * partition on tokens: empty, in a block, across two blocks
+     * partition on the splitting: separators, spaces (words)
+     */
+    std::mt19937 random(5);
+    for (size_t length: {0, 1, 63, 64, 65, 200, 1000}) {
+        for (int run = 0; run < 20; run++) {
+            std::string text = randomText(random, length);
+
+            std::vector<std::string> tokens;
+            Tokenizer::forEachSeparated(text, [&tokens](std::string_view token) {tokens.emplace_back(token);});
+            EXPECT_EQ(splitEach(text, " \n"), tokens) << "Expected tokens split on ' ' and '\\n'";
+
+            std::vector<std::string> expectedWords;
+            for (const std::string& token: splitEach(text, " \t\n\v\f\r")) {
+                if (!token.empty()) expectedWords.push_back(token);
+            }
+            std::vector<std::string> words;
+            Tokenizer::forEachWord(text, [&words](std::string_view word) {words.emplace_back(word);});
+            EXPECT_EQ(expectedWords, words) << "Expected words split on whitespace";
+        }
+    }
+
+    // a token across two blocks
+    std::string text = std::string(60, 'a') + " " + std::string(10, 'b') + " c";
+    std::vector<std::string> tokens;
+    Tokenizer::forEachSeparated(text, [&tokens](std::string_view token) {tokens.emplace_back(token);});
+    EXPECT_EQ((std::vector<std::string>{std::string(60, 'a'), std::string(10, 'b'), "c"}), tokens) << "Expected correct tokens";
+}
+}